@@ -452,6 +452,7 @@ btr_page_create(
 	}
 
 	btr_page_set_index_id(page, page_zip, index->id, mtr);
+	buf_block_set_index_stat(block, index->id);
 }
 
 /**************************************************************//**
@@ -1137,6 +1138,7 @@ btr_free_root_invalidate(
 		buf_block_get_frame(block),
 		buf_block_get_page_zip(block),
 		BTR_FREED_INDEX_ID, mtr);
+	buf_block_set_index_stat(block, BTR_FREED_INDEX_ID);
 }
 
 /** Prepare to free a B-tree.
@@ -1317,6 +1319,7 @@ btr_create(
 
 	/* Set the index id of the page */
 	btr_page_set_index_id(page, page_zip, index_id, mtr);
+	buf_block_set_index_stat(block, index_id);
 
 	/* Set the next node and previous node fields */
 	btr_page_set_next(page, page_zip, FIL_NULL, mtr);
@@ -28,8 +28,11 @@ Created 03/11/2014 Shaohua Wang
 #include "btr0btr.h"
 #include "btr0cur.h"
 #include "btr0pcur.h"
+#include "gis0rtree.h"
 #include "ibuf0ibuf.h"
 
+#include <algorithm>
+
 /** Innodb B-tree index fill factor for bulk load. */
 long	innobase_fill_factor;
 
@@ -92,10 +95,9 @@ PageBulk::init()
 			page_create_zip(new_block, m_index, m_level, 0,
 					NULL, mtr);
 		} else {
-			ut_ad(!dict_index_is_spatial(m_index));
 			page_create(new_block, mtr,
 				    dict_table_is_comp(m_index->table),
-				    false);
+				    dict_index_is_spatial(m_index));
 			btr_page_set_level(new_page, NULL, m_level, mtr);
 		}
 
@@ -103,6 +105,7 @@ PageBulk::init()
 		btr_page_set_prev(new_page, NULL, FIL_NULL, mtr);
 
 		btr_page_set_index_id(new_page, NULL, m_index->id, mtr);
+		buf_block_set_index_stat(new_block, m_index->id);
 	} else {
 		new_block = btr_block_get(
 			page_id_t(m_index->table->space->id, m_page_no),
@@ -170,8 +173,10 @@ PageBulk::insert(
 	ut_d(const bool is_leaf = page_rec_is_leaf(m_cur_rec));
 
 #ifdef UNIV_DEBUG
-	/* Check whether records are in order. */
-	if (!page_rec_is_infimum(m_cur_rec)) {
+	/* Check whether records are in order. The records of an
+	R-tree page are ordered by sortRecs() in finish(). */
+	if (!page_rec_is_infimum(m_cur_rec)
+	    && !dict_index_is_spatial(m_index)) {
 		rec_t*	old_rec = m_cur_rec;
 		ulint*	old_offsets = rec_get_offsets(
 			old_rec, m_index, NULL,	is_leaf,
@@ -228,6 +233,10 @@ PageBulk::finish()
 {
 	ut_ad(m_rec_no > 0);
 
+	if (dict_index_is_spatial(m_index)) {
+		sortRecs();
+	}
+
 #ifdef UNIV_DEBUG
 	ut_ad(m_total_data + page_dir_calc_reserved_space(m_rec_no)
 	      <= page_get_free_space_of_empty(m_is_comp));
@@ -285,7 +294,6 @@ PageBulk::finish()
 	page_dir_slot_set_rec(slot, page_get_supremum_rec(m_page));
 	page_dir_slot_set_n_owned(slot, NULL, count + 1);
 
-	ut_ad(!dict_index_is_spatial(m_index));
 	page_dir_set_n_slots(m_page, NULL, 2 + slot_index);
 	page_header_set_ptr(m_page, NULL, PAGE_HEAP_TOP, m_heap_top);
 	page_dir_set_n_heap(m_page, NULL, PAGE_HEAP_NO_USER_LOW + m_rec_no);
@@ -298,6 +306,81 @@ PageBulk::finish()
 	m_block->skip_flush_check = false;
 }
 
+/** Comparator of R-tree records for PageBulk::sortRecs() */
+struct rtr_bulk_rec_cmp_t {
+	/** Constructor
+	@param[in]	index	spatial index */
+	explicit rtr_bulk_rec_cmp_t(const dict_index_t* index)
+		: m_index(index) {}
+
+	/** Compare two records
+	@param[in]	a	record and its offsets
+	@param[in]	b	record and its offsets
+	@return whether a precedes b */
+	bool operator()(
+		const std::pair<rec_t*, ulint*>&	a,
+		const std::pair<rec_t*, ulint*>&	b) const
+	{
+		return(cmp_rec_rec(a.first, b.first, a.second, b.second,
+				   m_index) < 0);
+	}
+
+	/** The spatial index */
+	const dict_index_t*	m_index;
+};
+
+/** Sort the records of an R-tree page. A SPATIAL INDEX is loaded in
+Hilbert curve order, while the records within each page must be in the
+order of cmp_rec_rec(). We copy the records out of the page, sort them
+and insert them again, so that the heap order stays the same as the
+list order, as copyOut() expects. */
+void
+PageBulk::sortRecs()
+{
+	typedef std::pair<rec_t*, ulint*>	rec_offs_t;
+
+	ut_ad(dict_index_is_spatial(m_index));
+	ut_ad(m_rec_no > 0);
+
+	const bool	is_leaf = page_is_leaf(m_page);
+	const ulint	n_recs = m_rec_no;
+	rec_offs_t*	recs = static_cast<rec_offs_t*>(
+		mem_heap_alloc(m_heap, n_recs * sizeof *recs));
+	const rec_t*	rec = page_rec_get_next(page_get_infimum_rec(m_page));
+
+	for (ulint i = 0; i < n_recs; i++) {
+		ut_ad(page_rec_is_user_rec(rec));
+
+		ulint*	offsets = rec_get_offsets(rec, m_index, NULL, is_leaf,
+						  ULINT_UNDEFINED, &m_heap);
+		rec_t*	copy = rec_copy(
+			mem_heap_alloc(m_heap, rec_offs_size(offsets)),
+			rec, offsets);
+		rec_offs_make_valid(copy, m_index, is_leaf, offsets);
+
+		recs[i] = rec_offs_t(copy, offsets);
+		rec = page_rec_get_next_const(rec);
+	}
+
+	ut_ad(page_rec_is_supremum(rec));
+
+	std::sort(recs, recs + n_recs, rtr_bulk_rec_cmp_t(m_index));
+
+	/* Empty the page and insert the records in order. */
+	m_cur_rec = page_get_infimum_rec(m_page);
+	page_rec_set_next(m_cur_rec, page_get_supremum_rec(m_page));
+	m_heap_top = m_page + (m_is_comp
+			       ? PAGE_NEW_SUPREMUM_END
+			       : PAGE_OLD_SUPREMUM_END);
+	m_free_space = page_get_free_space_of_empty(m_is_comp);
+	m_rec_no = 0;
+	ut_d(m_total_data = 0);
+
+	for (ulint i = 0; i < n_recs; i++) {
+		insert(recs[i].first, recs[i].second);
+	}
+}
+
 /** Commit inserts done to the page
 @param[in]	success		Flag whether all inserts succeed. */
 void
@@ -342,8 +425,22 @@ PageBulk::getNodePtr()
 	/* Create node pointer */
 	first_rec = page_rec_get_next(page_get_infimum_rec(m_page));
 	ut_a(page_rec_is_user_rec(first_rec));
-	node_ptr = dict_index_build_node_ptr(m_index, first_rec, m_page_no,
-					     m_heap, m_level);
+
+	if (dict_index_is_spatial(m_index)) {
+		/* The node pointer of an R-tree page carries the
+		MBR that covers all records of the page. */
+		rtr_mbr_t	mbr;
+
+		rtr_page_cal_mbr(m_index, m_block, &mbr, m_heap);
+
+		node_ptr = rtr_index_build_node_ptr(m_index, &mbr, first_rec,
+						    m_page_no, m_heap,
+						    m_level);
+	} else {
+		node_ptr = dict_index_build_node_ptr(m_index, first_rec,
+						     m_page_no, m_heap,
+						     m_level);
+	}
 
 	return(node_ptr);
 }
@@ -580,8 +677,6 @@ Note: log_free_check requires holding no lock/latch in current thread. */
 void
 PageBulk::release()
 {
-	ut_ad(!dict_index_is_spatial(m_index));
-
 	/* We fix the block because we will re-pin it soon. */
 	buf_block_buf_fix_inc(m_block, __FILE__, __LINE__);
 
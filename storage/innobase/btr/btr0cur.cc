@@ -2896,6 +2896,73 @@ btr_cur_open_at_rnd_pos_func(
 	return(true);
 }
 
+/** Look up the number of the leaf page that a PAGE_CUR_LE search for a
+tuple would end up on, without accessing the leaf page itself.
+The index tree is s-latched and the non-leaf pages on the path are
+s-latched until the mini-transaction is committed.
+@param[in]	index	B-tree index, not a spatial index
+@param[in]	tuple	search tuple
+@param[in,out]	mtr	mini-transaction
+@return leaf page number
+@retval FIL_NULL if the root page is a leaf page or the index is
+unavailable */
+ulint
+btr_cur_get_leaf_page_no(
+	dict_index_t*	index,
+	const dtuple_t*	tuple,
+	mtr_t*		mtr)
+{
+	mem_heap_t*	heap		= NULL;
+	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*		offsets		= offsets_;
+	ulint		page_no		= FIL_NULL;
+	rec_offs_init(offsets_);
+
+	ut_ad(!dict_index_is_spatial(index));
+
+	mtr_s_lock(dict_index_get_lock(index), mtr);
+
+	buf_block_t*	block = btr_root_block_get(index, RW_S_LATCH, mtr);
+
+	if (block == NULL) {
+		return(FIL_NULL);
+	}
+
+	const page_size_t	page_size(index->table->space->flags);
+
+	for (ulint level = btr_page_get_level(buf_block_get_frame(block));
+	     level > 0; level--) {
+		page_cur_t	cur;
+
+		page_cur_search(block, index, tuple, PAGE_CUR_LE, &cur);
+
+		const rec_t*	node_ptr = page_cur_get_rec(&cur);
+
+		/* The first node pointer on each non-leaf level has the
+		REC_INFO_MIN_REC_FLAG, so that we never end up on the
+		infimum. */
+		ut_ad(page_rec_is_user_rec(node_ptr));
+
+		offsets = rec_get_offsets(node_ptr, index, offsets, false,
+					  ULINT_UNDEFINED, &heap);
+		page_no = btr_node_ptr_get_child_page_no(node_ptr, offsets);
+
+		if (level == 1) {
+			break;
+		}
+
+		block = btr_block_get(
+			page_id_t(index->table->space->id, page_no),
+			page_size, RW_S_LATCH, index, mtr);
+	}
+
+	if (UNIV_LIKELY_NULL(heap)) {
+		mem_heap_free(heap);
+	}
+
+	return(page_no);
+}
+
 /*==================== B-TREE INSERT =========================*/
 
 /*************************************************************//**
@@ -3252,8 +3319,16 @@ btr_cur_optimistic_insert(
 			ut_ad(*static_cast<const byte*>
 			      (trx_id[1].data) & 0x80);
 			if (flags & BTR_NO_UNDO_LOG_FLAG) {
+				/* DB_TRX_ID is only retained when
+				inserting into an empty table
+				(innodb_bulk_insert) or into an
+				intrinsic temporary table. */
 				ut_ad(!memcmp(trx_id->data, reset_trx_id,
-					      DATA_TRX_ID_LEN));
+					      DATA_TRX_ID_LEN)
+				      || thr->graph->trx->id
+				      == trx_read_trx_id(
+					      static_cast<const byte*>(
+						      trx_id->data)));
 			} else {
 				ut_ad(thr->graph->trx->id);
 				ut_ad(thr->graph->trx->id
@@ -4542,16 +4617,19 @@ btr_cur_pessimistic_update(
 		which got new values in the update, if they are not
 		inherited values. They can be inherited if we have
 		updated the primary key to another value, and then
-		update it back again. */
+		update it back again. In an intrinsic temporary table,
+		the old values are not undo logged, so they must be
+		freed right away. */
 
 		ut_ad(big_rec_vec == NULL);
 		ut_ad(dict_index_is_clust(index));
-		ut_ad(thr_get_trx(thr)->in_rollback);
+		const bool rollback = thr_get_trx(thr)->in_rollback;
+		ut_ad(rollback || index->table->intrinsic);
 
 		DBUG_EXECUTE_IF("ib_blob_update_rollback", DBUG_SUICIDE(););
 
 		btr_rec_free_updated_extern_fields(
-			index, rec, page_zip, *offsets, update, true, mtr);
+			index, rec, page_zip, *offsets, update, rollback, mtr);
 	}
 
 	if (page_zip_rec_needs_ext(
@@ -282,7 +282,11 @@ btr_search_sys_resize(ulint hash_size)
 		return;
 	}
 
-	/* Step-2: Recreate hash tables with new size. */
+	/* Step-2: Wait for btr_search_guess_on_hash() calls that
+	are probing the hash tables without holding the latches. */
+	buf_pool_lock_free_disable();
+
+	/* Step-3: Recreate hash tables with new size. */
 	for (ulint i = 0; i < btr_ahi_parts; ++i) {
 
 		mem_heap_free(btr_search_sys->hash_tables[i]->heap);
@@ -298,7 +302,9 @@ btr_search_sys_resize(ulint hash_size)
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 	}
 
-	/* Step-3: Unlock all search latches from exclusive mode. */
+	buf_pool_lock_free_enable();
+
+	/* Step-4: Unlock all search latches from exclusive mode. */
 	btr_search_x_unlock_all();
 }
 
@@ -398,8 +404,10 @@ btr_search_disable(
 
 	/* Clear the adaptive hash index. */
 	for (ulint i = 0; i < btr_ahi_parts; ++i) {
+		ha_chain_version_inc_all(btr_search_sys->hash_tables[i]);
 		hash_table_clear(btr_search_sys->hash_tables[i]);
 		mem_heap_empty(btr_search_sys->hash_tables[i]->heap);
+		ha_chain_version_inc_all(btr_search_sys->hash_tables[i]);
 	}
 
 	btr_search_x_unlock_all();
@@ -934,28 +942,62 @@ btr_search_guess_on_hash(
 	cursor->fold = fold;
 	cursor->flag = BTR_CUR_HASH;
 
-	rw_lock_t* use_latch = ahi_latch ? NULL : btr_get_search_latch(index);
-
-	if (use_latch) {
-		rw_lock_s_lock(use_latch);
+	hash_table_t*	table;
+	rw_lock_t*	use_latch = NULL;
+	ulint*		readers = NULL;
+	ulint		version = ULINT_UNDEFINED;
 
-		if (!btr_search_enabled) {
-			goto fail;
-		}
-	} else {
+	if (ahi_latch) {
 		ut_ad(btr_search_enabled);
 		ut_ad(rw_lock_own(ahi_latch, RW_LOCK_S));
-	}
+		table = btr_get_search_table(index);
+		rec = ha_search_and_get_data(table, fold);
+	} else {
+		/* Probe the hash table without acquiring the latch,
+		to avoid contention on it. The result will be validated
+		after the page has been latched. If the hash chain is
+		being modified, fall back to acquiring the latch.
+		Registering the lookup prevents btr_search_sys_resize()
+		and buf_pool_resize() from freeing the hash table or the
+		buffer pool blocks until we are done with them. */
+		readers = buf_pool_lock_free_enter();
+
+		if (readers != NULL) {
+			table = btr_get_search_table(index);
+			version = ha_search_and_get_data_lock_free(
+				table, fold, &rec);
+
+			if (version == ULINT_UNDEFINED) {
+				buf_pool_lock_free_exit(readers);
+				readers = NULL;
+			} else {
+				DEBUG_SYNC_C("btr_search_guess_lock_free");
+			}
+		}
+
+		if (version == ULINT_UNDEFINED) {
+			use_latch = btr_get_search_latch(index);
+			rw_lock_s_lock(use_latch);
 
-	rec = (rec_t*) ha_search_and_get_data(
-		btr_get_search_table(index), fold);
+			if (!btr_search_enabled) {
+				goto fail;
+			}
+
+			table = btr_get_search_table(index);
+			rec = ha_search_and_get_data(table, fold);
+		}
+	}
 
 	if (rec == NULL) {
-		if (use_latch) {
 fail:
+		if (use_latch) {
 			rw_lock_s_unlock(use_latch);
 		}
 
+		if (readers) {
+			buf_pool_lock_free_exit(readers);
+		}
+
 		btr_search_failure(info, cursor);
 
 		return(FALSE);
@@ -963,15 +1005,43 @@ btr_search_guess_on_hash(
 
 	buf_block_t*	block = buf_block_from_ahi(rec);
 
-	if (use_latch) {
+	if (!ahi_latch) {
 
+		/* If the block was found without holding the latch, it
+		may have been freed and even reused for another page by
+		now. Let buf_page_get_known_nowait() skip its checks for
+		a valid, accessible page; the page will be made young
+		below if the guess turns out to be valid. */
 		if (!buf_page_get_known_nowait(
-			latch_mode, block, BUF_MAKE_YOUNG,
+			latch_mode, block,
+			use_latch ? BUF_MAKE_YOUNG : BUF_KEEP_OLD,
 			__FILE__, __LINE__, mtr)) {
 			goto fail;
 		}
 
-		rw_lock_s_unlock(use_latch);
+		if (use_latch) {
+			rw_lock_s_unlock(use_latch);
+		} else {
+			const bool valid = ha_chain_version_validate(
+				table, fold, version);
+
+			/* Now that the block is buffer-fixed, it cannot
+			be evicted or freed, and we are done with the
+			hash table. */
+			buf_pool_lock_free_exit(readers);
+
+			if (!valid) {
+				/* The hash chain was modified after the
+				probe. The block may have been evicted and
+				reused for another page after the probe,
+				before we latched it. Now rec may no longer
+				point to a record that the hash index entry
+				was built for. */
+				btr_leaf_page_release(block, latch_mode, mtr);
+				btr_search_failure(info, cursor);
+				return(FALSE);
+			}
+		}
 
 		buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
 	}
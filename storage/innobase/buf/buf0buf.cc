@@ -78,6 +78,9 @@ Created 11/5/1995 Heikki Tuuri
 #include "ha_prototypes.h"
 #include "ut0byte.h"
 #include <new>
+#ifdef HAVE_URING
+#include <sys/uio.h>
+#endif /* HAVE_URING */
 
 #ifdef UNIV_LINUX
 #include <stdlib.h>
@@ -366,6 +369,87 @@ volatile bool	buf_pool_resizing;
 /** true when withdrawing buffer pool pages might cause page relocation */
 volatile bool	buf_pool_withdrawing;
 
+/** Number of slots in buf_pool_lock_free_readers */
+static const ulint	BUF_POOL_LOCK_FREE_READER_SLOTS = 64;
+
+/** A count of lock-free buffer pool lookups in progress */
+struct MY_ALIGNED(CACHE_LINE_SIZE) buf_pool_lock_free_readers_t {
+	/** number of lookups in progress */
+	ulint	n;
+	/** padding to prevent false sharing between the counters */
+	byte	pad[CACHE_LINE_SIZE - sizeof(ulint)];
+};
+
+/** Counts of lock-free lookups in progress, by
+buf_block_hash_fix_lock_free() or btr_search_guess_on_hash(). A thread
+always uses the same slot, so that the cache line of the slot normally
+stays with the processor that runs the thread. */
+static buf_pool_lock_free_readers_t	buf_pool_lock_free_readers[
+	BUF_POOL_LOCK_FREE_READER_SLOTS];
+
+/** Nonzero while memory that lock-free lookups could access may be
+freed; see buf_pool_lock_free_disable() */
+static ulint	buf_pool_lock_free_disabled;
+
+/** Register a lookup that accesses buf_pool->page_hash, the adaptive hash
+index, or the buffer pool blocks that they point to, without holding
+any latch. The memory will not be freed before buf_pool_lock_free_exit().
+@return the counter to pass to buf_pool_lock_free_exit()
+@retval NULL if lock-free lookups are disabled */
+ulint*
+buf_pool_lock_free_enter()
+{
+	/* A thread identifier is usually the address of a thread
+	descriptor that is aligned to a large power of 2. */
+	ulint	id = ulint(os_thread_get_curr_id());
+	ulint*	n = &buf_pool_lock_free_readers[
+		(id ^ (id >> 12) ^ (id >> 24))
+		% BUF_POOL_LOCK_FREE_READER_SLOTS].n;
+
+	/* Use a full memory barrier, so that
+	buf_pool_lock_free_disable() will either wait for us,
+	or we will see buf_pool_lock_free_disabled. */
+	my_atomic_addlint(n, 1);
+
+	if (my_atomic_loadlint(&buf_pool_lock_free_disabled)) {
+		my_atomic_addlint(n, ulint(-1));
+		return(NULL);
+	}
+
+	return(n);
+}
+
+/** Unregister a lookup that was registered by buf_pool_lock_free_enter().
+@param[in,out]	n	return value of buf_pool_lock_free_enter() */
+void
+buf_pool_lock_free_exit(ulint* n)
+{
+	my_atomic_addlint(n, ulint(-1));
+}
+
+/** Make buf_pool_lock_free_enter() fail, and wait for the lookups in
+progress to finish, so that buffer pool chunks, page_hash or the adaptive
+hash index tables may be freed. */
+void
+buf_pool_lock_free_disable()
+{
+	my_atomic_addlint(&buf_pool_lock_free_disabled, 1);
+
+	for (ulint i = 0; i < BUF_POOL_LOCK_FREE_READER_SLOTS; i++) {
+		while (my_atomic_loadlint(&buf_pool_lock_free_readers[i].n)) {
+			os_thread_yield();
+		}
+	}
+}
+
+/** Allow buf_pool_lock_free_enter() again after
+buf_pool_lock_free_disable(). */
+void
+buf_pool_lock_free_enable()
+{
+	my_atomic_addlint(&buf_pool_lock_free_disabled, ulint(-1));
+}
+
 /** the clock is incremented every time a pointer to a page may become obsolete;
 if the withdrwa clock has not changed, the pointer is still valid in buffer
 pool. if changed, the pointer might not be in buffer pool any more. */
@@ -1474,6 +1558,7 @@ buf_block_init(
 	block->page.flush_type = BUF_FLUSH_LRU;
 	block->page.state = BUF_BLOCK_NOT_USED;
 	block->page.buf_fix_count = 0;
+	block->n_lock_free_pins = 0;
 	block->page.io_fix = BUF_IO_NONE;
 	block->page.flush_observer = NULL;
 	block->page.encrypted = false;
@@ -1776,6 +1861,227 @@ buf_pool_set_sizes(void)
 	buf_pool_mutex_exit_all();
 }
 
+/** Page counters of an index in buf_pool->index_stats */
+struct buf_index_stat_node_t {
+	ulint			space;		/*!< tablespace identifier */
+	index_id_t		index_id;	/*!< index identifier */
+	buf_index_stat_t	stat;		/*!< page counters */
+	buf_index_stat_node_t*	hash;		/*!< hash chain node */
+};
+
+/** Adjust the page counters of an index.
+The entry is created when the first page of the index is counted,
+and removed when the last counted page leaves the buffer pool.
+@param[in,out]	buf_pool	buffer pool instance
+@param[in]	space		tablespace identifier
+@param[in]	index_id	index identifier
+@param[in]	pages		change of buf_index_stat_t::n_pages
+@param[in]	dirty		change of buf_index_stat_t::n_dirty
+@param[in]	read		number of pages read
+@param[in]	young		number of pages made young */
+static
+void
+buf_index_stat_update(
+	buf_pool_t*	buf_pool,
+	ulint		space,
+	index_id_t	index_id,
+	lint		pages,
+	lint		dirty,
+	ulint		read,
+	ulint		young)
+{
+	const ulint		fold = ut_fold_ulint_pair(
+		space, ut_fold_ull(index_id));
+	buf_index_stat_node_t*	node;
+
+	ut_ad(index_id != 0);
+
+	mutex_enter(&buf_pool->index_stats_mutex);
+
+	HASH_SEARCH(hash, buf_pool->index_stats, fold,
+		    buf_index_stat_node_t*, node, ut_ad(1),
+		    node->space == space && node->index_id == index_id);
+
+	if (node == NULL) {
+		if (pages <= 0) {
+			/* buf_LRU_make_block_young() does not hold the
+			block mutex. The page may have been counted under
+			another index in the meantime. */
+			ut_ad(pages == 0);
+			ut_ad(dirty == 0);
+			ut_ad(read == 0);
+			goto func_exit;
+		}
+
+		node = static_cast<buf_index_stat_node_t*>(
+			ut_zalloc_nokey(sizeof *node));
+		node->space = space;
+		node->index_id = index_id;
+
+		HASH_INSERT(buf_index_stat_node_t, hash,
+			    buf_pool->index_stats, fold, node);
+	}
+
+	ut_ad(pages >= 0 || node->stat.n_pages >= ulint(-pages));
+	ut_ad(dirty >= 0 || node->stat.n_dirty >= ulint(-dirty));
+
+	node->stat.n_pages += ulint(pages);
+	node->stat.n_dirty += ulint(dirty);
+	node->stat.n_pages_read += read;
+	node->stat.n_pages_made_young += young;
+
+	ut_ad(node->stat.n_dirty <= node->stat.n_pages);
+
+	if (node->stat.n_pages == 0) {
+		HASH_DELETE(buf_index_stat_node_t, hash,
+			    buf_pool->index_stats, fold, node);
+		ut_free(node);
+	}
+
+func_exit:
+	mutex_exit(&buf_pool->index_stats_mutex);
+}
+
+/** Count a page that was read into the buffer pool.
+@param[in,out]	bpage		page; buf_page_get_mutex(bpage) must be held
+@param[in]	uncompressed	whether the page is in an uncompressed block */
+static
+void
+buf_index_stat_read(buf_page_t* bpage, bool uncompressed)
+{
+	ut_ad(mutex_own(buf_page_get_mutex(bpage)));
+	ut_ad(bpage->stat_index_id == 0);
+
+	const byte*	frame = uncompressed
+		? reinterpret_cast<buf_block_t*>(bpage)->frame
+		: bpage->zip.data;
+
+	if (!fil_page_index_page_check(frame)) {
+		return;
+	}
+
+	if (index_id_t index_id = btr_page_get_index_id(frame)) {
+		/* Crash recovery may have applied redo log to the page
+		already, inserting it into the flush list. */
+		bpage->stat_index_id = index_id;
+		buf_index_stat_update(buf_pool_from_bpage(bpage),
+				      bpage->id.space(), index_id, 1,
+				      bpage->oldest_modification != 0, 1, 0);
+	}
+}
+
+/** Note that the PAGE_INDEX_ID of a page was initialized.
+@param[in,out]	block		buffer block
+@param[in]	index_id	index identifier, or 0 if the page
+				no longer belongs to an index */
+void
+buf_block_set_index_stat(buf_block_t* block, index_id_t index_id)
+{
+	buf_pool_t*	buf_pool = buf_pool_from_block(block);
+	const ulint	space = block->page.id.space();
+
+	buf_page_mutex_enter(block);
+
+	const index_id_t	old_id = block->page.stat_index_id;
+
+	if (old_id != index_id) {
+		const lint	dirty = block->page.oldest_modification != 0;
+
+		block->page.stat_index_id = index_id;
+
+		if (old_id != 0) {
+			buf_index_stat_update(
+				buf_pool, space, old_id, -1, -dirty, 0, 0);
+		}
+
+		if (index_id != 0) {
+			buf_index_stat_update(
+				buf_pool, space, index_id, 1, dirty, 0, 0);
+		}
+	}
+
+	buf_page_mutex_exit(block);
+}
+
+/** Stop counting a page that is leaving the buffer pool.
+@param[in,out]	bpage	page; buf_page_get_mutex(bpage) must be held */
+void
+buf_index_stat_evict(buf_page_t* bpage)
+{
+	ut_ad(mutex_own(buf_page_get_mutex(bpage)));
+	ut_ad(bpage->oldest_modification == 0);
+
+	if (index_id_t index_id = bpage->stat_index_id) {
+		bpage->stat_index_id = 0;
+		buf_index_stat_update(buf_pool_from_bpage(bpage),
+				      bpage->id.space(), index_id, -1, 0, 0, 0);
+	}
+}
+
+/** Count a page that was added to or removed from the flush list.
+@param[in]	bpage	page; buf_page_get_mutex(bpage) must be held
+@param[in]	dirty	whether the page was added to the flush list */
+void
+buf_index_stat_dirty(const buf_page_t* bpage, bool dirty)
+{
+	ut_ad(mutex_own(buf_page_get_mutex(bpage)));
+
+	if (index_id_t index_id = bpage->stat_index_id) {
+		buf_index_stat_update(buf_pool_from_bpage(bpage),
+				      bpage->id.space(), index_id,
+				      0, dirty ? 1 : -1, 0, 0);
+	}
+}
+
+/** Count a page that was made young.
+@param[in]	bpage	page; buf_pool->mutex must be held */
+void
+buf_index_stat_made_young(const buf_page_t* bpage)
+{
+	ut_ad(buf_pool_mutex_own(buf_pool_from_bpage(bpage)));
+
+	if (index_id_t index_id = bpage->stat_index_id) {
+		buf_index_stat_update(buf_pool_from_bpage(bpage),
+				      bpage->id.space(), index_id,
+				      0, 0, 0, 1);
+	}
+}
+
+/** Collect the page counters of the indexes in the buffer pool.
+@param[out]	stats	page counters of all buffer pool instances */
+void
+buf_index_stats_get(buf_index_stats_t& stats)
+{
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_pool_t*	buf_pool = buf_pool_from_array(i);
+
+		mutex_enter(&buf_pool->index_stats_mutex);
+
+		for (ulint c = hash_get_n_cells(buf_pool->index_stats);
+		     c--; ) {
+			for (const buf_index_stat_node_t* node
+				     = static_cast<buf_index_stat_node_t*>(
+					     HASH_GET_FIRST(
+						     buf_pool->index_stats,
+						     c));
+			     node != NULL;
+			     node = node->hash) {
+				buf_index_stat_t&	stat = stats[
+					std::make_pair(node->space,
+						       node->index_id)];
+
+				stat.n_pages += node->stat.n_pages;
+				stat.n_dirty += node->stat.n_dirty;
+				stat.n_pages_read += node->stat.n_pages_read;
+				stat.n_pages_made_young
+					+= node->stat.n_pages_made_young;
+			}
+		}
+
+		mutex_exit(&buf_pool->index_stats_mutex);
+	}
+}
+
 /********************************************************************//**
 Initialize a buffer pool instance.
 @return DB_SUCCESS if all goes well. */
@@ -1820,6 +2126,7 @@ buf_pool_init_instance(
 		buf_pool->withdraw_target = 0;
 		UT_LIST_INIT(buf_pool->flush_list, &buf_page_t::list);
 		UT_LIST_INIT(buf_pool->unzip_LRU, &buf_block_t::unzip_LRU);
+		UT_LIST_INIT(buf_pool->free_desc, &buf_page_t::list);
 
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
 		UT_LIST_INIT(buf_pool->zip_clean, &buf_page_t::list);
@@ -1883,6 +2190,11 @@ buf_pool_init_instance(
 
 		buf_pool->page_hash_old = NULL;
 
+		buf_pool->page_hash_versions
+			= static_cast<buf_page_hash_version_t*>(
+				ut_zalloc_nokey(srv_n_page_hash_locks
+						* sizeof(buf_page_hash_version_t)));
+
 		buf_pool->zip_hash = hash_create(2 * buf_pool->curr_size);
 
 		buf_pool->last_printout_time = ut_time();
@@ -1892,6 +2204,9 @@ buf_pool_init_instance(
 
 	mutex_create(LATCH_ID_FLUSH_LIST, &buf_pool->flush_list_mutex);
 
+	mutex_create(LATCH_ID_BUF_INDEX_STATS, &buf_pool->index_stats_mutex);
+	buf_pool->index_stats = hash_create(1024);
+
 	for (i = BUF_FLUSH_LRU; i < BUF_FLUSH_N_TYPES; i++) {
 		buf_pool->no_flush[i] = os_event_create(0);
 	}
@@ -1953,6 +2268,23 @@ buf_pool_free_instance(
 	mutex_free(&buf_pool->mutex);
 	mutex_free(&buf_pool->zip_mutex);
 	mutex_free(&buf_pool->flush_list_mutex);
+	mutex_free(&buf_pool->index_stats_mutex);
+
+	for (ulint i = hash_get_n_cells(buf_pool->index_stats); i--; ) {
+		buf_index_stat_node_t*	node
+			= static_cast<buf_index_stat_node_t*>(
+				HASH_GET_FIRST(buf_pool->index_stats, i));
+
+		while (node != NULL) {
+			buf_index_stat_node_t*	next
+				= static_cast<buf_index_stat_node_t*>(
+					HASH_GET_NEXT(hash, node));
+			ut_free(node);
+			node = next;
+		}
+	}
+
+	hash_table_free(buf_pool->index_stats);
 
 	if (buf_pool->flush_rbt) {
 		rbt_free(buf_pool->flush_rbt);
@@ -1974,10 +2306,15 @@ buf_pool_free_instance(
 			when doing a fast shutdown. */
 			ut_ad(state == BUF_BLOCK_ZIP_PAGE
 			      || srv_fast_shutdown == 2);
-			buf_page_free_descriptor(bpage);
+			ut_free(bpage);
 		}
 	}
 
+	while ((bpage = UT_LIST_GET_FIRST(buf_pool->free_desc)) != NULL) {
+		UT_LIST_REMOVE(buf_pool->free_desc, bpage);
+		ut_free(bpage);
+	}
+
 	ut_free(buf_pool->watch);
 	buf_pool->watch = NULL;
 
@@ -2002,9 +2339,14 @@ buf_pool_free_instance(
 		os_event_destroy(buf_pool->no_flush[i]);
 	}
 
+	if (buf_pool->lru_manager_event) {
+		os_event_destroy(buf_pool->lru_manager_event);
+	}
+
 	ut_free(buf_pool->chunks);
 	ha_clear(buf_pool->page_hash);
 	hash_table_free(buf_pool->page_hash);
+	ut_free(buf_pool->page_hash_versions);
 	hash_table_free(buf_pool->zip_hash);
 
 	/* Free all used temporary slots */
@@ -2030,6 +2372,38 @@ buf_pool_free_instance(
 	buf_pool->allocator.~ut_allocator();
 }
 
+#ifdef HAVE_URING
+/** Register the memory of the buffer pool chunks with io_uring, so that
+page reads and writes can use fixed buffers. */
+static
+void
+buf_pool_register_io_buffers()
+{
+	/* The kernel limits a fixed buffer to 1 GiB. */
+	const size_t		max_len = size_t(1) << 30;
+	std::vector<iovec>	bufs;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		const buf_pool_t*	buf_pool = buf_pool_from_array(i);
+		const buf_chunk_t*	chunk = buf_pool->chunks;
+
+		for (ulint n = buf_pool->n_chunks; n--; chunk++) {
+			for (size_t offs = 0; offs < chunk->mem_size();
+			     offs += max_len) {
+				iovec	iov;
+
+				iov.iov_base = chunk->mem + offs;
+				iov.iov_len = std::min(
+					chunk->mem_size() - offs, max_len);
+				bufs.push_back(iov);
+			}
+		}
+	}
+
+	os_aio_register_buffers(bufs.empty() ? NULL : &bufs[0], bufs.size());
+}
+#endif /* HAVE_URING */
+
 /********************************************************************//**
 Creates the buffer pool.
 @return DB_SUCCESS if success, DB_ERROR if not enough memory or error */
@@ -2076,6 +2450,10 @@ buf_pool_init(
 
 	btr_search_sys_create(buf_pool_get_curr_size() / sizeof(void*) / 64);
 
+#ifdef HAVE_URING
+	buf_pool_register_io_buffers();
+#endif /* HAVE_URING */
+
 	return(DB_SUCCESS);
 }
 
@@ -2184,8 +2562,8 @@ buf_page_realloc(
 		ut_d(block->page.in_page_hash = FALSE);
 		ulint	fold = block->page.id.fold();
 		ut_ad(fold == new_block->page.id.fold());
-		HASH_DELETE(buf_page_t, hash, buf_pool->page_hash, fold, (&block->page));
-		HASH_INSERT(buf_page_t, hash, buf_pool->page_hash, fold, (&new_block->page));
+		buf_page_hash_delete(buf_pool, fold, &block->page);
+		buf_page_hash_insert(buf_pool, fold, &new_block->page);
 
 		ut_ad(new_block->page.in_page_hash);
 
@@ -2823,9 +3201,20 @@ buf_pool_resize()
 		return;
 	}
 
+#ifdef HAVE_URING
+	/* Chunks may be freed. Unregister them as fixed buffers
+	before that. This does not wait for pending reads or writes,
+	which keep using the buffers that were registered when they
+	were submitted. */
+	os_aio_register_buffers(NULL, 0);
+#endif /* HAVE_URING */
+
 	/* Indicate critical path */
 	buf_pool_resizing = true;
 
+	/* Chunks and page_hash may be freed. */
+	buf_pool_lock_free_disable();
+
 	/* Acquire all buf_pool_mutex/hash_lock */
 	for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
 		buf_pool_t*	buf_pool = buf_pool_from_array(i);
@@ -3050,6 +3439,12 @@ buf_pool_resize()
 
 	buf_pool_resizing = false;
 
+	buf_pool_lock_free_enable();
+
+#ifdef HAVE_URING
+	buf_pool_register_io_buffers();
+#endif /* HAVE_URING */
+
 	/* Normalize other components, if the new size is too different */
 	if (!warning && new_size_too_diff) {
 		srv_buf_pool_base_size = srv_buf_pool_size;
@@ -3296,8 +3691,8 @@ buf_relocate(
 	/* relocate buf_pool->page_hash */
 	ulint	fold = bpage->id.fold();
 	ut_ad(fold == dpage->id.fold());
-	HASH_DELETE(buf_page_t, hash, buf_pool->page_hash, fold, bpage);
-	HASH_INSERT(buf_page_t, hash, buf_pool->page_hash, fold, dpage);
+	buf_page_hash_delete(buf_pool, fold, bpage);
+	buf_page_hash_insert(buf_pool, fold, dpage);
 }
 
 /** Hazard Pointer implementation. */
@@ -3498,8 +3893,7 @@ buf_pool_watch_set(
 			bpage->buf_fix_count = 1;
 
 			ut_d(bpage->in_page_hash = TRUE);
-			HASH_INSERT(buf_page_t, hash, buf_pool->page_hash,
-				    page_id.fold(), bpage);
+			buf_page_hash_insert(buf_pool, page_id.fold(), bpage);
 
 			buf_pool_mutex_exit(buf_pool);
 			/* Once the sentinel is in the page_hash we can
@@ -3548,8 +3942,7 @@ buf_pool_watch_remove(
 
 	ut_ad(buf_pool_mutex_own(buf_pool));
 
-	HASH_DELETE(buf_page_t, hash, buf_pool->page_hash, watch->id.fold(),
-		    watch);
+	buf_page_hash_delete(buf_pool, watch->id.fold(), watch);
 	ut_d(watch->in_page_hash = FALSE);
 	watch->buf_fix_count = 0;
 	watch->state = BUF_BLOCK_POOL_WATCH;
@@ -4056,11 +4449,10 @@ buf_block_from_ahi(const byte* ptr)
 	/* The function buf_chunk_init() invokes buf_block_init() so that
 	block[n].frame == block->frame + n * UNIV_PAGE_SIZE.  Check it. */
 	ut_ad(block->frame == page_align(ptr));
-	/* Read the state of the block without holding a mutex.
-	A state transition from BUF_BLOCK_FILE_PAGE to
-	BUF_BLOCK_REMOVE_HASH is possible during this execution. */
-	ut_d(const buf_page_state state = buf_block_get_state(block));
-	ut_ad(state == BUF_BLOCK_FILE_PAGE || state == BUF_BLOCK_REMOVE_HASH);
+	/* The state of the block is not checked here. Unless the caller
+	holds the adaptive hash index latch, the block may have been freed
+	or even reused since ptr was looked up, and the caller will have to
+	check the state after buffer-fixing the block. */
 	return(block);
 }
 #endif /* BTR_CUR_HASH_ADAPT */
@@ -4202,6 +4594,133 @@ buf_wait_for_read(
 	}
 }
 
+/** Look up a page in buf_pool->page_hash without acquiring the page_hash
+latch. The hash chain is traversed like in a sequence lock: the version
+counter of the page_hash latch partition must not change while the chain
+is being traversed.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	page_id		page id
+@param[out]	v		version of the page_hash latch partition
+@return the block that was found
+@retval NULL if the page was not found as an uncompressed page, or the
+hash chain was modified during the lookup */
+static
+buf_block_t*
+buf_block_hash_get_lock_free(
+	buf_pool_t*		buf_pool,
+	const page_id_t&	page_id,
+	ulint&			v)
+{
+	const ulint		fold = page_id.fold();
+	hash_table_t*		table = buf_pool->page_hash;
+	const ulint*		version = buf_page_hash_version(buf_pool, fold);
+
+	v = ulint(my_atomic_loadlint(version));
+
+	if (v & 1) {
+		return(NULL);
+	}
+
+	buf_page_t*	bpage = static_cast<buf_page_t*>(my_atomic_loadptr(
+		&hash_get_nth_cell(table, hash_calc_hash(fold, table))->node));
+
+	/* Any node may be removed from the chain, or moved to another
+	chain, by a concurrent writer. The descriptors of compressed-only
+	pages are never freed while the server is running (see
+	buf_page_free_descriptor()), and the blocks are only freed by
+	buf_pool_resize(), which waits for us. So, reading a node that
+	was removed after the check is harmless; the next check will
+	fail. This also prevents looping forever if a concurrent
+	modification makes us see a cycle. */
+	while (bpage != NULL) {
+		if (ulint(my_atomic_loadlint(version)) != v) {
+			return(NULL);
+		}
+
+		if (page_id.equals_to(bpage->id)) {
+			break;
+		}
+
+		bpage = static_cast<buf_page_t*>(my_atomic_loadptr(
+			reinterpret_cast<void**>(&bpage->hash)));
+	}
+
+	/* Only a block that contains an uncompressed page can be in
+	the state BUF_BLOCK_FILE_PAGE while it is in page_hash. Leave
+	compressed-only pages and watch sentinels to the caller. */
+	if (bpage == NULL
+	    || bpage->state != BUF_BLOCK_FILE_PAGE
+	    || ulint(my_atomic_loadlint(version)) != v) {
+		return(NULL);
+	}
+
+	return(reinterpret_cast<buf_block_t*>(bpage));
+}
+
+/** Look up a page in buf_pool->page_hash without acquiring the page_hash
+latch, and buffer-fix it. On a hit, this does not acquire any mutex or
+latch. It writes to the block descriptor and to a buf_pool_lock_free_enter()
+slot, which is shared by the threads that map to the same slot.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	page_id		page id
+@return the buffer-fixed block
+@retval NULL if the lookup must be repeated while holding the latch */
+static
+buf_block_t*
+buf_block_hash_fix_lock_free(buf_pool_t* buf_pool, const page_id_t& page_id)
+{
+	ulint*		readers = buf_pool_lock_free_enter();
+
+	if (readers == NULL) {
+		return(NULL);
+	}
+
+	ulint		v;
+	buf_block_t*	block = buf_block_hash_get_lock_free(
+		buf_pool, page_id, v);
+
+	if (block != NULL) {
+		DEBUG_SYNC_C("buf_block_hash_fix_lock_free");
+
+		/* The block may have been evicted, and even reused for
+		another page, after we found it. Announce that we may
+		buffer-fix it, and then check that the page_hash version
+		is unchanged. Eviction changes the version before it waits
+		for n_lock_free_pins to be 0 and checks buf_fix_count (see
+		buf_LRU_block_lock_free_wait()), so either we see the
+		change, or the eviction sees our buffer-fix. Both sides
+		use full memory barriers. */
+		my_atomic_addlint(&block->n_lock_free_pins, 1);
+
+		if (ulint(my_atomic_loadlint(buf_page_hash_version(
+				buf_pool, page_id.fold()))) != v) {
+			my_atomic_addlint(&block->n_lock_free_pins, ulint(-1));
+			block = NULL;
+		} else {
+			buf_block_fix(block);
+
+			/* Now that the block is buffer-fixed, it cannot
+			be evicted. Check that it still is what we were
+			looking for. */
+			if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
+			    || !page_id.equals_to(block->page.id)) {
+				ut_ad(0);
+				buf_block_unfix(block);
+				my_atomic_addlint(&block->n_lock_free_pins,
+						  ulint(-1));
+				block = NULL;
+			} else {
+				my_atomic_addlint(&block->n_lock_free_pins,
+						  ulint(-1));
+			}
+		}
+	}
+
+	buf_pool_lock_free_exit(readers);
+
+	return(block);
+}
+
 /** This is the general function used to get access to a database page.
 @param[in]	page_id		page id
 @param[in]	rw_latch	RW_S_LATCH, RW_X_LATCH, RW_NO_LATCH
@@ -4279,6 +4798,17 @@ buf_page_get_gen(
 loop:
 	block = guess;
 
+	/* Pages of the temporary tablespace must be buffer-fixed while
+	holding block->mutex; see below. */
+	if (block == NULL && !fsp_is_system_temporary(page_id.space())) {
+		fix_block = buf_block_hash_fix_lock_free(buf_pool, page_id);
+
+		if (fix_block != NULL) {
+			block = fix_block;
+			goto got_block;
+		}
+	}
+
 	rw_lock_s_lock(hash_lock);
 
 	/* If not own buf_pool_mutex, page_hash can be changed. */
@@ -4632,14 +5162,13 @@ buf_page_get_gen(
 		rw_lock_x_unlock(hash_lock);
 		buf_pool->n_pend_unzip++;
 		mutex_exit(&buf_pool->zip_mutex);
+		buf_page_free_descriptor(buf_pool, bpage);
 		buf_pool_mutex_exit(buf_pool);
 
 		access_time = buf_page_is_accessed(&block->page);
 
 		buf_page_mutex_exit(block);
 
-		buf_page_free_descriptor(bpage);
-
 		/* Decompress the page while not holding
 		buf_pool->mutex or block->mutex. */
 
@@ -5022,7 +5551,10 @@ buf_page_get_known_nowait(
 
 	buf_page_mutex_enter(block);
 
-	if (buf_block_get_state(block) == BUF_BLOCK_REMOVE_HASH) {
+	switch (buf_block_get_state(block)) {
+	case BUF_BLOCK_FILE_PAGE:
+		break;
+	case BUF_BLOCK_REMOVE_HASH:
 		/* Another thread is just freeing the block from the LRU list
 		of the buffer pool: do not try to access this page; this
 		attempt to access the page can only come through the hash
@@ -5033,9 +5565,16 @@ buf_page_get_known_nowait(
 		buf_page_mutex_exit(block);
 
 		return(FALSE);
-	}
+	default:
+		/* The block was found through the adaptive hash index
+		without holding its latch, and it has already been
+		freed. See btr_search_guess_on_hash(). */
+		ut_ad(mode == BUF_KEEP_OLD);
 
-	ut_a(buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE);
+		buf_page_mutex_exit(block);
+
+		return(FALSE);
+	}
 
 	buf_block_buf_fix_inc(block, file, line);
 
@@ -5210,6 +5749,7 @@ buf_page_init_low(
 	bpage->old = 0;
 	bpage->freed_page_clock = 0;
 	bpage->access_time = 0;
+	bpage->stat_index_id = 0;
 	bpage->newest_modification = 0;
 	bpage->oldest_modification = 0;
 	bpage->write_size = 0;
@@ -5301,8 +5841,7 @@ buf_page_init(
 	block->page.id.copy_from(page_id);
 	block->page.size.copy_from(page_size);
 
-	HASH_INSERT(buf_page_t, hash, buf_pool->page_hash,
-		    page_id.fold(), &block->page);
+	buf_page_hash_insert(buf_pool, page_id.fold(), &block->page);
 
 	if (page_size.is_compressed()) {
 		page_zip_set_size(&block->page.zip, page_size.physical());
@@ -5480,7 +6019,7 @@ buf_page_init_for_read(
 			}
 		}
 
-		bpage = buf_page_alloc_descriptor();
+		bpage = buf_page_alloc_descriptor(buf_pool);
 
 		/* Initialize the buf_pool pointer. */
 		bpage->buf_pool_index = buf_pool_index(buf_pool);
@@ -5523,8 +6062,7 @@ buf_page_init_for_read(
 			buf_pool_watch_remove(buf_pool, watch_page);
 		}
 
-		HASH_INSERT(buf_page_t, hash, buf_pool->page_hash,
-			    bpage->id.fold(), bpage);
+		buf_page_hash_insert(buf_pool, bpage->id.fold(), bpage);
 
 		rw_lock_x_unlock(hash_lock);
 
@@ -5604,7 +6142,13 @@ buf_page_create(
 
 		buf_block_free(free_block);
 
-		return(buf_page_get_with_no_latch(page_id, page_size, mtr));
+		block = buf_page_get_with_no_latch(page_id, page_size, mtr);
+
+		/* The freed page is being reused, possibly for something
+		else than an index page. */
+		buf_block_set_index_stat(block, 0);
+
+		return(block);
 	}
 
 	/* If we get here, the page was not in buf_pool: init it there */
@@ -6167,6 +6711,7 @@ buf_page_io_complete(buf_page_t* bpage, bool dblwr, bool evict)
 		ut_ad(buf_pool->n_pend_reads > 0);
 		buf_pool->n_pend_reads--;
 		buf_pool->stat.n_pages_read++;
+		buf_index_stat_read(bpage, uncompressed);
 
 		if (uncompressed) {
 			rw_lock_x_unlock_gen(&((buf_block_t*) bpage)->lock,
@@ -7518,7 +8063,8 @@ buf_page_decrypt_after_read(buf_page_t* bpage, fil_space_t* space)
 		fil_decompress_page(slot->comp_buf,
 				    dst_frame,
 				    ulong(size.logical()),
-				    &bpage->write_size);
+				    &bpage->write_size,
+				    false, space->zstd_dict);
 
 		/* Mark this slot as free */
 		slot->reserved = false;
@@ -7565,7 +8111,8 @@ buf_page_decrypt_after_read(buf_page_t* bpage, fil_space_t* space)
 			fil_decompress_page(slot->comp_buf,
 					    dst_frame,
 					    ulong(size.logical()),
-					    &bpage->write_size);
+					    &bpage->write_size,
+					    false, space->zstd_dict);
 			ut_d(fil_page_type_validate(dst_frame));
 		}
 
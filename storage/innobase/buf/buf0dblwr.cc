@@ -109,6 +109,243 @@ buf_dblwr_sync_datafiles()
 	os_aio_wait_until_no_pending_writes();
 }
 
+/** Initialize a doublewrite batch area.
+@param[out]	batch		batch area
+@param[in]	write_buf	page-aligned buffer of
+				srv_doublewrite_batch_size pages,
+				or NULL to allocate it
+@param[in]	buf_block_arr	array of srv_doublewrite_batch_size,
+				or NULL to allocate it */
+static
+void
+buf_dblwr_batch_init(
+	buf_dblwr_batch_t*	batch,
+	byte*			write_buf,
+	buf_page_t**		buf_block_arr)
+{
+	ut_ad(!write_buf == !buf_block_arr);
+
+	mutex_create(LATCH_ID_BUF_DBLWR, &batch->mutex);
+
+	batch->name = NULL;
+	batch->file = OS_FILE_CLOSED;
+	batch->b_event = os_event_create("dblwr_batch_event");
+	batch->first_free = 0;
+	batch->b_reserved = 0;
+	batch->batch_running = false;
+	batch->write_buf_unaligned = NULL;
+
+	if (!write_buf) {
+		batch->write_buf_unaligned = static_cast<byte*>(
+			ut_malloc_nokey((1 + srv_doublewrite_batch_size)
+					* UNIV_PAGE_SIZE));
+		write_buf = static_cast<byte*>(
+			ut_align(batch->write_buf_unaligned,
+				 UNIV_PAGE_SIZE));
+		buf_block_arr = static_cast<buf_page_t**>(
+			ut_zalloc_nokey(srv_doublewrite_batch_size
+					* sizeof(void*)));
+	}
+
+	batch->write_buf = write_buf;
+	batch->buf_block_arr = buf_block_arr;
+}
+
+/** Free a doublewrite batch area.
+@param[in,out]	batch	batch area */
+static
+void
+buf_dblwr_batch_free(buf_dblwr_batch_t* batch)
+{
+	ut_ad(batch->b_reserved == 0);
+
+	if (batch->file != OS_FILE_CLOSED) {
+		os_file_close(batch->file);
+		batch->file = OS_FILE_CLOSED;
+	}
+
+	if (batch->write_buf_unaligned) {
+		ut_free(batch->write_buf_unaligned);
+		ut_free(batch->buf_block_arr);
+	}
+
+	ut_free(batch->name);
+	os_event_destroy(batch->b_event);
+	mutex_free(&batch->mutex);
+}
+
+/** Get the name of a doublewrite file.
+@param[in]	i	file number
+@return	file name, to be freed by ut_free() */
+static
+char*
+buf_dblwr_file_name(ulint i)
+{
+	char		name[OS_FILE_MAX_PATH];
+	const size_t	len = strlen(srv_data_home);
+
+	if (len == 0 || srv_data_home[len - 1] == OS_PATH_SEPARATOR) {
+		snprintf(name, sizeof name, "%sib_dblwr" ULINTPF,
+			 srv_data_home, i);
+	} else {
+		snprintf(name, sizeof name, "%s%cib_dblwr" ULINTPF,
+			 srv_data_home, OS_PATH_SEPARATOR, i);
+	}
+
+	os_normalize_path(name);
+
+	return(mem_strdup(name));
+}
+
+/** Open or create the doublewrite file of a batch area.
+@param[in,out]	batch	batch area whose name has been set
+@param[in]	create	whether to create the file if it does not exist
+@return	whether the file was opened */
+static
+bool
+buf_dblwr_file_open(buf_dblwr_batch_t* batch, bool create)
+{
+	const os_offset_t	size = os_offset_t(srv_doublewrite_batch_size)
+		<< UNIV_PAGE_SIZE_SHIFT;
+	bool			exists;
+	os_file_type_t		type;
+	bool			success;
+
+	if (!os_file_status(batch->name, &exists, &type)) {
+		return(false);
+	}
+
+	if (!exists && !create) {
+		return(false);
+	}
+
+	batch->file = os_file_create(
+		innodb_data_file_key, batch->name,
+		exists ? OS_FILE_OPEN : OS_FILE_CREATE,
+		OS_FILE_NORMAL, OS_DATA_FILE, srv_read_only_mode, &success);
+
+	if (!success) {
+		batch->file = OS_FILE_CLOSED;
+		return(false);
+	}
+
+	if (!exists) {
+		ib::info() << "Creating doublewrite file " << batch->name;
+	}
+
+	if (!srv_read_only_mode && os_file_get_size(batch->file) < size
+	    && !os_file_set_size(batch->name, batch->file, size)) {
+		os_file_close(batch->file);
+		batch->file = OS_FILE_CLOSED;
+		return(false);
+	}
+
+	return(true);
+}
+
+/** Open the innodb_doublewrite_files, and those that were left by
+a larger setting of the parameter. */
+static
+void
+buf_dblwr_files_init()
+{
+	/* Batches can only be written in parallel by different page
+	cleaners if they flush different buffer pool instances. */
+	ulint	n_files = ut_min(ulint(srv_doublewrite_files),
+				 srv_buf_pool_instances);
+	ulint	n_stale = 0;
+
+	if (!srv_use_doublewrite_buf || srv_read_only_mode) {
+		n_files = 0;
+	}
+
+	/* Count the stale files, whose pages may be needed for
+	crash recovery. */
+	for (ulint i = n_files;; i++) {
+		char*		name = buf_dblwr_file_name(i);
+		bool		exists;
+		os_file_type_t	type;
+
+		if (!os_file_status(name, &exists, &type) || !exists) {
+			ut_free(name);
+			n_stale = i - n_files;
+			break;
+		}
+
+		ut_free(name);
+	}
+
+	buf_dblwr->n_files = 0;
+	buf_dblwr->n_stale = 0;
+	buf_dblwr->files = NULL;
+
+	const ulint	n = n_files + n_stale;
+
+	if (n == 0) {
+		return;
+	}
+
+	buf_dblwr->files = static_cast<buf_dblwr_batch_t*>(
+		ut_zalloc_nokey(n * sizeof *buf_dblwr->files));
+
+	ulint	opened = 0;
+
+	for (ulint i = 0; i < n; i++) {
+		buf_dblwr_batch_t*	batch = &buf_dblwr->files[opened];
+
+		buf_dblwr_batch_init(batch, NULL, NULL);
+		batch->name = buf_dblwr_file_name(i);
+
+		if (buf_dblwr_file_open(batch, i < n_files)) {
+			opened++;
+			continue;
+		}
+
+		ib::warn() << "Cannot open the doublewrite file "
+			<< batch->name;
+
+		buf_dblwr_batch_free(batch);
+
+		if (i < n_files) {
+			/* Use fewer files, or the doublewrite buffer
+			in the system tablespace. */
+			n_files = i;
+		}
+	}
+
+	buf_dblwr->n_files = n_files;
+	buf_dblwr->n_stale = opened - n_files;
+
+	if (opened == 0) {
+		ut_free(buf_dblwr->files);
+		buf_dblwr->files = NULL;
+	}
+}
+
+/** Close and delete the doublewrite files that were left by a larger
+innodb_doublewrite_files, after crash recovery no longer needs them. */
+static
+void
+buf_dblwr_files_discard_stale()
+{
+	for (ulint i = buf_dblwr->n_files;
+	     i < buf_dblwr->n_files + buf_dblwr->n_stale; i++) {
+		buf_dblwr_batch_t*	batch = &buf_dblwr->files[i];
+
+		os_file_close(batch->file);
+		batch->file = OS_FILE_CLOSED;
+
+		if (!srv_read_only_mode) {
+			os_file_delete_if_exists(
+				innodb_data_file_key, batch->name, NULL);
+		}
+
+		buf_dblwr_batch_free(batch);
+	}
+
+	buf_dblwr->n_stale = 0;
+}
+
 /****************************************************************//**
 Creates or initialializes the doublewrite buffer at a database start. */
 static
@@ -134,11 +371,8 @@ buf_dblwr_init(
 
 	mutex_create(LATCH_ID_BUF_DBLWR, &buf_dblwr->mutex);
 
-	buf_dblwr->b_event = os_event_create("dblwr_batch_event");
 	buf_dblwr->s_event = os_event_create("dblwr_single_event");
-	buf_dblwr->first_free = 0;
 	buf_dblwr->s_reserved = 0;
-	buf_dblwr->b_reserved = 0;
 
 	buf_dblwr->block1 = mach_read_from_4(
 		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK1);
@@ -157,6 +391,13 @@ buf_dblwr_init(
 
 	buf_dblwr->buf_block_arr = static_cast<buf_page_t**>(
 		ut_zalloc_nokey(buf_size * sizeof(void*)));
+
+	/* The batch area shares the memory with the single page
+	flush slots, which start at srv_doublewrite_batch_size. */
+	buf_dblwr_batch_init(&buf_dblwr->batch, buf_dblwr->write_buf,
+			     buf_dblwr->buf_block_arr);
+
+	buf_dblwr_files_init();
 }
 
 /** Create the doublewrite buffer if the doublewrite buffer header
@@ -177,7 +418,9 @@ buf_dblwr_create()
 	mtr_t	mtr;
 
 	if (buf_dblwr) {
-		/* Already inited */
+		/* Already inited. Crash recovery has been completed,
+		and the stale doublewrite files are no longer needed. */
+		buf_dblwr_files_discard_stale();
 		return(true);
 	}
 
@@ -193,6 +436,7 @@ buf_dblwr_create()
 		just read in some numbers */
 
 		buf_dblwr_init(doublewrite);
+		buf_dblwr_files_discard_stale();
 
 		mtr.commit();
 		buf_dblwr_being_created = FALSE;
@@ -335,6 +579,58 @@ buf_dblwr_create()
 	goto start_again;
 }
 
+/** Read the pages from the doublewrite files for crash recovery.
+@param[in,out]	recv_dblwr	doublewrite recovery buffer
+@return DB_SUCCESS or error code */
+static
+dberr_t
+buf_dblwr_files_load(recv_dblwr_t& recv_dblwr)
+{
+	for (ulint i = 0; i < buf_dblwr->n_files + buf_dblwr->n_stale; i++) {
+		const buf_dblwr_batch_t*	batch = &buf_dblwr->files[i];
+		os_offset_t			size = os_file_get_size(
+			batch->file);
+
+		if (size == os_offset_t(-1)) {
+			return(DB_IO_ERROR);
+		}
+
+		/* A stale file may have been created with a different
+		innodb_doublewrite_batch_size. */
+		ulint	n_pages = ulint(ut_min(
+			size >> UNIV_PAGE_SIZE_SHIFT,
+			os_offset_t(srv_doublewrite_batch_size)));
+
+		if (n_pages == 0) {
+			continue;
+		}
+
+		dberr_t	err = os_file_read(
+			IORequestRead, batch->file, batch->write_buf, 0,
+			n_pages * UNIV_PAGE_SIZE);
+
+		if (err != DB_SUCCESS) {
+			ib::error() << "Failed to read the doublewrite file "
+				<< batch->name;
+			return(err);
+		}
+
+		byte*	page = batch->write_buf;
+
+		for (ulint j = 0; j < n_pages; j++) {
+			if (memcmp(field_ref_zero, page + FIL_PAGE_LSN, 8)) {
+				/* Each valid page header must contain
+				a nonzero FIL_PAGE_LSN field. */
+				recv_dblwr.add(page);
+			}
+
+			page += univ_page_size.physical();
+		}
+	}
+
+	return(DB_SUCCESS);
+}
+
 /**
 At database startup initializes the doublewrite buffer memory structure if
 we already have a doublewrite buffer created in the data files. If we are
@@ -512,7 +808,7 @@ buf_dblwr_init_or_load_pages(
 
 	ut_free(unaligned_read_buf);
 
-	return(DB_SUCCESS);
+	return(buf_dblwr_files_load(recv_dblwr));
 }
 
 /** Process and remove the double write buffer pages for all tablespaces. */
@@ -691,9 +987,16 @@ buf_dblwr_free()
 	/* Free the double write data structures. */
 	ut_a(buf_dblwr != NULL);
 	ut_ad(buf_dblwr->s_reserved == 0);
-	ut_ad(buf_dblwr->b_reserved == 0);
 
-	os_event_destroy(buf_dblwr->b_event);
+	buf_dblwr_batch_free(&buf_dblwr->batch);
+
+	for (ulint i = 0; i < buf_dblwr->n_files + buf_dblwr->n_stale; i++) {
+		buf_dblwr_batch_free(&buf_dblwr->files[i]);
+	}
+
+	ut_free(buf_dblwr->files);
+	buf_dblwr->files = NULL;
+
 	os_event_destroy(buf_dblwr->s_event);
 	ut_free(buf_dblwr->write_buf_unaligned);
 	buf_dblwr->write_buf_unaligned = NULL;
@@ -709,6 +1012,18 @@ buf_dblwr_free()
 	buf_dblwr = NULL;
 }
 
+/** Get the doublewrite batch area of a buffer pool instance.
+@param[in]	instance	buffer pool instance number
+@return	batch area */
+static inline
+buf_dblwr_batch_t*
+buf_dblwr_get_batch(ulint instance)
+{
+	return(buf_dblwr->n_files
+	       ? &buf_dblwr->files[instance % buf_dblwr->n_files]
+	       : &buf_dblwr->batch);
+}
+
 /********************************************************************//**
 Updates the doublewrite buffer when an IO request is completed. */
 void
@@ -725,28 +1040,34 @@ buf_dblwr_update(
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
-		mutex_enter(&buf_dblwr->mutex);
+		{
+			buf_dblwr_batch_t*	batch
+				= buf_dblwr_get_batch(bpage->buf_pool_index);
 
-		ut_ad(buf_dblwr->batch_running);
-		ut_ad(buf_dblwr->b_reserved > 0);
-		ut_ad(buf_dblwr->b_reserved <= buf_dblwr->first_free);
+			mutex_enter(&batch->mutex);
 
-		buf_dblwr->b_reserved--;
+			ut_ad(batch->batch_running);
+			ut_ad(batch->b_reserved > 0);
+			ut_ad(batch->b_reserved <= batch->first_free);
 
-		if (buf_dblwr->b_reserved == 0) {
-			mutex_exit(&buf_dblwr->mutex);
-			/* This will finish the batch. Sync data files
-			to the disk. */
-			fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-			mutex_enter(&buf_dblwr->mutex);
+			batch->b_reserved--;
 
-			/* We can now reuse the doublewrite memory buffer: */
-			buf_dblwr->first_free = 0;
-			buf_dblwr->batch_running = false;
-			os_event_set(buf_dblwr->b_event);
-		}
+			if (batch->b_reserved == 0) {
+				mutex_exit(&batch->mutex);
+				/* This will finish the batch. Sync data
+				files to the disk. */
+				fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+				mutex_enter(&batch->mutex);
 
-		mutex_exit(&buf_dblwr->mutex);
+				/* We can now reuse the doublewrite
+				memory buffer: */
+				batch->first_free = 0;
+				batch->batch_running = false;
+				os_event_set(batch->b_event);
+			}
+
+			mutex_exit(&batch->mutex);
+		}
 		break;
 	case BUF_FLUSH_SINGLE_PAGE:
 		{
@@ -931,39 +1252,27 @@ buf_dblwr_write_block_to_datafile(
 	}
 }
 
-/********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+/** Write the posted pages of a doublewrite batch area to the doublewrite
+buffer on disk, sync it, and post the writes to the data files.
+@param[in,out]	batch	doublewrite batch area */
+static
 void
-buf_dblwr_flush_buffered_writes()
+buf_dblwr_flush_batch(buf_dblwr_batch_t* batch)
 {
 	byte*		write_buf;
 	ulint		first_free;
 	ulint		len;
 
-	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
-		/* Sync the writes to the disk. */
-		buf_dblwr_sync_datafiles();
-		/* Now we flush the data to disk (for example, with fsync) */
-		fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-		return;
-	}
-
-	ut_ad(!srv_read_only_mode);
-
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&batch->mutex);
 
 	/* Write first to doublewrite buffer blocks. We use synchronous
 	aio and thus know that file write has been completed when the
 	control returns. */
 
-	if (buf_dblwr->first_free == 0) {
+	if (batch->first_free == 0) {
 
-		mutex_exit(&buf_dblwr->mutex);
+		mutex_exit(&batch->mutex);
 
 		/* Wake possible simulated aio thread as there could be
 		system temporary tablespace pages active for flushing.
@@ -974,38 +1283,38 @@ buf_dblwr_flush_buffered_writes()
 		return;
 	}
 
-	if (buf_dblwr->batch_running) {
+	if (batch->batch_running) {
 		/* Another thread is running the batch right now. Wait
 		for it to finish. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		int64_t	sig_count = os_event_reset(batch->b_event);
+		mutex_exit(&batch->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(batch->b_event, sig_count);
 		goto try_again;
 	}
 
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
+	ut_ad(batch->first_free == batch->b_reserved);
 
 	/* Disallow anyone else to post to doublewrite buffer or to
 	start another batch of flushing. */
-	buf_dblwr->batch_running = true;
-	first_free = buf_dblwr->first_free;
+	batch->batch_running = true;
+	first_free = batch->first_free;
 
 	/* Now safe to release the mutex. Note that though no other
 	thread is allowed to post to the doublewrite batch flushing
 	but any threads working on single page flushes are allowed
 	to proceed. */
-	mutex_exit(&buf_dblwr->mutex);
+	mutex_exit(&batch->mutex);
 
-	write_buf = buf_dblwr->write_buf;
+	write_buf = batch->write_buf;
 
 	for (ulint len2 = 0, i = 0;
-	     i < buf_dblwr->first_free;
+	     i < batch->first_free;
 	     len2 += UNIV_PAGE_SIZE, i++) {
 
 		const buf_block_t*	block;
 
-		block = (buf_block_t*) buf_dblwr->buf_block_arr[i];
+		block = (buf_block_t*) batch->buf_block_arr[i];
 
 		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
 		    || block->page.zip.data) {
@@ -1023,24 +1332,45 @@ buf_dblwr_flush_buffered_writes()
 		buf_dblwr_check_page_lsn(write_buf + len2);
 	}
 
+	if (batch->file != OS_FILE_CLOSED) {
+		/* Write the whole batch to the doublewrite file and
+		flush it. Other doublewrite files may be written
+		concurrently by other page cleaner threads. */
+		dberr_t	err = os_file_write(
+			IORequestWrite, batch->name, batch->file, write_buf,
+			0, first_free * UNIV_PAGE_SIZE);
+
+		if (err != DB_SUCCESS) {
+			ib::fatal() << "Failed to write to the doublewrite"
+				" file " << batch->name << ": "
+				<< ut_strerr(err);
+		}
+
+		srv_stats.dblwr_pages_written.add(first_free);
+		srv_stats.dblwr_writes.inc();
+
+		os_file_flush(batch->file);
+		goto write_datafiles;
+	}
+
 	/* Write out the first block of the doublewrite buffer */
 	len = ut_min(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
-		     buf_dblwr->first_free) * UNIV_PAGE_SIZE;
+		     batch->first_free) * UNIV_PAGE_SIZE;
 
 	fil_io(IORequestWrite, true,
 	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block1), univ_page_size,
 	       0, len, (void*) write_buf, NULL);
 
-	if (buf_dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+	if (batch->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
 		/* No unwritten pages in the second block. */
 		goto flush;
 	}
 
 	/* Write out the second block of the doublewrite buffer. */
-	len = (buf_dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
+	len = (batch->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
 	       * UNIV_PAGE_SIZE;
 
-	write_buf = buf_dblwr->write_buf
+	write_buf = batch->write_buf
 		    + TRX_SYS_DOUBLEWRITE_BLOCK_SIZE * UNIV_PAGE_SIZE;
 
 	fil_io(IORequestWrite, true,
@@ -1049,31 +1379,32 @@ buf_dblwr_flush_buffered_writes()
 
 flush:
 	/* increment the doublewrite flushed pages counter */
-	srv_stats.dblwr_pages_written.add(buf_dblwr->first_free);
+	srv_stats.dblwr_pages_written.add(batch->first_free);
 	srv_stats.dblwr_writes.inc();
 
 	/* Now flush the doublewrite buffer data to disk */
 	fil_flush(TRX_SYS_SPACE);
 
+write_datafiles:
 	/* We know that the writes have been flushed to disk now
 	and in recovery we will find them in the doublewrite buffer
 	blocks. Next do the writes to the intended positions. */
 
-	/* Up to this point first_free and buf_dblwr->first_free are
-	same because we have set the buf_dblwr->batch_running flag
+	/* Up to this point first_free and batch->first_free are
+	same because we have set the batch->batch_running flag
 	disallowing any other thread to post any request but we
-	can't safely access buf_dblwr->first_free in the loop below.
+	can't safely access batch->first_free in the loop below.
 	This is so because it is possible that after we are done with
 	the last iteration and before we terminate the loop, the batch
 	gets finished in the IO helper thread and another thread posts
-	a new batch setting buf_dblwr->first_free to a higher value.
-	If this happens and we are using buf_dblwr->first_free in the
+	a new batch setting batch->first_free to a higher value.
+	If this happens and we are using batch->first_free in the
 	loop termination condition then we'll end up dispatching
 	the same block twice from two different threads. */
-	ut_ad(first_free == buf_dblwr->first_free);
+	ut_ad(first_free == batch->first_free);
 	for (ulint i = 0; i < first_free; i++) {
 		buf_dblwr_write_block_to_datafile(
-			buf_dblwr->buf_block_arr[i], false);
+			batch->buf_block_arr[i], false);
 	}
 
 	/* Wake possible simulated aio thread to actually post the
@@ -1083,6 +1414,53 @@ buf_dblwr_flush_buffered_writes()
 	os_aio_simulated_wake_handler_threads();
 }
 
+/********************************************************************//**
+Flushes possible buffered writes from the doublewrite memory buffer to disk,
+and also wakes up the aio thread if simulated aio is used. It is very
+important to call this function after a batch of writes has been posted,
+and also when we may have to wait for a page latch! Otherwise a deadlock
+of threads can occur. */
+void
+buf_dblwr_flush_buffered_writes()
+{
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
+		/* Sync the writes to the disk. */
+		buf_dblwr_sync_datafiles();
+		/* Now we flush the data to disk (for example, with fsync) */
+		fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+		return;
+	}
+
+	ut_ad(!srv_read_only_mode);
+
+	if (!buf_dblwr->n_files) {
+		buf_dblwr_flush_batch(&buf_dblwr->batch);
+		return;
+	}
+
+	for (ulint i = 0; i < buf_dblwr->n_files; i++) {
+		buf_dblwr_flush_batch(&buf_dblwr->files[i]);
+	}
+}
+
+/** Flush possible buffered writes of the doublewrite area that serves
+a buffer pool instance. This is like buf_dblwr_flush_buffered_writes(),
+but it does not wait for batches of other buffer pool instances that
+are written to other innodb_doublewrite_files.
+@param[in]	buf_pool	buffer pool instance */
+void
+buf_dblwr_flush_buffered_writes(const buf_pool_t* buf_pool)
+{
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
+		buf_dblwr_flush_buffered_writes();
+		return;
+	}
+
+	ut_ad(!srv_read_only_mode);
+
+	buf_dblwr_flush_batch(buf_dblwr_get_batch(buf_pool->instance_no));
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -1094,12 +1472,15 @@ buf_dblwr_add_to_batch(
 {
 	ut_a(buf_page_in_file(bpage));
 
+	buf_dblwr_batch_t*	batch = buf_dblwr_get_batch(
+		bpage->buf_pool_index);
+
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&batch->mutex);
 
-	ut_a(buf_dblwr->first_free <= srv_doublewrite_batch_size);
+	ut_a(batch->first_free <= srv_doublewrite_batch_size);
 
-	if (buf_dblwr->batch_running) {
+	if (batch->batch_running) {
 
 		/* This not nearly as bad as it looks. There is only
 		page_cleaner thread which does background flushing
@@ -1107,23 +1488,23 @@ buf_dblwr_add_to_batch(
 		point. The only exception is when a user thread is
 		forced to do a flush batch because of a sync
 		checkpoint. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		int64_t	sig_count = os_event_reset(batch->b_event);
+		mutex_exit(&batch->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(batch->b_event, sig_count);
 		goto try_again;
 	}
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (batch->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&batch->mutex);
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_batch(batch);
 
 		goto try_again;
 	}
 
-	byte*	p = buf_dblwr->write_buf
-		+ univ_page_size.physical() * buf_dblwr->first_free;
+	byte*	p = batch->write_buf
+		+ univ_page_size.physical() * batch->first_free;
 
 	/* We request frame here to get correct buffer in case of
 	encryption and/or page compression */
@@ -1146,24 +1527,24 @@ buf_dblwr_add_to_batch(
 		memcpy(p, frame, bpage->size.logical());
 	}
 
-	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
+	batch->buf_block_arr[batch->first_free] = bpage;
 
-	buf_dblwr->first_free++;
-	buf_dblwr->b_reserved++;
+	batch->first_free++;
+	batch->b_reserved++;
 
-	ut_ad(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-	ut_ad(buf_dblwr->b_reserved <= srv_doublewrite_batch_size);
+	ut_ad(!batch->batch_running);
+	ut_ad(batch->first_free == batch->b_reserved);
+	ut_ad(batch->b_reserved <= srv_doublewrite_batch_size);
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (batch->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&batch->mutex);
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_batch(batch);
 
 		return;
 	}
 
-	mutex_exit(&(buf_dblwr->mutex));
+	mutex_exit(&batch->mutex);
 }
 
 /********************************************************************//**
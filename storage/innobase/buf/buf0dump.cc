@@ -451,10 +451,12 @@ buf_load_throttle_if_needed(
 					throttling is needed, we do the check
 					every srv_io_capacity IO ops. */
 	ulint*	last_activity_count,
-	ulint	n_io)			/*!< in: number of IO ops done since
+	ulint	n_io,			/*!< in: number of IO ops done since
 					buffer pool load has started */
+	ulint	io_capacity)		/*!< in: IO ops per second allowed
+					for this thread when throttled */
 {
-	if (n_io % srv_io_capacity < srv_io_capacity - 1) {
+	if (n_io % io_capacity < io_capacity - 1) {
 		return;
 	}
 
@@ -464,7 +466,7 @@ buf_load_throttle_if_needed(
 		return;
 	}
 
-	/* srv_io_capacity IO operations have been performed by buffer pool
+	/* io_capacity IO operations have been performed by buffer pool
 	load since the last time we were here. */
 
 	/* If no other activity, then keep going without any delay. */
@@ -504,6 +506,149 @@ buf_load_throttle_if_needed(
 	*last_activity_count = srv_get_activity_count();
 }
 
+/** Number of consecutive entries of the sorted dump that a buffer pool
+load thread claims at a time. The reads of a batch are posted back to
+back, so that reads of adjacent pages can be merged by the I/O layer. */
+static const ulint	BUF_LOAD_BATCH = 64;
+
+/** A buffer pool load, shared by the threads that read the pages */
+struct buf_load_t {
+	/** the pages to load, sorted by (space, page) */
+	const buf_dump_t*	dump;
+	/** number of elements in dump */
+	ulint			dump_n;
+	/** first element of dump that has not been claimed by a thread */
+	ulint			next;
+	/** number of elements of dump that have been processed */
+	ulint			n_done;
+	/** number of threads reading the pages */
+	ulint			n_threads;
+};
+
+/** Read pages of a buffer pool load, claiming batches of consecutive
+elements of the sorted dump until all of them have been claimed, or the
+load is aborted or the server is being shut down.
+@param[in,out]	load	buffer pool load */
+static
+void
+buf_load_pages(buf_load_t* load)
+{
+	ulint		last_check_time = 0;
+	ulint		last_activity_cnt = 0;
+	ulint		n_io = 0;
+	/* Each thread gets its share of innodb_io_capacity when the load
+	is throttled due to other activity. */
+	const ulint	io_capacity = ut_max(
+		ulint(srv_io_capacity / load->n_threads), ulint(1));
+
+	/* Avoid calling the expensive fil_space_acquire_silent() for each
+	page within the same tablespace. dump[] is sorted by (space, page),
+	so all pages from a given tablespace are consecutive. */
+	ulint		cur_space_id = ULINT_UNDEFINED;
+	fil_space_t*	space = NULL;
+	page_size_t	page_size(0);
+
+	for (;;) {
+		const ulint	begin = my_atomic_addlint(
+			&load->next, BUF_LOAD_BATCH);
+
+		if (begin >= load->dump_n) {
+			break;
+		}
+
+		const ulint	end = ut_min(begin + BUF_LOAD_BATCH,
+					     load->dump_n);
+
+		for (ulint i = begin; i < end; i++) {
+			if (SHUTTING_DOWN() || buf_load_abort_flag) {
+				goto func_exit;
+			}
+
+			ulint	n_done = my_atomic_addlint(
+				&load->n_done, 1) + 1;
+#ifdef UNIV_DEBUG
+			if (n_done >= srv_buf_pool_load_pages_abort) {
+				buf_load_abort_flag = TRUE;
+			}
+#else
+			(void) n_done;
+#endif
+
+			/* space_id for this iteration of the loop */
+			const ulint	this_space_id = BUF_DUMP_SPACE(
+				load->dump[i]);
+
+			if (this_space_id >= SRV_LOG_SPACE_FIRST_ID) {
+				/* Ignore the innodb_temporary tablespace. */
+				continue;
+			}
+
+			if (this_space_id != cur_space_id) {
+				if (space != NULL) {
+					fil_space_release(space);
+				}
+
+				cur_space_id = this_space_id;
+				space = fil_space_acquire_silent(cur_space_id);
+
+				if (space != NULL) {
+					const page_size_t	cur_page_size(
+						space->flags);
+					page_size.copy_from(cur_page_size);
+				}
+			}
+
+			/* JAN: TODO: As we use background page read below,
+			if tablespace is encrypted we cant use it. */
+			if (space == NULL ||
+			   (space && space->crypt_data &&
+			    space->crypt_data->encryption
+			    != FIL_ENCRYPTION_OFF &&
+			    space->crypt_data->type
+			    != CRYPT_SCHEME_UNENCRYPTED)) {
+				continue;
+			}
+
+			buf_read_page_background(
+				page_id_t(this_space_id,
+					  BUF_DUMP_PAGE(load->dump[i])),
+				page_size, true);
+
+			buf_load_throttle_if_needed(
+				&last_check_time, &last_activity_cnt, n_io++,
+				io_capacity);
+		}
+
+		/* Post the reads of the batch to the operating system. */
+		os_aio_simulated_wake_handler_threads();
+	}
+
+func_exit:
+	if (space != NULL) {
+		fil_space_release(space);
+	}
+
+	os_aio_simulated_wake_handler_threads();
+}
+
+/** Thread for reading pages of a buffer pool load.
+@param[in,out]	arg	buf_load_t
+@return OS_THREAD_DUMMY_RETURN */
+static
+os_thread_ret_t
+DECLARE_THREAD(buf_load_thread)(void* arg)
+{
+	my_thread_init();
+
+	buf_load_pages(static_cast<buf_load_t*>(arg));
+
+	my_thread_end();
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -657,16 +802,6 @@ buf_load()
 		std::sort(dump, dump + dump_n);
 	}
 
-	ulint		last_check_time = 0;
-	ulint		last_activity_cnt = 0;
-
-	/* Avoid calling the expensive fil_space_acquire_silent() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	ulint		cur_space_id = BUF_DUMP_SPACE(dump[0]);
-	fil_space_t*	space = fil_space_acquire_silent(cur_space_id);
-	page_size_t	page_size(space ? space->flags : 0);
-
 	/* JAN: TODO: MySQL 5.7 PSI
 #ifdef HAVE_PSI_STAGE_INTERFACE
 	PSI_stage_progress*	pfs_stage_progress
@@ -677,82 +812,50 @@ buf_load()
 	mysql_stage_set_work_completed(pfs_stage_progress, 0);
 	*/
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+	const ulint	n_threads = ut_min(
+		ulint(srv_buf_pool_load_threads),
+		(dump_n + BUF_LOAD_BATCH - 1) / BUF_LOAD_BATCH);
+	buf_load_t	load = { dump, dump_n, 0, 0, n_threads };
+	os_thread_t*	threads = NULL;
 
-		/* space_id for this iteration of the loop */
-		const ulint	this_space_id = BUF_DUMP_SPACE(dump[i]);
+	if (n_threads > 1) {
+		threads = static_cast<os_thread_t*>(
+			ut_malloc_nokey((n_threads - 1) * sizeof *threads));
 
-		if (this_space_id >= SRV_LOG_SPACE_FIRST_ID) {
-			/* Ignore the innodb_temporary tablespace. */
-			continue;
+		for (ulint t = 0; t + 1 < n_threads; t++) {
+			threads[t] = os_thread_create(
+				buf_load_thread, &load, NULL);
 		}
+	}
 
-		if (this_space_id != cur_space_id) {
-			if (space != NULL) {
-				fil_space_release(space);
-			}
-
-			cur_space_id = this_space_id;
-			space = fil_space_acquire_silent(cur_space_id);
+	buf_load_pages(&load);
 
-			if (space != NULL) {
-				const page_size_t	cur_page_size(
-					space->flags);
-				page_size.copy_from(cur_page_size);
-			}
+	if (threads) {
+		for (ulint t = 0; t + 1 < n_threads; t++) {
+			os_thread_join(threads[t]);
 		}
 
-		/* JAN: TODO: As we use background page read below,
-		if tablespace is encrypted we cant use it. */
-		if (space == NULL ||
-		   (space && space->crypt_data &&
-		    space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
-		    space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
-			continue;
-		}
+		ut_free(threads);
+	}
 
-		buf_read_page_background(
-			page_id_t(this_space_id, BUF_DUMP_PAGE(dump[i])),
-			page_size, true);
+	i = my_atomic_loadlint(&load.n_done);
 
-		if (i % 64 == 63) {
-			os_aio_simulated_wake_handler_threads();
-		}
-
-		if (buf_load_abort_flag) {
-			if (space != NULL) {
-				fil_space_release(space);
-			}
-			buf_load_abort_flag = FALSE;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_INFO,
-				"Buffer pool(s) load aborted on request");
-			/* Premature end, set estimated = completed = i and
-			end the current stage event. */
-			/*
-			mysql_stage_set_work_estimated(pfs_stage_progress, i);
-			mysql_stage_set_work_completed(pfs_stage_progress,
-			i);
-			*/
+	if (i < dump_n && buf_load_abort_flag) {
+		buf_load_abort_flag = FALSE;
+		ut_free(dump);
+		buf_load_status(
+			STATUS_INFO,
+			"Buffer pool(s) load aborted on request");
+		/* Premature end, set estimated = completed = i and
+		end the current stage event. */
+		/*
+		mysql_stage_set_work_estimated(pfs_stage_progress, i);
+		mysql_stage_set_work_completed(pfs_stage_progress, i);
+		*/
 #ifdef HAVE_PSI_STAGE_INTERFACE
-			/* mysql_end_stage(); */
+		/* mysql_end_stage(); */
 #endif /* HAVE_PSI_STAGE_INTERFACE */
-			return;
-		}
-
-		buf_load_throttle_if_needed(
-			&last_check_time, &last_activity_cnt, i);
-
-#ifdef UNIV_DEBUG
-		if ((i+1) >= srv_buf_pool_load_pages_abort) {
-			buf_load_abort_flag = 1;
-		}
-#endif
-	}
-
-	if (space != NULL) {
-		fil_space_release(space);
+		return;
 	}
 
 	ut_free(dump);
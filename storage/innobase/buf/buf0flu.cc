@@ -72,6 +72,10 @@ need to protect it by a mutex. It is only ever read by the thread
 doing the shutdown */
 bool buf_page_cleaner_is_active;
 
+/** Number of buf_lru_manager_thread that are running. Incremented by
+buf_lru_manager_start() and decremented by each thread when it exits. */
+ulint buf_lru_manager_n_active;
+
 /** Factor for scan length to determine n_pages for intended oldest LSN
 progress */
 static ulint buf_flush_lsn_scan_factor = 3;
@@ -84,6 +88,7 @@ static lsn_t buf_flush_sync_lsn = 0;
 
 #ifdef UNIV_PFS_THREAD
 mysql_pfs_key_t page_cleaner_thread_key;
+mysql_pfs_key_t buf_lru_manager_thread_key;
 #endif /* UNIV_PFS_THREAD */
 
 /** Event to synchronise with the flushing. */
@@ -445,6 +450,7 @@ buf_flush_insert_into_flush_list(
 
 	ut_d(block->page.in_flush_list = TRUE);
 	block->page.oldest_modification = lsn;
+	buf_index_stat_dirty(&block->page, true);
 
 	UT_LIST_ADD_FIRST(buf_pool->flush_list, &block->page);
 
@@ -510,6 +516,7 @@ buf_flush_insert_sorted_into_flush_list(
 	ut_ad(!block->page.in_flush_list);
 	ut_d(block->page.in_flush_list = TRUE);
 	block->page.oldest_modification = lsn;
+	buf_index_stat_dirty(&block->page, true);
 
 #ifdef UNIV_DEBUG_VALGRIND
 	void*	p;
@@ -685,6 +692,7 @@ buf_flush_remove(
 
 	buf_pool->stat.flush_list_bytes -= bpage->size.physical();
 
+	buf_index_stat_dirty(bpage, false);
 	bpage->oldest_modification = 0;
 
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
@@ -1218,7 +1226,7 @@ buf_flush_page(
 				/* avoiding deadlock possibility involves
 				doublewrite buffer, should flush it, because
 				it might hold the another block->lock. */
-				buf_dblwr_flush_buffered_writes();
+				buf_dblwr_flush_buffered_writes(buf_pool);
 			} else {
 				buf_dblwr_sync_datafiles();
 			}
@@ -1959,7 +1967,7 @@ buf_flush_end(
 	buf_pool_mutex_exit(buf_pool);
 
 	if (!srv_read_only_mode) {
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool);
 	} else {
 		os_aio_simulated_wake_handler_threads();
 	}
@@ -2284,8 +2292,9 @@ buf_flush_LRU_list(
 		scan_depth = ut_min(static_cast<ulint>(srv_LRU_scan_depth),
 				    scan_depth);
 	}
-	/* Currently one of page_cleaners is the only thread
-	that can trigger an LRU flush at the same time.
+	/* Either one of page_cleaners or buf_lru_manager_thread
+	of this instance is the only thread that can trigger
+	an LRU flush at the same time.
 	So, it is not possible that a batch triggered during
 	last iteration is still running, */
 	buf_flush_do_batch(buf_pool, BUF_FLUSH_LRU, scan_depth,
@@ -2808,8 +2817,10 @@ pc_flush_slot(void)
 
 		lru_tm = ut_time_ms();
 
-		/* Flush pages from end of LRU if required */
-		slot->n_flushed_lru = buf_flush_LRU_list(buf_pool);
+		/* Flush pages from end of LRU if required, unless
+		buf_lru_manager_thread is taking care of that */
+		slot->n_flushed_lru = buf_pool->lru_manager_active
+			? 0 : buf_flush_LRU_list(buf_pool);
 
 		lru_tm = ut_time_ms() - lru_tm;
 		lru_pass++;
@@ -3531,6 +3542,127 @@ DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 	OS_THREAD_DUMMY_RETURN;
 }
 
+/** Adjust the sleep time of buf_lru_manager_thread to the length of
+the free list after an LRU batch.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	sleep_ms	current sleep time, in milliseconds
+@param[in]	n_flushed	number of pages flushed in the last batch
+@return the new sleep time, in milliseconds */
+static
+ulint
+buf_lru_manager_sleep_time(
+	const buf_pool_t*	buf_pool,
+	ulint			sleep_ms,
+	ulint			n_flushed)
+{
+	/* A dirty read is sufficient for this heuristic. */
+	const ulint	free_len = UT_LIST_GET_LEN(buf_pool->free);
+	const ulint	target = srv_LRU_scan_depth;
+
+	if (free_len < target / 100) {
+		/* The free list is nearly empty. Keep flushing
+		without sleeping for as long as it helps. */
+		return(n_flushed ? 0 : ut_min(sleep_ms + 50, ulint(1000)));
+	} else if (free_len >= target) {
+		/* Back off only when the free list is full. */
+		return(ut_min(sleep_ms + 50, ulint(1000)));
+	}
+
+	return(sleep_ms >= 50 ? sleep_ms - 50 : 0);
+}
+
+/** LRU manager thread of a buffer pool instance. It keeps the free list
+of the instance populated by flushing and evicting pages from the tail of
+the LRU list, so that neither the page cleaner threads nor the user threads
+in buf_LRU_get_free_block() have to do that. The sleep time between the
+batches is adapted to the length of the free list, and the thread is woken
+up early when a user thread runs out of free blocks.
+@param[in]	arg	buffer pool instance number
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(buf_lru_manager_thread)(void* arg)
+{
+	my_thread_init();
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_lru_manager_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	buf_pool_t*	buf_pool = buf_pool_from_array(
+		reinterpret_cast<ulint>(arg));
+	ulint		sleep_ms = 1000;
+	int64_t		sig_count = os_event_reset(
+		buf_pool->lru_manager_event);
+
+	while (srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+		if (sleep_ms) {
+			os_event_wait_time_low(buf_pool->lru_manager_event,
+					       sleep_ms * 1000, sig_count);
+		}
+
+		sig_count = os_event_reset(buf_pool->lru_manager_event);
+
+		if (srv_shutdown_state != SRV_SHUTDOWN_NONE) {
+			break;
+		}
+
+		ulint	n_flushed = buf_flush_LRU_list(buf_pool);
+
+		if (n_flushed) {
+			MONITOR_INC_VALUE_CUMULATIVE(
+				MONITOR_LRU_BATCH_FLUSH_TOTAL_PAGE,
+				MONITOR_LRU_BATCH_FLUSH_COUNT,
+				MONITOR_LRU_BATCH_FLUSH_PAGES,
+				n_flushed);
+		}
+
+		sleep_ms = buf_lru_manager_sleep_time(
+			buf_pool, sleep_ms, n_flushed);
+	}
+
+	buf_pool->lru_manager_active = false;
+	my_atomic_addlint(&buf_lru_manager_n_active, ulint(-1));
+
+	my_thread_end();
+	os_thread_exit();
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start one buf_lru_manager_thread for each buffer pool instance. */
+void
+buf_lru_manager_start()
+{
+	ut_ad(!srv_read_only_mode);
+	ut_ad(!buf_lru_manager_n_active);
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_pool_t*	buf_pool = buf_pool_from_array(i);
+
+		if (!buf_pool->lru_manager_event) {
+			buf_pool->lru_manager_event = os_event_create(
+				"lru_manager_event");
+		}
+
+		buf_pool->lru_manager_active = true;
+		my_atomic_addlint(&buf_lru_manager_n_active, 1);
+		os_thread_create(buf_lru_manager_thread,
+				 reinterpret_cast<void*>(i), NULL);
+	}
+}
+
+/** Wake up all buf_lru_manager_thread, for example at shutdown. */
+void
+buf_lru_manager_wake_all()
+{
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_pool_t*	buf_pool = buf_pool_from_array(i);
+
+		if (buf_pool->lru_manager_active) {
+			os_event_set(buf_pool->lru_manager_event);
+		}
+	}
+}
+
 /*******************************************************************//**
 Synchronously flush dirty blocks from the end of the flush list of all buffer
 pool instances.
@@ -1157,12 +1157,32 @@ buf_LRU_get_free_block(
 
 	/* If we have scanned the whole LRU and still are unable to
 	find a free block then we should sleep here to let the
-	page_cleaner do an LRU batch for us. */
+	page_cleaner or buf_lru_manager_thread do an LRU batch for us. */
 
 	if (!srv_read_only_mode) {
 		os_event_set(buf_flush_event);
 	}
 
+	if (buf_pool->lru_manager_active) {
+		/* Do not flush anything in the user thread. Wake up
+		the LRU manager of this instance and wait for its
+		batch to complete. */
+		os_event_set(buf_pool->lru_manager_event);
+
+		if (n_iterations > 1) {
+			MONITOR_INC( MONITOR_LRU_GET_FREE_WAITS );
+			os_thread_sleep(10000);
+		}
+
+		buf_flush_wait_batch_end(buf_pool, BUF_FLUSH_LRU);
+
+		srv_stats.buf_pool_wait_free.inc();
+
+		n_iterations++;
+
+		goto loop;
+	}
+
 	if (n_iterations > 1) {
 
 		MONITOR_INC( MONITOR_LRU_GET_FREE_WAITS );
@@ -1538,12 +1558,38 @@ buf_LRU_make_block_young(
 
 	if (bpage->old) {
 		buf_pool->stat.n_pages_made_young++;
+		buf_index_stat_made_young(bpage);
 	}
 
 	buf_LRU_remove_block(bpage);
 	buf_LRU_add_block_low(bpage, FALSE);
 }
 
+/** Make buf_block_hash_fix_lock_free() fail for a block that is about to
+be removed from buf_pool->page_hash, and wait for the calls that may be
+buffer-fixing it. After this, buf_fix_count is stable until the
+page_hash latch is released.
+@param[in,out]	buf_pool	buffer pool instance
+@param[in]	block		block in the state BUF_BLOCK_FILE_PAGE */
+static
+void
+buf_LRU_block_lock_free_wait(buf_pool_t* buf_pool, buf_block_t* block)
+{
+	ut_ad(buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE);
+	ut_ad(rw_lock_own(buf_page_hash_lock_get(buf_pool, block->page.id),
+			  RW_LOCK_X));
+
+	/* Change the version, keeping it even. Use a full memory
+	barrier, so that buf_block_hash_fix_lock_free() will either
+	see the change, or we will see its n_lock_free_pins. */
+	my_atomic_addlint(buf_page_hash_version(
+				  buf_pool, block->page.id.fold()), 2);
+
+	while (my_atomic_loadlint(&block->n_lock_free_pins)) {
+		ut_delay(1);
+	}
+}
+
 /******************************************************************//**
 Try to free a block.  If bpage is a descriptor of a compressed-only
 page, the descriptor object will be freed as well.
@@ -1576,6 +1622,14 @@ buf_LRU_free_page(
 	rw_lock_x_lock(hash_lock);
 	mutex_enter(block_mutex);
 
+	/* A lock-free lookup may be about to buffer-fix the block.
+	Do not disturb such lookups if the block cannot be freed anyway. */
+	if (buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE
+	    && buf_page_can_relocate(bpage)) {
+		buf_LRU_block_lock_free_wait(
+			buf_pool, reinterpret_cast<buf_block_t*>(bpage));
+	}
+
 	if (!buf_page_can_relocate(bpage)) {
 
 		/* Do not free buffer fixed and I/O-fixed blocks. */
@@ -1604,7 +1658,7 @@ buf_LRU_free_page(
 		return(false);
 
 	} else if (buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE) {
-		b = buf_page_alloc_descriptor();
+		b = buf_page_alloc_descriptor(buf_pool);
 		ut_a(b);
 		memcpy(b, bpage, sizeof *b);
 	}
@@ -1670,8 +1724,7 @@ buf_LRU_free_page(
 		ut_ad(b->in_page_hash);
 		ut_ad(b->in_LRU_list);
 
-		HASH_INSERT(buf_page_t, hash, buf_pool->page_hash,
-			    b->id.fold(), b);
+		buf_page_hash_insert(buf_pool, b->id.fold(), b);
 
 		/* Insert b where bpage was in the LRU list. */
 		if (prev_b != NULL) {
@@ -1990,6 +2043,14 @@ buf_LRU_block_remove_hashed(
 		break;
 	}
 
+	if (zip || !bpage->zip.data
+	    || buf_page_get_state(bpage) != BUF_BLOCK_FILE_PAGE) {
+		/* Unless buf_LRU_free_page() is preserving the
+		compressed page in a new descriptor, the page is
+		leaving the buffer pool. */
+		buf_index_stat_evict(bpage);
+	}
+
 	hashed_bpage = buf_page_hash_get_low(buf_pool, bpage->id);
 	if (bpage != hashed_bpage) {
 		ib::error() << "Page " << bpage->id
@@ -2037,8 +2098,7 @@ buf_LRU_block_remove_hashed(
 	ut_ad(bpage->in_page_hash);
 	ut_d(bpage->in_page_hash = FALSE);
 
-	HASH_DELETE(buf_page_t, hash, buf_pool->page_hash, bpage->id.fold(),
-		    bpage);
+	buf_page_hash_delete(buf_pool, bpage->id.fold(), bpage);
 
 	switch (buf_page_get_state(bpage)) {
 	case BUF_BLOCK_ZIP_PAGE:
@@ -2060,7 +2120,7 @@ buf_LRU_block_remove_hashed(
 			       bpage->size.physical());
 
 		buf_pool_mutex_exit_allow(buf_pool);
-		buf_page_free_descriptor(bpage);
+		buf_page_free_descriptor(buf_pool, bpage);
 		return(false);
 
 	case BUF_BLOCK_FILE_PAGE:
@@ -2174,6 +2234,11 @@ buf_LRU_free_one_page(
 	rw_lock_x_lock(hash_lock);
 	mutex_enter(block_mutex);
 
+	if (buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE) {
+		buf_LRU_block_lock_free_wait(
+			buf_pool, reinterpret_cast<buf_block_t*>(bpage));
+	}
+
 	if (buf_LRU_block_remove_hashed(bpage, true)) {
 		buf_LRU_block_free_hashed_page((buf_block_t*) bpage);
 	}
@@ -472,6 +472,78 @@ buf_read_page(
 	return(err);
 }
 
+/** Issue asynchronous read requests for the given pages of a tablespace
+that are not in the buffer pool, for example the clustered index leaf pages
+that a secondary index range scan is about to access.
+NOTE: the calling thread may own latches on pages: to avoid deadlocks this
+function must be written such that it cannot end up waiting for these
+latches!
+@param[in]	space_id	tablespace identifier
+@param[in]	page_size	page size
+@param[in]	page_nos	page numbers, in ascending order
+@param[in]	n		number of elements in page_nos
+@return number of page read requests issued */
+ulint
+buf_read_ahead_pages(
+	ulint			space_id,
+	const page_size_t&	page_size,
+	const ulint*		page_nos,
+	ulint			n)
+{
+	ulint	count = 0;
+	dberr_t	err;
+
+	if (srv_startup_is_before_trx_rollback_phase) {
+		/* No read-ahead to avoid thread deadlocks */
+		return(0);
+	}
+
+	for (ulint i = 0; i < n; i++) {
+		const page_id_t	page_id(space_id, page_nos[i]);
+		buf_pool_t*	buf_pool = buf_pool_get(page_id);
+
+		/* Dirty read of n_pend_reads, like in
+		buf_read_ahead_linear(). */
+		if (buf_pool->n_pend_reads
+		    > buf_pool->curr_size / BUF_READ_AHEAD_PEND_LIMIT) {
+			break;
+		}
+
+		if (!buf_read_page_low(
+			    &err, false,
+			    IORequest::DO_NOT_WAKE | IORequest::IGNORE_MISSING,
+			    BUF_READ_ANY_PAGE, page_id, page_size, false)) {
+			if (err == DB_TABLESPACE_DELETED) {
+				break;
+			}
+			continue;
+		}
+
+		buf_pool->stat.n_ra_pages_read++;
+		count++;
+	}
+
+	/* In simulated aio we wake the aio handler threads only after
+	queuing all aio requests, in native aio the following call does
+	nothing: */
+
+	os_aio_simulated_wake_handler_threads();
+
+	if (count) {
+		DBUG_PRINT("ib_buf", ("read-ahead of %u requested pages"
+				      " in space %u",
+				      (unsigned) count, (unsigned) space_id));
+
+		/* Read ahead is considered one I/O operation for the
+		purpose of LRU policy decision. */
+		buf_LRU_stat_inc_io();
+
+		srv_stats.buf_pool_reads.add(count);
+	}
+
+	return(count);
+}
+
 /** High-level function which reads a page asynchronously from a file to the
 buffer buf_pool if it is not already there. Sets the io_fix flag and sets
 an exclusive lock on the buffer frame. The flag is cleared and the x-lock
@@ -2364,6 +2364,57 @@ dict_index_too_big_for_tree(
 	return(FALSE);
 }
 
+/** Determine how many leading fields of an index can be compared
+byte by byte to a search key in page_cur_search_with_match().
+In ROW_FORMAT=COMPACT, DYNAMIC and COMPRESSED, the leading NOT NULL
+fixed-length fields are stored contiguously from the record origin,
+both in leaf page records and in node pointer records.
+@param[in]	index	index in the internal representation
+@return number of leading fields that compare like memcmp() */
+static
+unsigned
+dict_index_get_n_memcmp_fields(const dict_index_t* index)
+{
+	if (!dict_table_is_comp(index->table)
+	    || (index->type & (DICT_SPATIAL | DICT_FTS))) {
+		return(0);
+	}
+
+	const unsigned	n_uniq = unsigned(
+		dict_index_get_n_unique_in_tree(index));
+	unsigned	n;
+
+	for (n = 0; n < n_uniq; n++) {
+		const dict_field_t*	field = dict_index_get_nth_field(
+			index, n);
+		const dict_col_t*	col = field->col;
+
+		if (!field->fixed_len || field->prefix_len
+		    || col->is_nullable()) {
+			break;
+		}
+
+		switch (col->mtype) {
+		case DATA_INT:
+		case DATA_SYS:
+		case DATA_FIXBINARY:
+		case DATA_BINARY:
+			/* cmp_data() compares these with memcmp()
+			when the lengths are equal. */
+			continue;
+		case DATA_MYSQL:
+			if (dtype_get_charset_coll(col->prtype)
+			    == DATA_MYSQL_LATIN1_BIN_CHARSET_COLL) {
+				continue;
+			}
+		}
+
+		break;
+	}
+
+	return(n);
+}
+
 /** Adds an index to the dictionary cache, with possible indexing newly
 added column.
 @param[in]	index	index; NOTE! The index memory
@@ -2514,6 +2565,8 @@ dict_index_add_to_cache(
 		       SYNC_INDEX_TREE);
 
 	new_index->n_core_fields = new_index->n_fields;
+	new_index->n_memcmp_fields = dict_index_get_n_memcmp_fields(
+		new_index);
 
 	dict_mem_index_free(index);
 	if (err) *err = DB_SUCCESS;
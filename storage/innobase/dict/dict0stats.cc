@@ -127,9 +127,9 @@ where n=1..n_uniq.
 		: srv_stats_persistent_sample_pages)
 
 /* number of distinct records on a given level that are required to stop
-descending to lower levels and fetch N_SAMPLE_PAGES(index) records
-from that level */
-#define N_DIFF_REQUIRED(index)	(N_SAMPLE_PAGES(index) * 10)
+descending to lower levels and fetch n_sample_pages records from that
+level */
+#define N_DIFF_REQUIRED(n_sample_pages)	((n_sample_pages) * 10)
 
 /* A dynamic array where we store the boundaries of each distinct group
 of keys. For example if a btree level is:
@@ -138,6 +138,9 @@ data:  b,b,b,b,b,b,g,g,j,j,j, x, y
 then we would store 5,7,10,11,12 in the array. */
 typedef std::vector<ib_uint64_t, ut_allocator<ib_uint64_t> >	boundaries_t;
 
+/** A copy of dict_index_t::stat_n_diff_key_vals[] */
+typedef std::vector<ib_uint64_t, ut_allocator<ib_uint64_t> >	n_diff_vals_t;
+
 /** Allocator type used for index_map_t. */
 typedef ut_allocator<std::pair<const char* const, dict_index_t*> >
 	index_map_t_allocator;
@@ -1904,15 +1907,64 @@ dict_stats_index_set_n_diff(
 	}
 }
 
+/** Merge the estimates of an incremental recalculation into the previous
+ones. The previous stat_n_diff_key_vals[] are first scaled by the growth of
+the leaf level, like dict_stats_index_set_n_diff() would scale them, and
+then averaged with the new estimates, weighing the latter by the fraction
+of the table that was modified since the previous recalculation.
+@param[in]	prev_n_diff		previous stat_n_diff_key_vals[]
+@param[in]	prev_n_leaf_pages	previous stat_n_leaf_pages
+@param[in]	weight			weight of the new estimates
+@param[in,out]	index			index whose stat_n_diff_key_vals[]
+to update */
+static
+void
+dict_stats_index_merge_n_diff(
+	const n_diff_vals_t&	prev_n_diff,
+	ib_uint64_t		prev_n_leaf_pages,
+	double			weight,
+	dict_index_t*		index)
+{
+	ut_ad(weight > 0.0);
+	ut_ad(weight < 1.0);
+	ut_ad(prev_n_leaf_pages > 0);
+	ut_ad(prev_n_diff.size() == dict_index_get_n_unique(index));
+
+	const double	growth = double(index->stat_n_leaf_pages)
+		/ double(prev_n_leaf_pages);
+
+	for (ulint i = 0; i < prev_n_diff.size(); i++) {
+		const double	prev = double(prev_n_diff[i]) * growth;
+
+		index->stat_n_diff_key_vals[i] = static_cast<ib_uint64_t>(
+			prev * (1.0 - weight)
+			+ double(index->stat_n_diff_key_vals[i]) * weight);
+
+		DEBUG_PRINTF("    %s(): n_diff=" UINT64PF
+			     " for n_prefix=" ULINTPF
+			     " (previous " UINT64PF ", weight %f)\n",
+			     __func__, index->stat_n_diff_key_vals[i], i + 1,
+			     prev_n_diff[i], weight);
+	}
+}
+
 /*********************************************************************//**
 Calculates new statistics for a given index and saves them to the index
 members stat_n_diff_key_vals[], stat_n_sample_sizes[], stat_index_size and
-stat_n_leaf_pages. This function could be slow. */
+stat_n_leaf_pages. This function could be slow.
+
+If weight is less than 1, this is an incremental recalculation: fewer leaf
+pages are sampled, in proportion to weight, and the result is merged into
+the previous estimates by dict_stats_index_merge_n_diff(). A full scan of a
+small index is never merged, because it is exact. */
 static
 void
 dict_stats_analyze_index(
 /*=====================*/
-	dict_index_t*	index)	/*!< in/out: index to analyze */
+	dict_index_t*	index,	/*!< in/out: index to analyze */
+	double		weight = 1.0)
+				/*!< in: weight of the new estimates,
+				in (0,1] */
 {
 	ulint		root_level;
 	ulint		level;
@@ -1935,6 +1987,22 @@ dict_stats_analyze_index(
 
 	DEBUG_PRINTF("  %s(index=%s)\n", __func__, index->name());
 
+	/* The previous estimates, which an incremental recalculation merges
+	the new sample into. An index whose statistics have never been
+	calculated occupies a single leaf page according to them. */
+	n_diff_vals_t		prev_n_diff;
+	const ib_uint64_t	prev_n_leaf_pages = index->stat_n_leaf_pages;
+
+	ut_ad(weight > 0.0);
+	ut_ad(weight <= 1.0);
+
+	if (weight < 1.0 && prev_n_leaf_pages > 1) {
+		prev_n_diff.assign(
+			index->stat_n_diff_key_vals,
+			index->stat_n_diff_key_vals
+			+ dict_index_get_n_unique(index));
+	}
+
 	dict_stats_empty_index(index, false);
 
 	mtr_start(&mtr);
@@ -2011,6 +2079,12 @@ dict_stats_analyze_index(
 		DBUG_VOID_RETURN;
 	}
 
+	/* The number of leaf pages to sample for each n-column prefix;
+	between 1 and N_SAMPLE_PAGES(index) when merging */
+	const ib_uint64_t	n_sample_pages = prev_n_diff.empty()
+		? N_SAMPLE_PAGES(index)
+		: 1 + ib_uint64_t(double(N_SAMPLE_PAGES(index)) * weight);
+
 	/* For each level that is being scanned in the btree, this contains the
 	number of different key values for all possible n-column prefixes. */
 	ib_uint64_t*	n_diff_on_level = UT_NEW_ARRAY(
@@ -2047,7 +2121,7 @@ dict_stats_analyze_index(
 
 		DEBUG_PRINTF("  %s(): searching level with >=%llu "
 			     "distinct records, n_prefix=" ULINTPF "\n",
-			     __func__, N_DIFF_REQUIRED(index), n_prefix);
+			     __func__, N_DIFF_REQUIRED(n_sample_pages), n_prefix);
 
 		/* Commit the mtr to release the tree S lock to allow
 		other threads to do some work too. */
@@ -2071,7 +2145,8 @@ dict_stats_analyze_index(
 		distinct records because we do not want to scan the
 		leaf level because it may contain too many records */
 		if (level_is_analyzed
-		    && (n_diff_on_level[n_prefix - 1] >= N_DIFF_REQUIRED(index)
+		    && (n_diff_on_level[n_prefix - 1]
+			>= N_DIFF_REQUIRED(n_sample_pages)
 			|| level == 1)) {
 
 			goto found_level;
@@ -2084,7 +2159,7 @@ dict_stats_analyze_index(
 			/* if this does not hold we should be on
 			"found_level" instead of here */
 			ut_ad(n_diff_on_level[n_prefix - 1]
-			      < N_DIFF_REQUIRED(index));
+			      < N_DIFF_REQUIRED(n_sample_pages));
 
 			level--;
 			level_is_analyzed = false;
@@ -2109,13 +2184,13 @@ dict_stats_analyze_index(
 			total_recs is left from the previous iteration when
 			we scanned one level upper or we have not scanned any
 			levels yet in which case total_recs is 1. */
-			if (total_recs > N_SAMPLE_PAGES(index)) {
+			if (total_recs > n_sample_pages) {
 
 				/* if the above cond is true then we are
 				not at the root level since on the root
 				level total_recs == 1 (set before we
 				enter the n-prefix loop) and cannot
-				be > N_SAMPLE_PAGES(index) */
+				be > n_sample_pages */
 				ut_a(level != root_level);
 
 				/* step one level back and be satisfied with
@@ -2138,7 +2213,7 @@ dict_stats_analyze_index(
 
 			if (level == 1
 			    || n_diff_on_level[n_prefix - 1]
-			    >= N_DIFF_REQUIRED(index)) {
+			    >= N_DIFF_REQUIRED(n_sample_pages)) {
 				/* we have reached the last level we could scan
 				or we found a good level with many distinct
 				records */
@@ -2169,7 +2244,7 @@ dict_stats_analyze_index(
 		ut_ad(total_recs > 0);
 		ut_ad(n_diff_on_level[n_prefix - 1] > 0);
 
-		ut_ad(N_SAMPLE_PAGES(index) > 0);
+		ut_ad(n_sample_pages > 0);
 
 		n_diff_data_t*	data = &n_diff_data[n_prefix - 1];
 
@@ -2180,7 +2255,7 @@ dict_stats_analyze_index(
 		data->n_diff_on_level = n_diff_on_level[n_prefix - 1];
 
 		data->n_leaf_pages_to_analyze = std::min(
-			N_SAMPLE_PAGES(index),
+			n_sample_pages,
 			n_diff_on_level[n_prefix - 1]);
 
 		/* pick some records from this level and dive below them for
@@ -2201,6 +2276,11 @@ dict_stats_analyze_index(
 	due to tree being changed and so n_diff_data[] is set up. */
 	if (n_prefix == 0) {
 		dict_stats_index_set_n_diff(n_diff_data, index);
+
+		if (!prev_n_diff.empty()) {
+			dict_stats_index_merge_n_diff(
+				prev_n_diff, prev_n_leaf_pages, weight, index);
+		}
 	}
 
 	UT_DELETE_ARRAY(n_diff_data);
@@ -2218,7 +2298,9 @@ static
 dberr_t
 dict_stats_update_persistent(
 /*=========================*/
-	dict_table_t*	table)		/*!< in/out: table */
+	dict_table_t*	table,		/*!< in/out: table */
+	bool		incremental)	/*!< in: whether to merge a smaller
+					sample into the previous estimates */
 {
 	dict_index_t*	index;
 
@@ -2226,6 +2308,22 @@ dict_stats_update_persistent(
 
 	dict_table_stats_lock(table, RW_X_LATCH);
 
+	/* The weight of the new estimates. The automatic recalculation
+	is requested after more than stat_n_rows / 10 modifications
+	(see dict_stats_update_if_needed()), and stat_modified_counter
+	has been counting the modifications ever since. */
+	double	weight = 1.0;
+
+	if (incremental && table->stat_initialized) {
+		const ib_uint64_t	n_rows = table->stat_n_rows;
+		const ib_uint64_t	n_modified = n_rows / 10
+			+ table->stat_modified_counter;
+
+		if (n_modified > 0 && n_modified < n_rows) {
+			weight = double(n_modified) / double(n_rows);
+		}
+	}
+
 	/* analyze the clustered index first */
 
 	index = dict_table_get_first_index(table);
@@ -2243,7 +2341,7 @@ dict_stats_update_persistent(
 
 	ut_ad(!dict_index_is_ibuf(index));
 
-	dict_stats_analyze_index(index);
+	dict_stats_analyze_index(index, weight);
 
 	ulint	n_unique = dict_index_get_n_unique(index);
 
@@ -2265,14 +2363,17 @@ dict_stats_update_persistent(
 			continue;
 		}
 
-		dict_stats_empty_index(index, false);
-
 		if (dict_stats_should_ignore_index(index)) {
+			dict_stats_empty_index(index, false);
 			continue;
 		}
 
 		if (!(table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
-			dict_stats_analyze_index(index);
+			/* dict_stats_analyze_index() needs the previous
+			estimates for merging, and empties them itself */
+			dict_stats_analyze_index(index, weight);
+		} else {
+			dict_stats_empty_index(index, false);
 		}
 
 		table->stat_sum_of_other_index_sizes
@@ -3175,6 +3276,7 @@ dict_stats_update(
 
 	switch (stats_upd_option) {
 	case DICT_STATS_RECALC_PERSISTENT:
+	case DICT_STATS_RECALC_PERSISTENT_INCREMENTAL:
 
 		if (srv_read_only_mode) {
 			goto transient;
@@ -3198,7 +3300,9 @@ dict_stats_update(
 
 			dberr_t	err;
 
-			err = dict_stats_update_persistent(table);
+			err = dict_stats_update_persistent(
+				table, stats_upd_option
+				== DICT_STATS_RECALC_PERSISTENT_INCREMENTAL);
 
 			if (err != DB_SUCCESS) {
 				return(err);
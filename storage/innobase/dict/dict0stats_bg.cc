@@ -379,7 +379,9 @@ dict_stats_process_entry_from_recalc_pool()
 
 	} else {
 
-		dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT);
+		dict_stats_update(table, srv_stats_incremental
+				  ? DICT_STATS_RECALC_PERSISTENT_INCREMENTAL
+				  : DICT_STATS_RECALC_PERSISTENT);
 	}
 
 	mutex_enter(&dict_sys->mutex);
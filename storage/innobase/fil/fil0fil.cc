@@ -26,6 +26,7 @@ Created 10/25/1995 Heikki Tuuri
 
 #include "fil0fil.h"
 #include "fil0crypt.h"
+#include "fil0pagecompress.h"
 
 #include "btr0btr.h"
 #include "buf0buf.h"
@@ -182,6 +183,27 @@ fil_system_t	fil_system;
 UNIV_INTERN extern uint srv_fil_crypt_rotate_key_age;
 UNIV_INTERN extern ib_mutex_t fil_crypt_threads_mutex;
 
+/** Number of slots in fil_space_readers */
+static const ulint	FIL_SPACE_READER_SLOTS = 64;
+
+/** A count of fil_space_get_by_id_lock_free() callers in progress */
+struct MY_ALIGNED(CACHE_LINE_SIZE) fil_space_readers_t {
+	/** number of callers in progress */
+	ulint	n;
+	/** padding to prevent false sharing between the counters */
+	byte	pad[CACHE_LINE_SIZE - sizeof(ulint)];
+};
+
+/** Counts of fil_space_get_by_id_lock_free() callers in progress.
+fil_space_free_low() waits for them, so that a fil_space_t or fil_node_t
+that was found without fil_system.mutex will not be freed while it
+is being accessed. */
+static fil_space_readers_t	fil_space_readers[FIL_SPACE_READER_SLOTS];
+
+/** Version of fil_system.spaces; odd while a hash chain is being
+modified, and incremented twice on each modification */
+static ulint	fil_space_hash_version;
+
 /** Determine if user has explicitly disabled fsync(). */
 # define fil_buffering_disabled(s)	\
 	((s)->purpose == FIL_TYPE_TABLESPACE	\
@@ -349,6 +371,123 @@ fil_space_get_by_id(
 	return(space);
 }
 
+/** Register a fil_space_get_by_id_lock_free() caller.
+@return the counter to pass to fil_space_reader_exit() */
+static
+ulint*
+fil_space_reader_enter()
+{
+	/* A thread identifier is usually the address of a thread
+	descriptor that is aligned to a large power of 2. */
+	ulint	id = ulint(os_thread_get_curr_id());
+	ulint*	n = &fil_space_readers[(id ^ (id >> 12) ^ (id >> 24))
+				       % FIL_SPACE_READER_SLOTS].n;
+
+	/* Use a full memory barrier, so that fil_space_free_low()
+	will wait for us if we can find the tablespace. */
+	my_atomic_addlint(n, 1);
+	return(n);
+}
+
+/** Unregister a fil_space_get_by_id_lock_free() caller.
+@param[in,out]	n	return value of fil_space_reader_enter() */
+static
+void
+fil_space_reader_exit(ulint* n)
+{
+	my_atomic_addlint(n, ulint(-1));
+}
+
+/** Wait for the fil_space_get_by_id_lock_free() callers that might
+have found a tablespace before it was removed from fil_system.spaces.
+The callers may acquire fil_system.mutex before unregistering. */
+static
+void
+fil_space_readers_wait()
+{
+	ut_ad(!mutex_own(&fil_system.mutex));
+
+	for (ulint i = 0; i < FIL_SPACE_READER_SLOTS; i++) {
+		while (my_atomic_loadlint(&fil_space_readers[i].n)) {
+			os_thread_yield();
+		}
+	}
+}
+
+/** Insert a tablespace to fil_system.spaces.
+@param[in,out]	space	tablespace */
+static
+void
+fil_space_hash_insert(fil_space_t* space)
+{
+	ut_ad(mutex_own(&fil_system.mutex));
+
+	/* Use full memory barriers, so that the initialization of
+	the object and the modification of the chain cannot be
+	reordered with the version changes. */
+	my_atomic_addlint(&fil_space_hash_version, 1);
+	HASH_INSERT(fil_space_t, hash, fil_system.spaces, space->id, space);
+	my_atomic_addlint(&fil_space_hash_version, 1);
+}
+
+/** Remove a tablespace from fil_system.spaces.
+@param[in,out]	space	tablespace */
+static
+void
+fil_space_hash_delete(fil_space_t* space)
+{
+	ut_ad(mutex_own(&fil_system.mutex));
+
+	my_atomic_addlint(&fil_space_hash_version, 1);
+	HASH_DELETE(fil_space_t, hash, fil_system.spaces, space->id, space);
+	my_atomic_addlint(&fil_space_hash_version, 1);
+}
+
+/** Look up a tablespace without holding fil_system.mutex.
+The caller must be between fil_space_reader_enter() and
+fil_space_reader_exit(), and it must compare *version to
+fil_space_hash_version after acquiring a reference to the tablespace.
+@param[in]	id	tablespace identifier
+@param[out]	version	fil_space_hash_version at the start of the lookup
+@return the tablespace
+@retval NULL if the tablespace was not found, or the lookup must be
+repeated while holding fil_system.mutex */
+static
+fil_space_t*
+fil_space_get_by_id_lock_free(ulint id, ulint* version)
+{
+	*version = my_atomic_loadlint(&fil_space_hash_version);
+
+	if (*version & 1) {
+		return(NULL);
+	}
+
+	hash_cell_t*	cell = hash_get_nth_cell(
+		fil_system.spaces, hash_calc_hash(id, fil_system.spaces));
+
+	for (void* node = my_atomic_loadptr(&cell->node); node != NULL; ) {
+		/* If the chain was modified after we read the pointer,
+		it may point to an object that is being freed, or
+		HASH_INVALIDATE() may have overwritten the successor. */
+		if (ulint(my_atomic_loadlint(&fil_space_hash_version))
+		    != *version) {
+			return(NULL);
+		}
+
+		fil_space_t*	space = static_cast<fil_space_t*>(node);
+
+		ut_ad(space->magic_n == FIL_SPACE_MAGIC_N);
+
+		if (space->id == id) {
+			return(space);
+		}
+
+		node = my_atomic_loadptr(&space->hash);
+	}
+
+	return(NULL);
+}
+
 /** Look up a tablespace.
 The caller should hold an InnoDB table lock or a MDL that prevents
 the tablespace from being dropped during the operation,
@@ -629,6 +768,11 @@ fil_node_open_file(
 				page_size_t(space->flags), page);
 		}
 
+		if (!space->zstd_dict) {
+			space->zstd_dict = fil_zstd_dict_read(
+				space->flags, page);
+		}
+
 		ut_free(buf2);
 		os_file_close(node->handle);
 		node->handle = OS_FILE_CLOSED;
@@ -1308,7 +1452,7 @@ fil_space_detach(
 {
 	ut_ad(mutex_own(&fil_system.mutex));
 
-	HASH_DELETE(fil_space_t, hash, fil_system.spaces, space->id, space);
+	fil_space_hash_delete(space);
 
 	if (space->is_in_unflushed_spaces) {
 
@@ -1345,6 +1489,7 @@ fil_space_detach(
 
 /** Free a tablespace object on which fil_space_detach() was invoked.
 There must not be any pending i/o's or flushes on the files.
+The caller must not hold fil_system.mutex.
 @param[in,out]	space		tablespace */
 static
 void
@@ -1357,8 +1502,12 @@ fil_space_free_low(
 
 	/* Wait for fil_space_release_for_io(); after
 	fil_space_detach(), the tablespace cannot be found, so
-	fil_space_acquire_for_io() would return NULL */
-	while (space->n_pending_ios) {
+	fil_space_acquire_for_io() would return NULL. A lock-free
+	lookup that started before fil_space_detach() may still
+	increment n_pending_ios. */
+	fil_space_readers_wait();
+
+	while (my_atomic_loadlint(&space->n_pending_ios)) {
 		os_thread_sleep(100);
 	}
 
@@ -1376,6 +1525,7 @@ fil_space_free_low(
 
 	rw_lock_free(&space->latch);
 	fil_space_destroy_crypt_data(&space->crypt_data);
+	fil_zstd_dict_free(space->zstd_dict);
 
 	ut_free(space->name);
 	ut_free(space);
@@ -1524,7 +1674,7 @@ fil_space_create(
 		space->atomic_write_supported = true;
 	}
 
-	HASH_INSERT(fil_space_t, hash, fil_system.spaces, id, space);
+	fil_space_hash_insert(space);
 
 	UT_LIST_ADD_LAST(fil_system.space_list, space);
 
@@ -1936,10 +2086,8 @@ fil_close_all_files(void)
 
 	mutex_enter(&fil_system.mutex);
 
-	for (space = UT_LIST_GET_FIRST(fil_system.space_list);
-	     space != NULL; ) {
+	while ((space = UT_LIST_GET_FIRST(fil_system.space_list)) != NULL) {
 		fil_node_t*	node;
-		fil_space_t*	prev_space = space;
 
 		for (node = UT_LIST_GET_FIRST(space->chain);
 		     node != NULL;
@@ -1950,9 +2098,13 @@ fil_close_all_files(void)
 			}
 		}
 
-		space = UT_LIST_GET_NEXT(space_list, space);
-		fil_space_detach(prev_space);
-		fil_space_free_low(prev_space);
+		fil_space_detach(space);
+
+		/* fil_space_free_low() must not be invoked while
+		holding fil_system.mutex. */
+		mutex_exit(&fil_system.mutex);
+		fil_space_free_low(space);
+		mutex_enter(&fil_system.mutex);
 	}
 
 	mutex_exit(&fil_system.mutex);
@@ -2001,7 +2153,15 @@ fil_close_log_files(
 
 		if (free) {
 			fil_space_detach(prev_space);
+
+			/* fil_space_free_low() must not be invoked while
+			holding fil_system.mutex. The list may change
+			meanwhile, so start over. */
+			mutex_exit(&fil_system.mutex);
 			fil_space_free_low(prev_space);
+			mutex_enter(&fil_system.mutex);
+
+			space = UT_LIST_GET_FIRST(fil_system.space_list);
 		}
 	}
 
@@ -2114,12 +2274,33 @@ when it could be dropped concurrently.
 fil_space_t*
 fil_space_acquire_for_io(ulint id)
 {
+	ulint*		readers = fil_space_reader_enter();
+	ulint		version;
+	fil_space_t*	space = fil_space_get_by_id_lock_free(id, &version);
+
+	if (space) {
+		my_atomic_addlint(&space->n_pending_ios, 1);
+
+		if (ulint(my_atomic_loadlint(&fil_space_hash_version))
+		    != version) {
+			/* The tablespace may have been detached. */
+			my_atomic_addlint(&space->n_pending_ios, ulint(-1));
+			space = NULL;
+		}
+	}
+
+	fil_space_reader_exit(readers);
+
+	if (space) {
+		return(space);
+	}
+
 	mutex_enter(&fil_system.mutex);
 
-	fil_space_t* space = fil_space_get_by_id(id);
+	space = fil_space_get_by_id(id);
 
 	if (space) {
-		space->n_pending_ios++;
+		my_atomic_addlint(&space->n_pending_ios, 1);
 	}
 
 	mutex_exit(&fil_system.mutex);
@@ -2132,11 +2313,9 @@ fil_space_acquire_for_io(ulint id)
 void
 fil_space_release_for_io(fil_space_t* space)
 {
-	mutex_enter(&fil_system.mutex);
 	ut_ad(space->magic_n == FIL_SPACE_MAGIC_N);
 	ut_ad(space->n_pending_ios > 0);
-	space->n_pending_ios--;
-	mutex_exit(&fil_system.mutex);
+	my_atomic_addlint(&space->n_pending_ios, ulint(-1));
 }
 
 /********************************************************//**
@@ -4284,13 +4463,15 @@ fil_node_prepare_for_io(
 		}
 	}
 
+	/* While n_pending is 0, fil_node_prepare_for_io_lock_free()
+	will not modify it. */
 	if (node->n_pending == 0 && fil_space_belongs_in_lru(space)) {
 		/* The node is in the LRU list, remove it */
 		ut_a(UT_LIST_GET_LEN(fil_system.LRU) > 0);
 		UT_LIST_REMOVE(fil_system.LRU, node);
 	}
 
-	node->n_pending++;
+	my_atomic_addlint(&node->n_pending, 1);
 
 	return(true);
 }
@@ -4303,10 +4484,11 @@ void
 fil_node_complete_io(fil_node_t* node, const IORequest& type)
 {
 	ut_ad(mutex_own(&fil_system.mutex));
-	ut_a(node->n_pending > 0);
 
-	--node->n_pending;
+	const ulint	n_pending = my_atomic_addlint(
+		&node->n_pending, ulint(-1)) - 1;
 
+	ut_a(n_pending != ULINT_UNDEFINED);
 	ut_ad(type.validate());
 
 	if (type.is_write()) {
@@ -4335,13 +4517,125 @@ fil_node_complete_io(fil_node_t* node, const IORequest& type)
 		}
 	}
 
-	if (node->n_pending == 0 && fil_space_belongs_in_lru(node->space)) {
+	if (n_pending == 0 && fil_space_belongs_in_lru(node->space)) {
 
 		/* The node must be put back to the LRU list */
 		UT_LIST_ADD_FIRST(fil_system.LRU, node);
 	}
 }
 
+/** Update the data structures when a read operation finishes,
+without acquiring fil_system.mutex. This only succeeds when
+other i/o is pending on the file, so that the node will not
+be added to fil_system.LRU.
+@param[in,out]	node	file node
+@return whether fil_node_t::n_pending was decremented */
+static
+bool
+fil_node_complete_read_lock_free(fil_node_t* node)
+{
+	for (ulint n = my_atomic_loadlint(&node->n_pending); n > 1; ) {
+		if (my_atomic_caslint(&node->n_pending, &n, n - 1)) {
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/** Prepare a file node for i/o without acquiring fil_system.mutex.
+This only succeeds when other i/o is pending on the file, so that
+the file is open and the node is not in fil_system.LRU.
+@param[in]	type	IO context
+@param[in]	sync	whether synchronous i/o was requested
+@param[in]	page_id	page id
+@param[out]	page_no	page number within the file
+@return the file node, with n_pending incremented
+@retval NULL if fil_io() must acquire fil_system.mutex */
+static
+fil_node_t*
+fil_node_prepare_for_io_lock_free(
+	const IORequest&	type,
+	bool			sync,
+	const page_id_t&	page_id,
+	ulint*			page_no)
+{
+	ulint*		readers = fil_space_reader_enter();
+	ulint		version;
+	fil_node_t*	node = NULL;
+	fil_space_t*	space = fil_space_get_by_id_lock_free(
+		page_id.space(), &version);
+
+	if (space == NULL || space->stop_ios || space->recv_size) {
+		goto func_exit;
+	}
+
+	*page_no = page_id.page_no();
+
+	/* Let fil_io() report any accesses beyond the end of the
+	tablespace. Files are only added to the chain before the
+	tablespace is used, and a file can only be removed after
+	fil_space_detach(). */
+	for (node = UT_LIST_GET_FIRST(space->chain); node != NULL;
+	     node = UT_LIST_GET_NEXT(chain, node)) {
+		const ulint	size = node->size;
+
+		if (size > *page_no) {
+			break;
+		}
+
+		if (size == 0) {
+			node = NULL;
+			break;
+		}
+
+		*page_no -= size;
+	}
+
+	if (node == NULL) {
+		goto func_exit;
+	}
+
+	for (ulint n = my_atomic_loadlint(&node->n_pending);; ) {
+		if (n == 0) {
+			/* The file may be closed or in fil_system.LRU. */
+			node = NULL;
+			goto func_exit;
+		}
+
+		if (my_atomic_caslint(&node->n_pending, &n, n + 1)) {
+			break;
+		}
+	}
+
+	/* Recheck the conditions that fil_io() checks while holding
+	fil_system.mutex. The rename or deletion of a tablespace
+	would wait for our n_pending to reach 0, but new requests
+	should not keep it waiting. */
+	if (ulint(my_atomic_loadlint(&fil_space_hash_version)) != version
+	    || space->stop_ios
+	    || (type.is_read() && !sync
+		&& space->stop_new_ops && !space->is_being_truncated)) {
+		/* The n_pending that we incremented prevents the file
+		from being closed and the node from being freed.
+		Unregister before acquiring fil_system.mutex, because
+		fil_space_free_low() may wait for us. */
+		fil_space_reader_exit(readers);
+
+		if (!fil_node_complete_read_lock_free(node)) {
+			mutex_enter(&fil_system.mutex);
+			fil_node_complete_io(node, IORequestRead);
+			mutex_exit(&fil_system.mutex);
+		}
+
+		return(NULL);
+	}
+
+func_exit:
+	fil_space_reader_exit(readers);
+	return(node);
+}
+
 /** Report information about an invalid page access. */
 static
 void
@@ -4456,12 +4750,23 @@ fil_io(
 		srv_stats.data_written.add(len);
 	}
 
+	ulint		cur_page_no;
+	fil_node_t*	node = fil_node_prepare_for_io_lock_free(
+		req_type, sync, page_id, &cur_page_no);
+	fil_space_t*	space;
+
+	if (node != NULL) {
+		space = node->space;
+		ut_ad(mode != OS_AIO_IBUF || fil_type_is_data(space->purpose));
+		goto do_io;
+	}
+
 	/* Reserve the fil_system mutex and make sure that we can open at
 	least one file while holding it, if the file is not already open */
 
 	fil_mutex_enter_and_prepare_for_io(page_id.space());
 
-	fil_space_t*	space = fil_space_get_by_id(page_id.space());
+	space = fil_space_get_by_id(page_id.space());
 
 	/* If we are deleting a tablespace we don't allow async read operations
 	on that. However, we do allow write operations and sync read operations. */
@@ -4487,8 +4792,8 @@ fil_io(
 
 	ut_ad(mode != OS_AIO_IBUF || fil_type_is_data(space->purpose));
 
-	ulint		cur_page_no = page_id.page_no();
-	fil_node_t*	node = UT_LIST_GET_FIRST(space->chain);
+	cur_page_no = page_id.page_no();
+	node = UT_LIST_GET_FIRST(space->chain);
 
 	for (;;) {
 
@@ -4588,6 +4893,7 @@ fil_io(
 	/* Now we have made the changes in the data structures of fil_system */
 	mutex_exit(&fil_system.mutex);
 
+do_io:
 	/* Calculate the low 32 bits and the high 32 bits of the file offset */
 
 	if (!page_size.is_compressed()) {
@@ -4646,11 +4952,12 @@ fil_io(
 		/* The i/o operation is already completed when we return from
 		os_aio: */
 
-		mutex_enter(&fil_system.mutex);
-
-		fil_node_complete_io(node, req_type);
-
-		mutex_exit(&fil_system.mutex);
+		if (!req_type.is_read()
+		    || !fil_node_complete_read_lock_free(node)) {
+			mutex_enter(&fil_system.mutex);
+			fil_node_complete_io(node, req_type);
+			mutex_exit(&fil_system.mutex);
+		}
 
 		ut_ad(fil_validate_skip());
 	}
@@ -4686,14 +4993,17 @@ fil_aio_wait(
 
 	srv_set_io_thread_op_info(segment, "complete io for fil node");
 
-	mutex_enter(&fil_system.mutex);
-
-	fil_node_complete_io(node, type);
 	const fil_type_t	purpose	= node->space->purpose;
 	const ulint		space_id= node->space->id;
 	const bool		dblwr	= node->space->use_doublewrite();
 
-	mutex_exit(&fil_system.mutex);
+	/* A completed read normally only needs to decrement
+	node->n_pending, unless it was the last pending request */
+	if (!type.is_read() || !fil_node_complete_read_lock_free(node)) {
+		mutex_enter(&fil_system.mutex);
+		fil_node_complete_io(node, type);
+		mutex_exit(&fil_system.mutex);
+	}
 
 	ut_ad(fil_validate_skip());
 
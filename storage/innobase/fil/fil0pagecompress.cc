@@ -73,10 +73,161 @@ Updated 14/02/2015
 #ifdef HAVE_SNAPPY
 #include "snappy-c.h"
 #endif
+#ifdef HAVE_ZSTD
+#include "zstd.h"
+#include "zstd_errors.h"
+#include "zdict.h"
+#endif
 
 /* Used for debugging */
 //#define UNIV_PAGECOMPRESS_DEBUG 1
 
+#ifdef HAVE_ZSTD
+/** Magic number of a Zstandard dictionary in the first page */
+static const byte FIL_ZSTD_DICT_MAGIC[4] = { 'Z', 'D', 'I', 'C' };
+
+/** Bytes reserved for the encryption metadata in the first page */
+static const ulint FIL_ZSTD_DICT_CRYPT_RESERVE = 64;
+
+/** Maximum number of pages to sample for training a dictionary */
+static const ulint FIL_ZSTD_TRAIN_PAGES = 512;
+
+/** Number of cached compression and decompression contexts */
+static const ulint FIL_ZSTD_N_CTX = 32;
+
+/** Zstandard dictionary of a page_compressed tablespace */
+struct fil_zstd_dict_t {
+	/** dictionary ID, written to each compressed frame */
+	unsigned	id;
+	/** length of data, in bytes */
+	ulint		len;
+	/** the dictionary as stored in the first page */
+	byte*		data;
+	/** dictionary digested for decompression */
+	ZSTD_DDict*	ddict;
+	/** dictionary digested for compression, by compression level;
+	created on demand */
+	ZSTD_CDict*	cdict[10];
+};
+
+/** Cached compression contexts */
+static void* volatile fil_zstd_cctx[FIL_ZSTD_N_CTX];
+/** Cached decompression contexts */
+static void* volatile fil_zstd_dctx[FIL_ZSTD_N_CTX];
+
+/** Take a cached Zstandard context.
+@param[in,out]	cache	fil_zstd_cctx or fil_zstd_dctx
+@return a context
+@retval NULL if none was cached */
+static void* fil_zstd_ctx_get(void* volatile* cache)
+{
+	for (ulint i = 0; i < FIL_ZSTD_N_CTX; i++) {
+		if (my_atomic_loadptr_explicit(&cache[i],
+					       MY_MEMORY_ORDER_RELAXED)) {
+			if (void* ctx = my_atomic_fasptr(&cache[i], NULL)) {
+				return(ctx);
+			}
+		}
+	}
+
+	return(NULL);
+}
+
+/** Return a Zstandard context to the cache.
+@param[in,out]	cache	fil_zstd_cctx or fil_zstd_dctx
+@param[in]	ctx	context
+@return whether the context was cached (if not, the caller must free it) */
+static bool fil_zstd_ctx_put(void* volatile* cache, void* ctx)
+{
+	for (ulint i = 0; i < FIL_ZSTD_N_CTX; i++) {
+		void*	expected = NULL;
+
+		if (my_atomic_casptr(&cache[i], &expected, ctx)) {
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/** @return the offset of the Zstandard dictionary in the first page
+@param[in]	page_size	page size of the tablespace */
+static ulint fil_zstd_dict_offset(const page_size_t& page_size)
+{
+	return(FSP_HEADER_OFFSET + fsp_header_get_encryption_offset(page_size)
+	       + FIL_ZSTD_DICT_CRYPT_RESERVE);
+}
+
+/** @return the maximum length of a Zstandard dictionary
+@param[in]	page_size	page size of the tablespace */
+static ulint fil_zstd_dict_capacity(const page_size_t& page_size)
+{
+	return(page_size.physical() - FIL_PAGE_DATA_END
+	       - fil_zstd_dict_offset(page_size)
+	       - sizeof FIL_ZSTD_DICT_MAGIC - 2);
+}
+
+/** Create a Zstandard dictionary object.
+@param[in]	data	dictionary contents
+@param[in]	len	length of data, in bytes
+@return the dictionary
+@retval NULL if data is not a valid dictionary */
+static fil_zstd_dict_t* fil_zstd_dict_create(const byte* data, ulint len)
+{
+	unsigned id = ZDICT_getDictID(data, len);
+
+	if (!id) {
+		/* Without an ID, frames compressed with the dictionary
+		could not be told apart from frames without it. */
+		return(NULL);
+	}
+
+	fil_zstd_dict_t* dict = static_cast<fil_zstd_dict_t*>(
+		ut_zalloc_nokey(sizeof *dict));
+	dict->id = id;
+	dict->len = len;
+	dict->data = static_cast<byte*>(ut_malloc_nokey(len));
+	memcpy(dict->data, data, len);
+	dict->ddict = ZSTD_createDDict(dict->data, len);
+
+	if (!dict->ddict) {
+		fil_zstd_dict_free(dict);
+		return(NULL);
+	}
+
+	return(dict);
+}
+
+/** Get a Zstandard dictionary digested for a compression level.
+@param[in,out]	dict	dictionary
+@param[in]	level	compression level
+@return the digested dictionary
+@retval NULL if out of memory */
+static const ZSTD_CDict* fil_zstd_dict_get_cdict(
+	fil_zstd_dict_t* dict, int level)
+{
+	level = ut_min(ut_max(level, 0),
+		       int(UT_ARR_SIZE(dict->cdict) - 1));
+	void* volatile*	slot = reinterpret_cast<void* volatile*>(
+		&dict->cdict[level]);
+
+	if (void* cdict = my_atomic_loadptr(slot)) {
+		return(static_cast<ZSTD_CDict*>(cdict));
+	}
+
+	ZSTD_CDict*	cdict = ZSTD_createCDict(dict->data, dict->len, level);
+	void*		expected = NULL;
+
+	if (!my_atomic_casptr(slot, &expected, cdict)) {
+		/* Another thread created it first. */
+		ZSTD_freeCDict(cdict);
+		cdict = static_cast<ZSTD_CDict*>(expected);
+	}
+
+	return(cdict);
+}
+#endif /* HAVE_ZSTD */
+
 /****************************************************************//**
 For page compressed pages compress the page before actual write
 operation.
@@ -259,6 +410,46 @@ fil_compress_page(
 	}
 #endif /* HAVE_SNAPPY */
 
+#ifdef HAVE_ZSTD
+	case PAGE_ZSTD_ALGORITHM:
+	{
+		fil_zstd_dict_t* dict = space
+			? static_cast<fil_zstd_dict_t*>(
+				my_atomic_loadptr(reinterpret_cast<void**>(
+							  &space->zstd_dict)))
+			: NULL;
+		const ZSTD_CDict* cdict = dict
+			? fil_zstd_dict_get_cdict(dict, comp_level)
+			: NULL;
+		ZSTD_CCtx* cctx = static_cast<ZSTD_CCtx*>(
+			fil_zstd_ctx_get(fil_zstd_cctx));
+
+		if (!cctx) {
+			cctx = ZSTD_createCCtx();
+		}
+
+		size_t ret = cdict
+			? ZSTD_compress_usingCDict(
+				cctx, out_buf + header_len, write_size,
+				buf, len, cdict)
+			: ZSTD_compressCCtx(
+				cctx, out_buf + header_len, write_size,
+				buf, len, comp_level);
+
+		if (!fil_zstd_ctx_put(fil_zstd_cctx, cctx)) {
+			ZSTD_freeCCtx(cctx);
+		}
+
+		if (ZSTD_isError(ret)) {
+			err = int(ZSTD_getErrorCode(ret));
+			goto err_exit;
+		}
+
+		write_size = ret;
+		break;
+	}
+#endif /* HAVE_ZSTD */
+
 	case PAGE_ZLIB_ALGORITHM:
 		err = compress2(out_buf+header_len, (ulong*)&write_size, buf,
 				uLong(len), comp_level);
@@ -314,7 +505,8 @@ fil_compress_page(
 		uncomp_page = static_cast<byte *>(ut_malloc_nokey(UNIV_PAGE_SIZE));
 		memcpy(comp_page, out_buf, UNIV_PAGE_SIZE);
 
-		fil_decompress_page(uncomp_page, comp_page, ulong(len), NULL);
+		fil_decompress_page(uncomp_page, comp_page, ulong(len), NULL,
+				    false, space ? space->zstd_dict : NULL);
 
 		if (buf_page_is_corrupted(false, uncomp_page, univ_page_size,
 					  space)) {
@@ -408,9 +600,13 @@ fil_decompress_page(
 	ulong	len,		/*!< in: length of output buffer.*/
 	ulint*	write_size,	/*!< in/out: Actual payload size of
 				the compressed data. */
-	bool	return_error)	/*!< in: true if only an error should
+	bool	return_error,	/*!< in: true if only an error should
 				be produced when decompression fails.
 				By default this parameter is false. */
+	const fil_zstd_dict_t*	zstd_dict)
+				/*!< in: Zstandard dictionary of the
+				tablespace, or NULL to look it up
+				if the page needs one */
 {
 	int err = 0;
 	ulint actual_size = 0;
@@ -614,6 +810,64 @@ fil_decompress_page(
 		break;
 	}
 #endif /* HAVE_SNAPPY */
+#ifdef HAVE_ZSTD
+	case PAGE_ZSTD_ALGORITHM:
+	{
+		const unsigned dict_id = ZSTD_getDictID_fromFrame(
+			buf + header_len, actual_size);
+		fil_space_t* space = NULL;
+
+		if (dict_id && !zstd_dict) {
+			space = fil_space_acquire_for_io(
+				mach_read_from_4(buf + FIL_PAGE_SPACE_ID));
+			zstd_dict = space ? space->zstd_dict : NULL;
+		}
+
+		if (dict_id && (!zstd_dict || zstd_dict->id != dict_id)) {
+			/* The dictionary is missing or wrong. */
+			if (space) {
+				fil_space_release_for_io(space);
+			}
+			err = int(ZSTD_error_dictionary_wrong);
+			goto err_exit;
+		}
+
+		ZSTD_DCtx* dctx = static_cast<ZSTD_DCtx*>(
+			fil_zstd_ctx_get(fil_zstd_dctx));
+
+		if (!dctx) {
+			dctx = ZSTD_createDCtx();
+		}
+
+		size_t olen = dict_id
+			? ZSTD_decompress_usingDDict(
+				dctx, in_buf, len, buf + header_len,
+				actual_size, zstd_dict->ddict)
+			: ZSTD_decompressDCtx(
+				dctx, in_buf, len, buf + header_len,
+				actual_size);
+
+		if (!fil_zstd_ctx_put(fil_zstd_dctx, dctx)) {
+			ZSTD_freeDCtx(dctx);
+		}
+
+		if (space) {
+			fil_space_release_for_io(space);
+		}
+
+		if (ZSTD_isError(olen)) {
+			err = int(ZSTD_getErrorCode(olen));
+			goto err_exit;
+		}
+
+		if (olen == 0 || olen > UNIV_PAGE_SIZE) {
+			len = ulong(olen);
+			goto err_exit;
+		}
+
+		break;
+	}
+#endif /* HAVE_ZSTD */
 	default:
 		goto err_exit;
 		if (return_error) {
@@ -654,3 +908,226 @@ fil_decompress_page(
 	fil_space_release_for_io(space);
 	ut_ad(0);
 }
+
+/** Read the Zstandard dictionary from the first page of a tablespace.
+@param[in]	flags	tablespace flags
+@param[in]	page	first page of the tablespace
+@return the dictionary
+@retval NULL if the tablespace has no dictionary */
+fil_zstd_dict_t*
+fil_zstd_dict_read(ulint flags, const byte* page)
+{
+#ifdef HAVE_ZSTD
+	if (!FSP_FLAGS_HAS_PAGE_COMPRESSION(flags)) {
+		return(NULL);
+	}
+
+	const page_size_t	page_size(flags);
+	const byte*		p = page + fil_zstd_dict_offset(page_size);
+
+	if (memcmp(p, FIL_ZSTD_DICT_MAGIC, sizeof FIL_ZSTD_DICT_MAGIC)) {
+		return(NULL);
+	}
+
+	p += sizeof FIL_ZSTD_DICT_MAGIC;
+	const ulint len = mach_read_from_2(p);
+
+	if (len && len <= fil_zstd_dict_capacity(page_size)) {
+		if (fil_zstd_dict_t* dict = fil_zstd_dict_create(p + 2, len)) {
+			return(dict);
+		}
+	}
+
+	ib::error() << "Ignoring a corrupted Zstandard dictionary"
+		" in tablespace " << page_get_space_id(page);
+#endif /* HAVE_ZSTD */
+	return(NULL);
+}
+
+/** Write a Zstandard dictionary to the first page of a tablespace.
+@param[in]	dict	dictionary
+@param[in]	flags	tablespace flags
+@param[in,out]	page	first page of the tablespace
+@param[in,out]	mtr	mini-transaction */
+void
+fil_zstd_dict_write_page0(
+	const fil_zstd_dict_t*	dict,
+	ulint			flags,
+	byte*			page,
+	mtr_t*			mtr)
+{
+#ifdef HAVE_ZSTD
+	const page_size_t	page_size(flags);
+	byte*			p = page + fil_zstd_dict_offset(page_size);
+
+	ut_ad(FSP_FLAGS_HAS_PAGE_COMPRESSION(flags));
+	ut_ad(dict->len <= fil_zstd_dict_capacity(page_size));
+
+	mlog_write_string(p, FIL_ZSTD_DICT_MAGIC,
+			  sizeof FIL_ZSTD_DICT_MAGIC, mtr);
+	p += sizeof FIL_ZSTD_DICT_MAGIC;
+	mlog_write_ulint(p, dict->len, MLOG_2BYTES, mtr);
+	mlog_write_string(p + 2, dict->data, dict->len, mtr);
+#else
+	ut_error;
+#endif /* HAVE_ZSTD */
+}
+
+/** Free a Zstandard dictionary.
+@param[in,out]	dict	dictionary, or NULL */
+void
+fil_zstd_dict_free(fil_zstd_dict_t* dict)
+{
+#ifdef HAVE_ZSTD
+	if (!dict) {
+		return;
+	}
+
+	for (ulint i = 0; i < UT_ARR_SIZE(dict->cdict); i++) {
+		ZSTD_freeCDict(dict->cdict[i]);
+	}
+
+	ZSTD_freeDDict(dict->ddict);
+	ut_free(dict->data);
+	ut_free(dict);
+#else
+	ut_ad(!dict);
+#endif /* HAVE_ZSTD */
+}
+
+/** Train a Zstandard dictionary on a sample of the index pages of a
+page_compressed tablespace, store it in the first page, and use it for
+subsequently written pages.
+@param[in,out]	space	tablespace
+@retval DB_SUCCESS		on success
+@retval DB_UNSUPPORTED		if zstd is not available or the tablespace
+				is not page_compressed
+@retval DB_DUPLICATE_KEY	if the tablespace already has a dictionary
+@retval DB_ERROR		if there are too few pages to train on */
+dberr_t
+fil_zstd_dict_train(fil_space_t* space)
+{
+#ifdef HAVE_ZSTD
+	if (!FSP_FLAGS_HAS_PAGE_COMPRESSION(space->flags)
+	    || space->purpose != FIL_TYPE_TABLESPACE) {
+		return(DB_UNSUPPORTED);
+	}
+
+	if (space->zstd_dict) {
+		return(DB_DUPLICATE_KEY);
+	}
+
+	const page_size_t	page_size(space->flags);
+	const ulint		psize = page_size.logical();
+
+	mutex_enter(&fil_system.mutex);
+	const ulint		size = space->size;
+	mutex_exit(&fil_system.mutex);
+
+	/* Sample the index pages evenly over the whole file. */
+	std::vector<byte, ut_allocator<byte> >		samples;
+	std::vector<size_t, ut_allocator<size_t> >	sample_sizes;
+	const ulint	step = ut_max(size / FIL_ZSTD_TRAIN_PAGES, ulint(1));
+
+	for (ulint page_no = FSP_FIRST_INODE_PAGE_NO + 1; page_no < size;
+	     page_no += step) {
+		mtr_t		mtr;
+		dberr_t		err;
+
+		mtr.start();
+
+		if (const buf_block_t* block = buf_page_get_gen(
+			    page_id_t(space->id, page_no), page_size,
+			    RW_S_LATCH, NULL, BUF_GET_POSSIBLY_FREED,
+			    __FILE__, __LINE__, &mtr, &err)) {
+			if (fil_page_get_type(block->frame)
+			    == FIL_PAGE_INDEX) {
+				samples.insert(samples.end(), block->frame,
+					       block->frame + psize);
+				sample_sizes.push_back(psize);
+			}
+		}
+
+		mtr.commit();
+	}
+
+	const ulint	capacity = fil_zstd_dict_capacity(page_size);
+	byte*		data = static_cast<byte*>(ut_malloc_nokey(capacity));
+	size_t		len = sample_sizes.empty()
+		? 0
+		: ZDICT_trainFromBuffer(data, capacity, &samples[0],
+					&sample_sizes[0],
+					unsigned(sample_sizes.size()));
+
+	if (!len || ZDICT_isError(len)) {
+		ib::warn() << "Could not train a Zstandard dictionary for "
+			<< space->name << " on " << sample_sizes.size()
+			<< " pages: "
+			<< (len ? ZDICT_getErrorName(len) : "no index pages");
+		ut_free(data);
+		return(DB_ERROR);
+	}
+
+	fil_zstd_dict_t* dict = fil_zstd_dict_create(data, len);
+	ut_free(data);
+
+	if (!dict) {
+		return(DB_ERROR);
+	}
+
+	mtr_t	mtr;
+	mtr.start();
+	mtr.set_named_space(space);
+
+	buf_block_t* block = buf_page_get(
+		page_id_t(space->id, 0), page_size, RW_X_LATCH, &mtr);
+
+	/* Another thread may have stored a dictionary meanwhile. */
+	if (!memcmp(block->frame + fil_zstd_dict_offset(page_size),
+		    FIL_ZSTD_DICT_MAGIC, sizeof FIL_ZSTD_DICT_MAGIC)) {
+		mtr.commit();
+		fil_zstd_dict_free(dict);
+		return(DB_DUPLICATE_KEY);
+	}
+
+	fil_zstd_dict_write_page0(dict, space->flags, block->frame, &mtr);
+	mtr.commit();
+
+	/* Flush the first page before publishing the dictionary, so that
+	after a restart there can be no pages that were compressed with a
+	dictionary that cannot be found. */
+	const lsn_t	end_lsn = mtr.commit_lsn();
+
+	bool		success;
+
+	do {
+		success = buf_flush_lists(ULINT_MAX, end_lsn, NULL);
+		buf_flush_wait_batch_end(NULL, BUF_FLUSH_LIST);
+	} while (!success);
+
+	my_atomic_storeptr(reinterpret_cast<void**>(&space->zstd_dict), dict);
+
+	ib::info() << "Trained a Zstandard dictionary of " << len
+		<< " bytes for " << space->name << " on "
+		<< sample_sizes.size() << " pages";
+
+	return(DB_SUCCESS);
+#else
+	return(DB_UNSUPPORTED);
+#endif /* HAVE_ZSTD */
+}
+
+/** Free the cached Zstandard compression contexts at shutdown. */
+void
+fil_pagecompress_close()
+{
+#ifdef HAVE_ZSTD
+	while (void* cctx = fil_zstd_ctx_get(fil_zstd_cctx)) {
+		ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(cctx));
+	}
+
+	while (void* dctx = fil_zstd_ctx_get(fil_zstd_dctx)) {
+		ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(dctx));
+	}
+#endif /* HAVE_ZSTD */
+}
@@ -30,6 +30,7 @@ Created 11/29/1995 Heikki Tuuri
 #include "buf0buf.h"
 #include "fil0fil.h"
 #include "fil0crypt.h"
+#include "fil0pagecompress.h"
 #include "mtr0log.h"
 #include "ut0byte.h"
 #include "page0page.h"
@@ -762,6 +763,13 @@ void fsp_header_init(fil_space_t* space, ulint size, mtr_t* mtr)
 	     space->crypt_data->not_encrypted())) {
 		space->crypt_data->write_page0(space, block->frame, mtr);
 	}
+
+	/* Keep the Zstandard dictionary on TRUNCATE TABLE, because
+	pages may be compressed with it. */
+	if (space->zstd_dict) {
+		fil_zstd_dict_write_page0(space->zstd_dict, space->flags,
+					  block->frame, mtr);
+	}
 }
 
 /**********************************************************************//**
@@ -41,6 +41,11 @@ Completed 2011/7/10 Sunny and Jimmy Yang
 /** The FTS optimize thread's work queue. */
 static ib_wqueue_t* fts_optimize_wq;
 
+/** The work queue of the FTS optimize worker threads, or NULL if
+fts_optimize_threads == 1 and the FTS optimize thread optimizes the
+tables itself */
+static ib_wqueue_t* fts_optimize_worker_wq;
+
 /** Time to wait for a message. */
 static const ulint FTS_QUEUE_WAIT_IN_USECS = 5000000;
 
@@ -89,7 +94,10 @@ enum fts_msg_type_t {
 
 	FTS_MSG_DEL_TABLE,		/*!< Remove a table from the optimize
 					threads work queue */
-	FTS_MSG_SYNC_TABLE		/*!< Sync fts cache of a table */
+	FTS_MSG_SYNC_TABLE,		/*!< Sync fts cache of a table */
+
+	FTS_MSG_OPTIMIZE_DONE		/*!< A worker thread has finished
+					optimizing a table */
 };
 
 /** Compressed list of words that have been read from FTS INDEX
@@ -177,6 +185,9 @@ struct fts_optimize_t {
 					been optimized */
 	ibool		del_list_regenerated;
 					/*!< BEING_DELETED list regenarated */
+
+	ib_time_t	time_limit;	/*!< The amount of time optimizing in
+					a single pass, in milliseconds */
 };
 
 /** Used by the optimize, to keep state during compacting nodes. */
@@ -185,6 +196,8 @@ struct fts_encode_t {
 	byte*		src_ilist_ptr;	/*!< Current ptr within src ilist */
 };
 
+struct fts_msg_t;
+
 /** We use this information to determine when to start the optimize
 cycle for a table. */
 struct fts_slot_t {
@@ -206,6 +219,13 @@ struct fts_slot_t {
 
 	ib_time_t	interval_time;	/*!< Minimum time to wait before
 					optimizing the table again. */
+
+	bool		running;	/*!< true if a worker thread is
+					optimizing the table */
+
+	fts_msg_t*	del_msg;	/*!< FTS_MSG_DEL_TABLE that must wait
+					until the worker thread is done, or
+					NULL */
 };
 
 /** A table remove message for the FTS optimize thread. */
@@ -217,6 +237,14 @@ struct fts_msg_del_t {
 					this message by the consumer */
 };
 
+/** A table that a worker thread optimizes, for FTS_MSG_OPTIMIZE_TABLE
+sent to fts_optimize_worker_wq and FTS_MSG_OPTIMIZE_DONE sent back. */
+struct fts_msg_optimize_t {
+	dict_table_t*	table;		/*!< The table to optimize */
+
+	dberr_t		error;		/*!< The result of optimizing */
+};
+
 /** The FTS optimize message work queue message type. */
 struct fts_msg_t {
 	fts_msg_type_t	type;		/*!< Message type */
@@ -231,15 +259,15 @@ struct fts_msg_t {
 /** The number of words to read and optimize in a single pass. */
 ulong	fts_num_word_optimize;
 
+/** The number of threads that optimize FTS tables in the background. */
+ulong	fts_optimize_threads;
+
 // FIXME
 char	fts_enable_diag_print;
 
 /** ZLib compressed block size.*/
 static ulint FTS_ZIP_BLOCK_SIZE	= 1024;
 
-/** The amount of time optimizing in a single pass, in milliseconds. */
-static ib_time_t fts_optimize_time_limit = 0;
-
 /** It's defined in fts0fts.cc  */
 extern const char* fts_common_tables[];
 
@@ -1582,8 +1610,8 @@ fts_optimize_compact(
 		/* Free the word that was optimized. */
 		fts_word_free(word);
 
-		if (fts_optimize_time_limit > 0
-		    && (ut_time() - start_time) > fts_optimize_time_limit) {
+		if (optim->time_limit > 0
+		    && (ut_time() - start_time) > optim->time_limit) {
 
 			optim->done = TRUE;
 		}
@@ -1790,7 +1818,7 @@ fts_optimize_words(
 	ut_a(!optim->done);
 
 	/* Get the time limit from the config table. */
-	fts_optimize_time_limit = fts_optimize_get_time_limit(
+	optim->time_limit = fts_optimize_get_time_limit(
 		optim->trx, &optim->fts_common_table);
 
 	start_time = ut_time();
@@ -2412,7 +2440,9 @@ fts_optimize_table_bk(
 		return(DB_SUCCESS);
 
 	} else if (fts && fts->cache
-		   && fts->cache->deleted >= FTS_OPTIMIZE_THRESHOLD) {
+		   && (fts->cache->deleted >= FTS_OPTIMIZE_THRESHOLD
+		       || DBUG_EVALUATE_IF("fts_optimize_ignore_threshold",
+					   true, false))) {
 
 		error = fts_optimize_table(table);
 
@@ -2824,6 +2854,11 @@ fts_optimize_how_many(
 		slot = static_cast<const fts_slot_t*>(
 			ib_vector_get_const(tables, i));
 
+		/* Skip slots that a worker thread is optimizing. */
+		if (slot->running) {
+			continue;
+		}
+
 		switch (slot->state) {
 		case FTS_STATE_DONE:
 		case FTS_STATE_LOADED:
@@ -2967,6 +3002,166 @@ fts_optimize_sync_table(
 	}
 }
 
+/** Hand over a table to an FTS optimize worker thread if it needs to be
+optimized. This is the asynchronous counterpart of fts_optimize_table_bk().
+@param[in,out]	slot	table to optimize
+@return whether the table was handed over */
+static
+bool
+fts_optimize_table_dispatch(
+	fts_slot_t*	slot)
+{
+	dict_table_t*	table = slot->table;
+	fts_t*		fts = table->fts;
+
+	ut_ad(!slot->running);
+
+	/* Avoid optimizing tables that were optimized recently. */
+	if (slot->last_run > 0
+	    && (ut_time() - slot->last_run) < slot->interval_time) {
+
+		return(false);
+	}
+
+	if (!fts || !fts->cache
+	    || (fts->cache->deleted < FTS_OPTIMIZE_THRESHOLD
+		&& !DBUG_EVALUATE_IF("fts_optimize_ignore_threshold",
+				     true, false))) {
+
+		slot->last_run = ut_time();
+
+		return(false);
+	}
+
+	fts_msg_t*		msg = fts_optimize_create_msg(
+		FTS_MSG_OPTIMIZE_TABLE, NULL);
+	fts_msg_optimize_t*	job = static_cast<fts_msg_optimize_t*>(
+		mem_heap_alloc(msg->heap, sizeof(*job)));
+
+	job->table = table;
+	job->error = DB_SUCCESS;
+	msg->ptr = job;
+
+	slot->running = true;
+
+	ib_wqueue_add(fts_optimize_worker_wq, msg, msg->heap);
+
+	return(true);
+}
+
+/** Process FTS_MSG_DEL_TABLE: remove the table from the vector and
+acknowledge the removal request, unless a worker thread is optimizing the
+table, in which case this is deferred until FTS_MSG_OPTIMIZE_DONE.
+@param[in,out]	tables		registered tables
+@param[in]	msg		FTS_MSG_DEL_TABLE
+@param[in,out]	n_tables	number of registered tables
+@return whether the message was deferred and must not be freed yet */
+static
+bool
+fts_optimize_process_del(
+	ib_vector_t*	tables,
+	fts_msg_t*	msg,
+	ulint*		n_tables)
+{
+	fts_msg_del_t*	remove = static_cast<fts_msg_del_t*>(msg->ptr);
+	fts_slot_t*	slot = fts_optimize_find_slot(tables, remove->table);
+
+	if (slot != NULL && slot->running) {
+		ut_ad(slot->del_msg == NULL);
+		slot->del_msg = msg;
+		return(true);
+	}
+
+	if (fts_optimize_del_table(tables, remove)) {
+		--*n_tables;
+	}
+
+	/* Signal the producer that we have removed the table. */
+	os_event_set(remove->event);
+
+	return(false);
+}
+
+/** Process FTS_MSG_OPTIMIZE_DONE: note that a worker thread has finished
+optimizing a table, and process any FTS_MSG_DEL_TABLE that was waiting
+for that.
+@param[in,out]	tables		registered tables
+@param[in]	msg		FTS_MSG_OPTIMIZE_DONE
+@param[in,out]	n_tables	number of registered tables */
+static
+void
+fts_optimize_process_done(
+	ib_vector_t*		tables,
+	const fts_msg_t*	msg,
+	ulint*			n_tables)
+{
+	const fts_msg_optimize_t*	job
+		= static_cast<const fts_msg_optimize_t*>(msg->ptr);
+	fts_slot_t*	slot = fts_optimize_find_slot(tables, job->table);
+
+	ut_a(slot != NULL);
+	ut_ad(slot->running);
+
+	slot->running = false;
+
+	if (job->error == DB_SUCCESS) {
+		slot->state = FTS_STATE_DONE;
+		slot->completed = ut_time();
+	}
+
+	/* Note time this run completed. */
+	slot->last_run = ut_time();
+
+	if (fts_msg_t* del_msg = slot->del_msg) {
+		slot->del_msg = NULL;
+
+		if (!fts_optimize_process_del(tables, del_msg, n_tables)) {
+			mem_heap_free(del_msg->heap);
+		}
+	}
+}
+
+/** Optimize the tables that fts_optimize_thread() hands over in
+fts_optimize_worker_wq, and report each one back to it.
+@return Dummy return */
+static
+os_thread_ret_t
+DECLARE_THREAD(fts_optimize_worker)(void*)
+{
+	ut_ad(!srv_read_only_mode);
+	my_thread_init();
+
+	for (;;) {
+		fts_msg_t*	msg = static_cast<fts_msg_t*>(
+			ib_wqueue_wait(fts_optimize_worker_wq));
+
+		if (msg->type == FTS_MSG_STOP) {
+			mem_heap_free(msg->heap);
+			break;
+		}
+
+		ut_ad(msg->type == FTS_MSG_OPTIMIZE_TABLE);
+
+		fts_msg_optimize_t*	job = static_cast<fts_msg_optimize_t*>(
+			msg->ptr);
+
+		DBUG_EXECUTE_IF("fts_optimize_worker_sleep",
+				os_thread_sleep(2000000););
+
+		job->error = fts_optimize_table(job->table);
+
+		msg->type = FTS_MSG_OPTIMIZE_DONE;
+
+		ib_wqueue_add(fts_optimize_wq, msg, msg->heap);
+	}
+
+	my_thread_end();
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /**********************************************************************//**
 Optimize all FTS tables.
 @return Dummy return */
@@ -2984,6 +3179,12 @@ DECLARE_THREAD(fts_optimize_thread)(
 	ulint		n_tables = 0;
 	ulint		n_optimize = 0;
 	ib_wqueue_t*	wq = (ib_wqueue_t*) arg;
+	/* Number of worker threads, 0 if we optimize the tables here */
+	const ulint	n_workers = fts_optimize_threads > 1
+		? fts_optimize_threads : 0;
+	os_thread_t*	workers = NULL;
+	/* Number of tables handed over to the worker threads */
+	ulint		n_running = 0;
 
 	ut_ad(!srv_read_only_mode);
 	my_thread_init();
@@ -2993,15 +3194,27 @@ DECLARE_THREAD(fts_optimize_thread)(
 
 	tables = ib_vector_create(heap_alloc, sizeof(fts_slot_t), 4);
 
+	if (n_workers > 0) {
+		fts_optimize_worker_wq = ib_wqueue_create();
+		workers = UT_NEW_ARRAY_NOKEY(os_thread_t, n_workers);
+
+		for (ulint i = 0; i < n_workers; i++) {
+			workers[i] = os_thread_create(
+				fts_optimize_worker, NULL, NULL);
+		}
+	}
+
 	while (!done && srv_shutdown_state == SRV_SHUTDOWN_NONE) {
 
 		/* If there is no message in the queue and we have tables
-		to optimize then optimize the tables. */
+		to optimize then optimize the tables, or hand them over
+		to the worker threads as long as some of them are idle. */
 
 		if (!done
 		    && ib_wqueue_is_empty(wq)
 		    && n_tables > 0
-		    && n_optimize > 0) {
+		    && n_optimize > 0
+		    && (n_workers == 0 || n_running < n_workers)) {
 
 			fts_slot_t*	slot;
 
@@ -3010,12 +3223,17 @@ DECLARE_THREAD(fts_optimize_thread)(
 			slot = static_cast<fts_slot_t*>(
 				ib_vector_get(tables, current));
 
-			/* Handle the case of empty slots. */
-			if (slot->state != FTS_STATE_EMPTY) {
+			/* Handle the case of empty slots, and skip the
+			tables that the worker threads are optimizing. */
+			if (slot->state != FTS_STATE_EMPTY && !slot->running) {
 
 				slot->state = FTS_STATE_RUNNING;
 
-				fts_optimize_table_bk(slot);
+				if (n_workers == 0) {
+					fts_optimize_table_bk(slot);
+				} else if (fts_optimize_table_dispatch(slot)) {
+					++n_running;
+				}
 			}
 
 			++current;
@@ -3027,7 +3245,7 @@ DECLARE_THREAD(fts_optimize_thread)(
 				current = 0;
 			}
 
-		} else if (n_optimize == 0 || !ib_wqueue_is_empty(wq)) {
+		} else {
 			fts_msg_t*	msg;
 
 			msg = static_cast<fts_msg_t*>(
@@ -3074,16 +3292,10 @@ DECLARE_THREAD(fts_optimize_thread)(
 				break;
 
 			case FTS_MSG_DEL_TABLE:
-				if (fts_optimize_del_table(
-					tables, static_cast<fts_msg_del_t*>(
-						msg->ptr))) {
-					--n_tables;
+				if (fts_optimize_process_del(
+					    tables, msg, &n_tables)) {
+					msg = NULL;
 				}
-
-				/* Signal the producer that we have
-				removed the table. */
-				os_event_set(
-					((fts_msg_del_t*) msg->ptr)->event);
 				break;
 
 			case FTS_MSG_SYNC_TABLE:
@@ -3091,11 +3303,20 @@ DECLARE_THREAD(fts_optimize_thread)(
 					*static_cast<table_id_t*>(msg->ptr));
 				break;
 
+			case FTS_MSG_OPTIMIZE_DONE:
+				ut_ad(n_running > 0);
+				--n_running;
+				fts_optimize_process_done(
+					tables, msg, &n_tables);
+				break;
+
 			default:
 				ut_error;
 			}
 
-			mem_heap_free(msg->heap);
+			if (msg != NULL) {
+				mem_heap_free(msg->heap);
+			}
 
 			if (!done) {
 				n_optimize = fts_optimize_how_many(tables);
@@ -3105,6 +3326,47 @@ DECLARE_THREAD(fts_optimize_thread)(
 		}
 	}
 
+	/* Wait for the worker threads to finish the tables that they are
+	optimizing, and then stop them. */
+	while (n_running > 0) {
+		fts_msg_t*	msg = static_cast<fts_msg_t*>(
+			ib_wqueue_wait(wq));
+
+		switch (msg->type) {
+		case FTS_MSG_OPTIMIZE_DONE:
+			--n_running;
+			fts_optimize_process_done(tables, msg, &n_tables);
+			break;
+
+		case FTS_MSG_DEL_TABLE:
+			if (fts_optimize_process_del(tables, msg, &n_tables)) {
+				continue;
+			}
+			break;
+
+		default:
+			break;
+		}
+
+		mem_heap_free(msg->heap);
+	}
+
+	for (ulint i = 0; i < n_workers; i++) {
+		fts_msg_t*	msg = fts_optimize_create_msg(FTS_MSG_STOP, NULL);
+
+		ib_wqueue_add(fts_optimize_worker_wq, msg, msg->heap);
+	}
+
+	for (ulint i = 0; i < n_workers; i++) {
+		os_thread_join(workers[i]);
+	}
+
+	if (n_workers > 0) {
+		UT_DELETE_ARRAY(workers);
+		ib_wqueue_free(fts_optimize_worker_wq);
+		fts_optimize_worker_wq = NULL;
+	}
+
 	/* Server is being shutdown, sync the data from FTS cache to disk
 	if needed */
 	if (n_tables > 0) {
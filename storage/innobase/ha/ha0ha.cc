@@ -66,6 +66,14 @@ ib_create(
 			type);
 		ut_a(table->heap);
 
+#ifdef BTR_CUR_HASH_ADAPT
+		if (type == MEM_HEAP_FOR_BTR_SEARCH) {
+			table->versions = static_cast<ha_version_t*>(
+				ut_zalloc_nokey(HA_N_VERSIONS
+						* sizeof(ha_version_t)));
+		}
+#endif /* BTR_CUR_HASH_ADAPT */
+
 		return(table);
 	}
 
@@ -235,6 +243,9 @@ ha_insert_for_fold_func(
 
 	prev_node = static_cast<ha_node_t*>(cell->node);
 
+	ulint*	version = ha_chain_version(table, fold);
+	ha_chain_version_inc(version);
+
 	while (prev_node != NULL) {
 		if (prev_node->fold == fold) {
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
@@ -253,6 +264,7 @@ ha_insert_for_fold_func(
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 			prev_node->data = data;
 
+			ha_chain_version_inc(version);
 			return(TRUE);
 		}
 
@@ -270,6 +282,7 @@ ha_insert_for_fold_func(
 
 		ut_ad(hash_get_heap(table, fold)->type & MEM_HEAP_BTR_SEARCH);
 
+		ha_chain_version_inc(version);
 		return(FALSE);
 	}
 
@@ -292,6 +305,7 @@ ha_insert_for_fold_func(
 
 		cell->node = node;
 
+		ha_chain_version_inc(version);
 		return(TRUE);
 	}
 
@@ -302,6 +316,7 @@ ha_insert_for_fold_func(
 
 	prev_node->next = node;
 
+	ha_chain_version_inc(version);
 	return(TRUE);
 }
 
@@ -344,7 +359,42 @@ ha_delete_hash_node(
 	}
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 
+	/* Besides the chain of del_node, HASH_DELETE_AND_COMPACT()
+	modifies the chain of the node that it moves in place of
+	del_node. */
+	ulint*	version = ha_chain_version(table, del_node->fold);
+	ulint*	top_version = ha_chain_version(
+		table,
+		static_cast<ha_node_t*>(
+			mem_heap_get_top(hash_get_heap(table, del_node->fold),
+					 sizeof(ha_node_t)))->fold);
+
+	ha_chain_version_inc(version);
+
+	if (top_version != version) {
+		ha_chain_version_inc(top_version);
+	}
+
 	HASH_DELETE_AND_COMPACT(ha_node_t, next, table, del_node);
+
+	if (top_version != version) {
+		ha_chain_version_inc(top_version);
+	}
+
+	ha_chain_version_inc(version);
+}
+
+/** Mark all hash chains of the adaptive hash index partition as being
+modified or no longer modified, around hash_table_clear().
+@param[in,out]	table	hash table */
+void
+ha_chain_version_inc_all(hash_table_t* table)
+{
+	ut_d(ha_btr_search_latch_x_locked(table));
+
+	for (ulint i = 0; i < HA_N_VERSIONS; i++) {
+		ha_chain_version_inc(&table->versions[i].version);
+	}
 }
 
 /*********************************************************//**
@@ -390,7 +440,10 @@ ha_search_and_update_if_found_func(
 
 		node->block = new_block;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
+		ulint*	version = ha_chain_version(table, fold);
+		ha_chain_version_inc(version);
 		node->data = new_data;
+		ha_chain_version_inc(version);
 
 		return(TRUE);
 	}
@@ -123,6 +123,9 @@ hash_create(
 	table->sync_obj.mutexes = NULL;
 	table->heaps = NULL;
 	table->heap = NULL;
+#ifdef BTR_CUR_HASH_ADAPT
+	table->versions = NULL;
+#endif /* BTR_CUR_HASH_ADAPT */
 	ut_d(table->magic_n = HASH_TABLE_MAGIC_N);
 
 	/* Initialize the cell array */
@@ -140,6 +143,9 @@ hash_table_free(
 {
 	ut_ad(table->magic_n == HASH_TABLE_MAGIC_N);
 
+#ifdef BTR_CUR_HASH_ADAPT
+	ut_free(table->versions);
+#endif /* BTR_CUR_HASH_ADAPT */
 	ut_free(table->array);
 	ut_free(table);
 }
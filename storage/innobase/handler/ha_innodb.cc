@@ -211,6 +211,7 @@ static char*	innobase_enable_monitor_counter;
 static char*	innobase_disable_monitor_counter;
 static char*	innobase_reset_monitor_counter;
 static char*	innobase_reset_all_monitor_counter;
+static char*	innodb_compression_dictionary;
 
 static char*	innobase_file_flush_method;
 
@@ -569,6 +570,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 #  endif /* !PFS_SKIP_BUFFER_MUTEX_RWLOCK */
 	PSI_KEY(buf_pool_mutex),
 	PSI_KEY(buf_pool_zip_mutex),
+	PSI_KEY(buf_index_stats_mutex),
 	PSI_KEY(cache_last_read_mutex),
 	PSI_KEY(dict_foreign_err_mutex),
 	PSI_KEY(dict_sys_mutex),
@@ -608,6 +610,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(srv_sys_mutex),
 	PSI_KEY(lock_mutex),
 	PSI_KEY(lock_wait_mutex),
+	PSI_KEY(lock_shard_mutex),
 	PSI_KEY(trx_mutex),
 	PSI_KEY(srv_threads_mutex),
 #  ifndef PFS_SKIP_EVENT_MUTEX
@@ -644,7 +647,8 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	PSI_RWLOCK_KEY(index_tree_rw_lock),
 	PSI_RWLOCK_KEY(index_online_log),
 	PSI_RWLOCK_KEY(dict_table_stats),
-	PSI_RWLOCK_KEY(hash_table_locks)
+	PSI_RWLOCK_KEY(hash_table_locks),
+	PSI_RWLOCK_KEY(lock_shards_latch)
 };
 # endif /* UNIV_PFS_RWLOCK */
 
@@ -654,6 +658,7 @@ performance schema instrumented if "UNIV_PFS_THREAD"
 is defined */
 static PSI_thread_info	all_innodb_threads[] = {
 	PSI_KEY(buf_dump_thread),
+	PSI_KEY(buf_lru_manager_thread),
 	PSI_KEY(dict_stats_thread),
 	PSI_KEY(io_handler_thread),
 	PSI_KEY(io_ibuf_thread),
@@ -662,8 +667,11 @@ static PSI_thread_info	all_innodb_threads[] = {
 	PSI_KEY(io_write_thread),
 	PSI_KEY(page_cleaner_thread),
 	PSI_KEY(recv_writer_thread),
+	PSI_KEY(recv_apply_thread),
+	PSI_KEY(row_merge_pscan_thread),
 	PSI_KEY(srv_error_monitor_thread),
 	PSI_KEY(srv_lock_timeout_thread),
+	PSI_KEY(srv_lock_deadlock_thread),
 	PSI_KEY(srv_master_thread),
 	PSI_KEY(srv_monitor_thread),
 	PSI_KEY(srv_purge_thread),
@@ -884,6 +892,7 @@ static ibool innodb_have_lz4=IF_LZ4(1, 0);
 static ibool innodb_have_lzma=IF_LZMA(1, 0);
 static ibool innodb_have_bzip2=IF_BZIP2(1, 0);
 static ibool innodb_have_snappy=IF_SNAPPY(1, 0);
+static ibool innodb_have_zstd=IF_ZSTD(1, 0);
 static ibool innodb_have_punch_hole=IF_PUNCH_HOLE(1, 0);
 
 static
@@ -904,6 +913,16 @@ static MYSQL_THDVAR_BOOL(table_locks, PLUGIN_VAR_OPCMDARG,
   /* check_func */ NULL, /* update_func */ NULL,
   /* default */ TRUE);
 
+static MYSQL_THDVAR_BOOL(bulk_insert, PLUGIN_VAR_OPCMDARG,
+  "Load rows into an empty table without undo logging of the rows."
+  " The table will be locked exclusively, and a rollback will empty it.",
+  NULL, NULL, FALSE);
+
+static MYSQL_THDVAR_BOOL(intrinsic_temp_tables, PLUGIN_VAR_OPCMDARG,
+  "Create TEMPORARY tables without undo logging, so that changes to them"
+  " cannot be rolled back. Tables with SPATIAL indexes are not affected.",
+  NULL, NULL, FALSE);
+
 static MYSQL_THDVAR_BOOL(strict_mode, PLUGIN_VAR_OPCMDARG,
   "Use strict mode when evaluating create options.",
   NULL, NULL, TRUE);
@@ -1080,6 +1099,8 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &innodb_have_bzip2,		  SHOW_BOOL},
   {"have_snappy",
   (char*) &innodb_have_snappy,		  SHOW_BOOL},
+  {"have_zstd",
+  (char*) &innodb_have_zstd,		  SHOW_BOOL},
   {"have_punch_hole",
   (char*) &innodb_have_punch_hole,	  SHOW_BOOL},
 
@@ -1101,6 +1122,10 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_onlineddl_rowlog_pct_used, SHOW_LONG},
   {"onlineddl_pct_progress",
   (char*) &export_vars.innodb_onlineddl_pct_progress, SHOW_LONG},
+  {"onlineddl_rowlog_blocks_parallel",
+  (char*) &export_vars.innodb_onlineddl_rowlog_blocks_parallel, SHOW_LONG},
+  {"onlineddl_rowlog_background_applies",
+  (char*) &export_vars.innodb_onlineddl_rowlog_background_applies, SHOW_LONG},
 
   /* Times secondary index lookup triggered cluster lookup and
   times prefix optimization avoided triggering cluster lookup */
@@ -2724,6 +2749,8 @@ innobase_trx_init(
 	trx->check_unique_secondary = !thd_test_options(
 		thd, OPTION_RELAXED_UNIQUE_CHECKS);
 
+	trx->bulk_insert = THDVAR(thd, bulk_insert);
+
 	DBUG_VOID_RETURN;
 }
 
@@ -3781,6 +3808,15 @@ innobase_init(
 	}
 #endif
 
+#ifndef HAVE_ZSTD
+	if (innodb_compression_algorithm == PAGE_ZSTD_ALGORITHM) {
+		sql_print_error("InnoDB: innodb_compression_algorithm = %lu unsupported.\n"
+				"InnoDB: libzstd is not installed. \n",
+				innodb_compression_algorithm);
+		goto error;
+	}
+#endif
+
 	if ((srv_encrypt_tables || srv_encrypt_log)
 	     && !encryption_key_id_exists(FIL_DEFAULT_ENCRYPTION_KEY)) {
 		sql_print_error("InnoDB: cannot enable encryption, "
@@ -11154,6 +11190,16 @@ create_table_info_t::create_table_def()
 		      != REC_FORMAT_COMPRESSED);
 		table->space_id = SRV_TMP_SPACE_ID;
 		table->space = fil_system.temp_space;
+		table->intrinsic = THDVAR(m_thd, intrinsic_temp_tables);
+
+		/* Records cannot be removed from SPATIAL INDEX
+		without delete-marking them first. */
+		for (i = 0; i < m_form->s->keys; i++) {
+			if (m_form->key_info[i].flags & HA_SPATIAL) {
+				table->intrinsic = false;
+			}
+		}
+
 		table->add_to_cache();
 	} else {
 		if (err == DB_SUCCESS) {
@@ -17512,6 +17558,98 @@ innodb_internal_table_update(
 	}
 }
 
+/** Validate SET GLOBAL innodb_compression_dictionary='db/table'
+by training a Zstandard dictionary for the page_compressed table.
+@param[in]	thd	connection
+@param[out]	save	immediate result for innodb_compression_dictionary_update()
+@param[in]	value	incoming string
+@return 0 if the dictionary was created */
+static
+int
+innodb_compression_dictionary_validate(
+	THD*				thd,
+	struct st_mysql_sys_var*,
+	void*				save,
+	struct st_mysql_value*		value)
+{
+	char		buff[STRING_BUFFER_USUAL_SIZE];
+	int		len = sizeof(buff);
+	const char*	table_name = value->val_str(value, buff, &len);
+
+	if (!table_name) {
+		*static_cast<const char**>(save) = NULL;
+		return(0);
+	}
+
+	dict_table_t*	table = dict_table_open_on_name(
+		table_name, FALSE, TRUE, DICT_ERR_IGNORE_NONE);
+
+	if (!table) {
+		push_warning_printf(thd, Sql_condition::WARN_LEVEL_WARN,
+				    ER_WRONG_ARGUMENTS,
+				    "InnoDB: Table %s does not exist.",
+				    table_name);
+		return(1);
+	}
+
+	dberr_t	err = DB_TABLESPACE_NOT_FOUND;
+
+	if (fil_space_t* space = fil_space_acquire(table->space_id)) {
+		err = fil_zstd_dict_train(space);
+		fil_space_release(space);
+	}
+
+	dict_table_close(table, FALSE, TRUE);
+
+	const char*	msg;
+
+	switch (err) {
+	case DB_SUCCESS:
+		*static_cast<const char**>(save) = table_name;
+		return(0);
+	case DB_UNSUPPORTED:
+		msg = IF_ZSTD("is not PAGE_COMPRESSED=1",
+			      "cannot be trained because libzstd"
+			      " is not installed");
+		break;
+	case DB_DUPLICATE_KEY:
+		msg = "already has a dictionary";
+		break;
+	case DB_ERROR:
+		msg = "does not have enough index pages";
+		break;
+	default:
+		msg = ut_strerr(err);
+	}
+
+	push_warning_printf(thd, Sql_condition::WARN_LEVEL_WARN,
+			    ER_WRONG_ARGUMENTS,
+			    "InnoDB: Zstandard dictionary for table %s: %s.",
+			    table_name, msg);
+	return(1);
+}
+
+/** Remember the table of the last SET GLOBAL innodb_compression_dictionary.
+@param[in]	thd	connection
+@param[out]	var_ptr	innodb_compression_dictionary
+@param[in]	save	immediate result from
+			innodb_compression_dictionary_validate() */
+static
+void
+innodb_compression_dictionary_update(
+	THD*,
+	struct st_mysql_sys_var*,
+	void*				var_ptr,
+	const void*			save)
+{
+	const char*	table_name = *static_cast<const char*const*>(save);
+	char*		old = *static_cast<char**>(var_ptr);
+
+	*static_cast<char**>(var_ptr) = table_name
+		? my_strdup(table_name, MYF(0)) : NULL;
+	my_free(old);
+}
+
 #ifdef BTR_CUR_HASH_ADAPT
 /****************************************************************//**
 Update the system variable innodb_adaptive_hash_index using the "saved"
@@ -17560,6 +17698,29 @@ innodb_cmp_per_index_update(
 	srv_cmp_per_index_enabled = !!(*(my_bool*) save);
 }
 
+/****************************************************************//**
+Update the system variable innodb_deadlock_detect_background using the
+"saved" value. This function is registered as a callback with MySQL. */
+static
+void
+innodb_deadlock_detect_background_update(
+/*=====================================*/
+	THD*				thd,	/*!< in: thread handle */
+	struct st_mysql_sys_var*	var,	/*!< in: pointer to
+						system variable */
+	void*				var_ptr,/*!< out: where the
+						formal string goes */
+	const void*			save)	/*!< in: immediate result
+						from check function */
+{
+	innobase_deadlock_detect_background = *(my_bool*) save;
+
+	if (innobase_deadlock_detect_background && !srv_read_only_mode
+	    && srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+		lock_deadlock_detect_start();
+	}
+}
+
 /****************************************************************//**
 Update the system variable innodb_old_blocks_pct using the "saved"
 value. This function is registered as a callback with MySQL. */
@@ -19336,6 +19497,14 @@ static MYSQL_SYSVAR_BOOL(doublewrite, innobase_use_doublewrite,
   " Disable with --skip-innodb-doublewrite.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(doublewrite_files, srv_doublewrite_files,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of files ib_dblwr0, ib_dblwr1, ... in innodb_data_home_dir for"
+  " the doublewrite buffer of page flush batches. Different buffer pool"
+  " instances are written to different files in parallel. 0 (the default)"
+  " uses the doublewrite buffer in the system tablespace.",
+  NULL, NULL, 0, 0, MAX_BUFFER_POOLS, 0);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, innobase_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Enable atomic writes, instead of using the doublewrite buffer, for files "
@@ -19581,6 +19750,14 @@ static MYSQL_SYSVAR_BOOL(stats_auto_recalc, srv_stats_auto_recalc,
   " new statistics)",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(stats_incremental, srv_stats_incremental,
+  PLUGIN_VAR_OPCMDARG,
+  "Whether the automatic recalculation of persistent statistics samples"
+  " fewer leaf pages, in proportion to the rows modified since the last"
+  " recalculation, and merges the result into the previous estimates"
+  " (ANALYZE TABLE always recalculates from scratch)",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONGLONG(stats_persistent_sample_pages,
   srv_stats_persistent_sample_pages,
   PLUGIN_VAR_RQCMDARG,
@@ -19728,6 +19905,11 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_dump_pct, srv_buf_pool_dump_pct,
   "Dump only the hottest N% of each buffer pool, defaults to 25",
   NULL, NULL, 25, 1, 100, 0);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_load_threads, srv_buf_pool_load_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that read pages in parallel during a buffer pool load",
+  NULL, NULL, 4, 1, 64, 0);
+
 #ifdef UNIV_DEBUG
 /* Added to test the innodb_buffer_pool_load_incomplete status variable. */
 static MYSQL_SYSVAR_ULONG(buffer_pool_load_pages_abort, srv_buf_pool_load_pages_abort,
@@ -19816,6 +19998,14 @@ static MYSQL_SYSVAR_ULONG(lru_scan_depth, srv_LRU_scan_depth,
   "How deep to scan LRU to keep it clean",
   NULL, NULL, 1024, 100, ~0UL, 0);
 
+static MYSQL_SYSVAR_BOOL(lru_manager, srv_lru_manager,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Use a dedicated thread per buffer pool instance to flush and evict"
+  " pages from the tail of the LRU list, so that the page cleaner"
+  " threads only flush the flush list and user threads never flush"
+  " single pages to find a free block",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(flush_neighbors, srv_flush_neighbors,
   PLUGIN_VAR_OPCMDARG,
   "Set to 0 (don't flush neighbors from buffer pool),"
@@ -19841,6 +20031,15 @@ static MYSQL_SYSVAR_BOOL(deadlock_detect, innobase_deadlock_detect,
   " and we rely on innodb_lock_wait_timeout in case of deadlock.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(deadlock_detect_background,
+  innobase_deadlock_detect_background,
+  PLUGIN_VAR_OPCMDARG,
+  "Whether deadlocks are detected by a background thread that searches"
+  " a snapshot of the wait-for graph, instead of by each transaction"
+  " when it starts to wait for a lock. Waits that must be reported to"
+  " parallel replication are still checked when they start.",
+  NULL, innodb_deadlock_detect_background_update, FALSE);
+
 static MYSQL_SYSVAR_LONG(fill_factor, innobase_fill_factor,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of B-tree page filled during bulk insert",
@@ -19892,6 +20091,12 @@ static MYSQL_SYSVAR_ULONG(ft_num_word_optimize, fts_num_word_optimize,
   "InnoDB Fulltext search number of words to optimize for each optimize table call ",
   NULL, NULL, 2000, 1000, 10000, 0);
 
+static MYSQL_SYSVAR_ULONG(ft_optimize_threads, fts_optimize_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "InnoDB Fulltext search number of threads that optimize different tables"
+  " in the background",
+  NULL, NULL, 1, 1, 16, 0);
+
 static MYSQL_SYSVAR_ULONG(ft_sort_pll_degree, fts_sort_pll_degree,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "InnoDB Fulltext search parallel sort degree, will round up to nearest power of 2 number",
@@ -19902,6 +20107,19 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(alter_scan_threads, srv_alter_scan_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that scan key ranges of the clustered index"
+  " in parallel when adding secondary indexes (1=disable)",
+  NULL, NULL, 1, 1, 64, 0);
+
+static MYSQL_SYSVAR_ULONG(alter_log_apply_threads, srv_alter_log_apply_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that apply the log of concurrent DML to a table"
+  " that is being rebuilt online, partitioned by PRIMARY KEY; also"
+  " keeps applying the log until the ALTER TABLE is committed (1=disable)",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -19917,6 +20135,12 @@ static MYSQL_SYSVAR_ULONG(read_io_threads, innobase_read_io_threads,
   "Number of background read I/O threads in InnoDB.",
   NULL, NULL, 4, 1, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(recovery_threads, srv_n_recovery_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads applying redo log to buffer pool pages"
+  " during crash recovery.",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(write_io_threads, innobase_write_io_threads,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Number of background write I/O threads in InnoDB.",
@@ -19957,6 +20181,13 @@ static MYSQL_SYSVAR_ULONG(log_write_ahead_size, srv_log_write_ahead_size,
   NULL, innodb_log_write_ahead_size_update,
   8*1024L, OS_FILE_LOG_BLOCK_SIZE, UNIV_PAGE_SIZE_DEF, OS_FILE_LOG_BLOCK_SIZE);
 
+static MYSQL_SYSVAR_BOOL(log_writer_threads, srv_log_writer_threads,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Write and flush the redo log in dedicated background threads;"
+  " committing transactions wait for them instead of writing the log"
+  " themselves",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_UINT(old_blocks_pct, innobase_old_blocks_pct,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of the buffer pool to reserve for 'old' blocks.",
@@ -20092,6 +20323,14 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform.",
   NULL, NULL, TRUE);
 
+#ifdef HAVE_URING
+static MYSQL_SYSVAR_BOOL(use_io_uring, srv_use_io_uring,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Use io_uring for asynchronous I/O if supported by the kernel;"
+  " takes precedence over innodb_use_native_aio.",
+  NULL, NULL, FALSE);
+#endif /* HAVE_URING */
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
@@ -20189,6 +20428,12 @@ static MYSQL_SYSVAR_ULONG(read_ahead_threshold, srv_read_ahead_threshold,
   " trigger a readahead.",
   NULL, NULL, 56, 0, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(clustered_read_ahead, srv_clustered_read_ahead,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of secondary index records ahead of a range scan for which the"
+  " clustered index leaf pages are read ahead asynchronously (0=disable)",
+  NULL, NULL, 0, 0, 1024, 0);
+
 static MYSQL_SYSVAR_STR(monitor_enable, innobase_enable_monitor_counter,
   PLUGIN_VAR_RQCMDARG,
   "Turn on a monitor counter",
@@ -20333,15 +20578,23 @@ static MYSQL_SYSVAR_BOOL(force_primary_key,
   "Do not allow to create table without primary key (off by default)",
   NULL, NULL, FALSE);
 
-static const char *page_compression_algorithms[]= { "none", "zlib", "lz4", "lzo", "lzma", "bzip2", "snappy", 0 };
+static const char *page_compression_algorithms[]= { "none", "zlib", "lz4", "lzo", "lzma", "bzip2", "snappy", "zstd", 0 };
 static TYPELIB page_compression_algorithms_typelib=
 {
   array_elements(page_compression_algorithms) - 1, 0,
   page_compression_algorithms, 0
 };
+static MYSQL_SYSVAR_STR(compression_dictionary, innodb_compression_dictionary,
+  PLUGIN_VAR_RQCMDARG,
+  "Train a Zstandard dictionary for the named PAGE_COMPRESSED table"
+  " (database/table), store it in the tablespace and use it for"
+  " innodb_compression_algorithm=zstd",
+  innodb_compression_dictionary_validate,
+  innodb_compression_dictionary_update, NULL);
+
 static MYSQL_SYSVAR_ENUM(compression_algorithm, innodb_compression_algorithm,
   PLUGIN_VAR_OPCMDARG,
-  "Compression algorithm used on page compression. One of: none, zlib, lz4, lzo, lzma, or bzip2",
+  "Compression algorithm used on page compression. One of: none, zlib, lz4, lzo, lzma, bzip2, snappy, or zstd",
   innodb_compression_algorithm_validate, NULL,
   /* We use here the largest number of supported compression method to
   enable all those methods that are available. Availability of compression
@@ -20474,6 +20727,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_dump_now),
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
   MYSQL_SYSVAR(buffer_pool_dump_pct),
+  MYSQL_SYSVAR(buffer_pool_load_threads),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_evict),
 #endif /* UNIV_DEBUG */
@@ -20490,6 +20744,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(defragment_fill_factor_n_recs),
   MYSQL_SYSVAR(defragment_frequency),
   MYSQL_SYSVAR(lru_scan_depth),
+  MYSQL_SYSVAR(lru_manager),
   MYSQL_SYSVAR(flush_neighbors),
   MYSQL_SYSVAR(checksum_algorithm),
   MYSQL_SYSVAR(log_checksums),
@@ -20501,10 +20756,12 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(temp_data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(doublewrite_files),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(use_atomic_writes),
   MYSQL_SYSVAR(fast_shutdown),
   MYSQL_SYSVAR(read_io_threads),
+  MYSQL_SYSVAR(recovery_threads),
   MYSQL_SYSVAR(write_io_threads),
   MYSQL_SYSVAR(file_per_table),
   MYSQL_SYSVAR(flush_log_at_timeout),
@@ -20519,17 +20776,20 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(ft_max_token_size),
   MYSQL_SYSVAR(ft_min_token_size),
   MYSQL_SYSVAR(ft_num_word_optimize),
+  MYSQL_SYSVAR(ft_optimize_threads),
   MYSQL_SYSVAR(ft_sort_pll_degree),
   MYSQL_SYSVAR(force_load_corrupted),
   MYSQL_SYSVAR(lock_schedule_algorithm),
   MYSQL_SYSVAR(locks_unsafe_for_binlog),
   MYSQL_SYSVAR(lock_wait_timeout),
   MYSQL_SYSVAR(deadlock_detect),
+  MYSQL_SYSVAR(deadlock_detect_background),
   MYSQL_SYSVAR(page_size),
   MYSQL_SYSVAR(log_buffer_size),
   MYSQL_SYSVAR(log_file_size),
   MYSQL_SYSVAR(log_files_in_group),
   MYSQL_SYSVAR(log_write_ahead_size),
+  MYSQL_SYSVAR(log_writer_threads),
   MYSQL_SYSVAR(log_group_home_dir),
   MYSQL_SYSVAR(log_compressed_pages),
   MYSQL_SYSVAR(max_dirty_pages_pct),
@@ -20555,6 +20815,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_transient_sample_pages),
   MYSQL_SYSVAR(stats_persistent),
   MYSQL_SYSVAR(stats_persistent_sample_pages),
+  MYSQL_SYSVAR(stats_incremental),
   MYSQL_SYSVAR(stats_auto_recalc),
   MYSQL_SYSVAR(stats_modified_counter),
   MYSQL_SYSVAR(stats_traditional),
@@ -20567,10 +20828,14 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(alter_scan_threads),
+  MYSQL_SYSVAR(alter_log_apply_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
   MYSQL_SYSVAR(table_locks),
+  MYSQL_SYSVAR(bulk_insert),
+  MYSQL_SYSVAR(intrinsic_temp_tables),
   MYSQL_SYSVAR(thread_concurrency),
   MYSQL_SYSVAR(adaptive_max_sleep_delay),
   MYSQL_SYSVAR(prefix_index_cluster_optimization),
@@ -20579,6 +20844,9 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(autoinc_lock_mode),
   MYSQL_SYSVAR(version),
   MYSQL_SYSVAR(use_native_aio),
+#ifdef HAVE_URING
+  MYSQL_SYSVAR(use_io_uring),
+#endif /* HAVE_URING */
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
 #endif /* HAVE_LIBNUMA */
@@ -20593,6 +20861,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif /* WITH_INNODB_DISALLOW_WRITES */
   MYSQL_SYSVAR(random_read_ahead),
   MYSQL_SYSVAR(read_ahead_threshold),
+  MYSQL_SYSVAR(clustered_read_ahead),
   MYSQL_SYSVAR(read_only),
   MYSQL_SYSVAR(io_capacity),
   MYSQL_SYSVAR(io_capacity_max),
@@ -20648,6 +20917,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   /* Table page compression feature */
   MYSQL_SYSVAR(compression_default),
   MYSQL_SYSVAR(compression_algorithm),
+  MYSQL_SYSVAR(compression_dictionary),
   /* Encryption feature */
   MYSQL_SYSVAR(encrypt_tables),
   MYSQL_SYSVAR(encryption_threads),
@@ -20700,6 +20970,7 @@ i_s_innodb_cmp_per_index_reset,
 i_s_innodb_buffer_page,
 i_s_innodb_buffer_page_lru,
 i_s_innodb_buffer_stats,
+i_s_innodb_cached_indexes,
 i_s_innodb_metrics,
 i_s_innodb_ft_default_stopword,
 i_s_innodb_ft_deleted,
@@ -21629,6 +21900,17 @@ innodb_compression_algorithm_validate(
 		DBUG_RETURN(1);
 	}
 #endif
+
+#ifndef HAVE_ZSTD
+	if (compression_algorithm == PAGE_ZSTD_ALGORITHM) {
+		push_warning_printf(thd, Sql_condition::WARN_LEVEL_WARN,
+				    HA_ERR_UNSUPPORTED,
+				    "InnoDB: innodb_compression_algorithm = %lu unsupported.\n"
+				    "InnoDB: libzstd is not installed. \n",
+				    compression_algorithm);
+		DBUG_RETURN(1);
+	}
+#endif
 	DBUG_RETURN(0);
 }
 
@@ -193,6 +193,15 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 	const char**	drop_vcol_name;
 	/** ALTER TABLE stage progress recorder */
 	ut_stage_alter_t* m_stage;
+	/** signalled to stop log_apply_thread, or NULL if not running */
+	os_event_t	log_apply_stop;
+	/** thread that applies the table-rebuild log between
+	inplace_alter_table() and commit_inplace_alter_table() */
+	os_thread_t	log_apply_thread;
+	/** table for reporting duplicates in log_apply_thread */
+	TABLE*		log_apply_table;
+	/** outcome of log_apply_thread */
+	dberr_t		log_apply_error;
 	/** original number of user columns in the table */
 	const unsigned	old_n_cols;
 	/** original columns of the table */
@@ -241,6 +250,9 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 		drop_vcol(0),
 		drop_vcol_name(0),
 		m_stage(NULL),
+		log_apply_stop(NULL),
+		log_apply_table(NULL),
+		log_apply_error(DB_SUCCESS),
 		old_n_cols(prebuilt_arg->table->n_cols),
 		old_cols(prebuilt_arg->table->cols),
 		old_col_names(prebuilt_arg->table->col_names)
@@ -261,6 +273,7 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 
 	~ha_innobase_inplace_ctx()
 	{
+		stop_log_apply();
 		UT_DELETE(m_stage);
 		if (instant_table) {
 			while (dict_index_t* index
@@ -278,6 +291,20 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 	@return whether the table will be rebuilt */
 	bool need_rebuild () const { return(old_table != new_table); }
 
+	/** Stop applying the table-rebuild log in the background.
+	@return the outcome of the background log apply */
+	dberr_t stop_log_apply()
+	{
+		if (log_apply_stop) {
+			os_event_set(log_apply_stop);
+			os_thread_join(log_apply_thread);
+			os_event_destroy(log_apply_stop);
+			log_apply_stop = NULL;
+		}
+
+		return(log_apply_error);
+	}
+
 	/** Convert table-rebuilding ALTER to instant ALTER. */
 	void prepare_instant()
 	{
@@ -6949,6 +6976,62 @@ get_error_key_name(
 	}
 }
 
+/** Thread that keeps applying the table-rebuild log while
+ALTER TABLE is waiting for the exclusive meta-data lock, so that
+little work remains to be done in commit_inplace_alter_table().
+@param[in,out]	arg	ha_innobase_inplace_ctx
+@return OS_THREAD_DUMMY_RETURN */
+static
+os_thread_ret_t
+DECLARE_THREAD(innobase_online_log_apply_thread)(void* arg)
+{
+	ha_innobase_inplace_ctx*	ctx
+		= static_cast<ha_innobase_inplace_ctx*>(arg);
+	/* The progress is only reported by the ALTER TABLE thread. */
+	ut_stage_alter_t		stage(
+		dict_table_get_first_index(ctx->old_table));
+
+	do {
+		ctx->log_apply_error = row_log_table_apply(
+			ctx->thr, ctx->old_table, ctx->log_apply_table,
+			&stage);
+		srv_stats.n_rowlog_background_applies.inc();
+	} while (ctx->log_apply_error == DB_SUCCESS
+		 && os_event_wait_time(ctx->log_apply_stop, 10000)
+		 == OS_SYNC_TIME_EXCEEDED);
+
+	os_thread_exit(false);
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start applying the table-rebuild log in the background until
+commit_inplace_alter_table().
+@param[in,out]	ctx		online table-rebuilding ALTER TABLE
+@param[in]	altered_table	TABLE object for new version of table */
+static
+void
+innobase_online_log_apply_start(
+	ha_innobase_inplace_ctx*	ctx,
+	TABLE*				altered_table)
+{
+	DBUG_ASSERT(ctx->online);
+	DBUG_ASSERT(ctx->need_rebuild());
+	DBUG_ASSERT(!ctx->log_apply_stop);
+
+	if (srv_alter_log_apply_threads <= 1
+	    || ctx->new_table->n_v_cols
+	    || !dict_index_is_online_ddl(
+		    dict_table_get_first_index(ctx->old_table))) {
+		return;
+	}
+
+	ctx->log_apply_table = altered_table;
+	ctx->log_apply_error = DB_SUCCESS;
+	ctx->log_apply_stop = os_event_create(0);
+	ctx->log_apply_thread = os_thread_create(
+		innobase_online_log_apply_thread, ctx, NULL);
+}
+
 /** Alter the table structure in-place with operations
 specified using Alter_inplace_info.
 The level of concurrency allowed during this operation depends
@@ -7132,6 +7215,9 @@ ha_innobase::inplace_alter_table(
 		ut_d(mutex_exit(&dict_sys->mutex));
 		/* prebuilt->table->n_ref_count can be anything here,
 		given that we hold at most a shared lock on the table. */
+		if (ctx->online && ctx->need_rebuild()) {
+			innobase_online_log_apply_start(ctx, altered_table);
+		}
 		goto ok_exit;
 	case DB_DUPLICATE_KEY:
 		if (m_prebuilt->trx->error_key_num == ULINT_UNDEFINED
@@ -8380,10 +8466,16 @@ commit_try_rebuild(
 			ctx->new_table->vc_templ = s_templ;
 		}
 
-		error = row_log_table_apply(
-			ctx->thr, user_table, altered_table,
-			static_cast<ha_innobase_inplace_ctx*>(
-				ha_alter_info->handler_ctx)->m_stage);
+		/* Any error from the background log apply was
+		reported in altered_table and trx->error_key_num. */
+		error = ctx->log_apply_error;
+
+		if (error == DB_SUCCESS) {
+			error = row_log_table_apply(
+				ctx->thr, user_table, altered_table,
+				static_cast<ha_innobase_inplace_ctx*>(
+					ha_alter_info->handler_ctx)->m_stage);
+		}
 
 		if (s_templ) {
 			ut_ad(ctx->need_rebuild());
@@ -9050,6 +9142,10 @@ ha_innobase::commit_inplace_alter_table(
 		most have created some indexes. If any indexes were to
 		be dropped, they would actually be dropped in this
 		method if commit=true. */
+		if (ctx0 != NULL) {
+			ctx0->stop_log_apply();
+		}
+
 		const bool	ret = rollback_inplace_alter_table(
 			ha_alter_info, table, m_prebuilt);
 		DBUG_RETURN(ret);
@@ -9079,6 +9175,13 @@ ha_innobase::commit_inplace_alter_table(
 	ut_ad(m_prebuilt->table == ctx0->old_table);
 	ha_alter_info->group_commit_ctx = NULL;
 
+	/* We are holding MDL_EXCLUSIVE. Apply the rest of the
+	table-rebuild log in commit_try_rebuild(). */
+	for (inplace_alter_handler_ctx** pctx = ctx_array; *pctx; pctx++) {
+		static_cast<ha_innobase_inplace_ctx*>(*pctx)
+			->stop_log_apply();
+	}
+
 	/* Free the ctx->trx of other partitions, if any. We will only
 	use the ctx0->trx here. Others may have been allocated in
 	the prepare stage. */
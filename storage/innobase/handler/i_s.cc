@@ -5914,6 +5914,305 @@ UNIV_INTERN struct st_maria_plugin	i_s_innodb_buffer_page_lru =
         STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
 };
 
+/* Fields of the dynamic table INFORMATION_SCHEMA.INNODB_CACHED_INDEXES */
+static ST_FIELD_INFO	i_s_innodb_cached_indexes_fields_info[] =
+{
+#define IDX_CACHED_INDEX_SPACE_ID		0
+	{STRUCT_FLD(field_name,		"SPACE_ID"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_CACHED_INDEX_INDEX_ID		1
+	{STRUCT_FLD(field_name,		"INDEX_ID"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_CACHED_INDEX_TABLE_NAME		2
+	{STRUCT_FLD(field_name,		"TABLE_NAME"),
+	 STRUCT_FLD(field_length,	1024),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_MAYBE_NULL),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_CACHED_INDEX_INDEX_NAME		3
+	{STRUCT_FLD(field_name,		"INDEX_NAME"),
+	 STRUCT_FLD(field_length,	1024),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_MAYBE_NULL),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_CACHED_INDEX_N_PAGES		4
+	{STRUCT_FLD(field_name,		"N_CACHED_PAGES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_CACHED_INDEX_N_DIRTY		5
+	{STRUCT_FLD(field_name,		"N_DIRTY_PAGES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_CACHED_INDEX_N_READ		6
+	{STRUCT_FLD(field_name,		"N_PAGES_READ"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_CACHED_INDEX_N_YOUNG		7
+	{STRUCT_FLD(field_name,		"N_PAGES_MADE_YOUNG"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+	END_OF_ST_FIELD_INFO
+};
+
+/** Table and index names of INFORMATION_SCHEMA.INNODB_CACHED_INDEXES,
+keyed by (tablespace id, index id) */
+typedef std::map<
+	std::pair<ulint, index_id_t>,
+	std::pair<std::string, std::string>,
+	std::less<std::pair<ulint, index_id_t> >,
+	ut_allocator<std::pair<const std::pair<ulint, index_id_t>,
+			       std::pair<std::string, std::string> > > >
+	i_s_cached_index_names_t;
+
+/** Look up the names of the indexes that have pages in the buffer pool,
+in a single pass over the data dictionary cache.
+@param[in]	thd	thread
+@param[in]	stats	page counters of the indexes
+@param[out]	names	table and index names of those indexes that
+			are in the data dictionary cache */
+static
+void
+i_s_innodb_cached_indexes_get_names(
+	THD*				thd,
+	const buf_index_stats_t&	stats,
+	i_s_cached_index_names_t&	names)
+{
+	if (stats.empty()) {
+		return;
+	}
+
+	mutex_enter(&dict_sys->mutex);
+
+	const dict_table_t*	lists[] = {
+		UT_LIST_GET_FIRST(dict_sys->table_LRU),
+		UT_LIST_GET_FIRST(dict_sys->table_non_LRU)
+	};
+
+	for (ulint i = 0; i < UT_ARR_SIZE(lists); i++) {
+		for (const dict_table_t* table = lists[i]; table != NULL;
+		     table = UT_LIST_GET_NEXT(table_LRU, table)) {
+
+			for (const dict_index_t* index
+				     = dict_table_get_first_index(table);
+			     index != NULL;
+			     index = dict_table_get_next_index(index)) {
+
+				const std::pair<ulint, index_id_t> key(
+					table->space_id, index->id);
+
+				if (stats.find(key) == stats.end()) {
+					continue;
+				}
+
+				char		name[MAX_FULL_NAME_LEN + 1];
+				const char*	name_end = innobase_convert_name(
+					name, sizeof(name),
+					table->name.m_name,
+					strlen(table->name.m_name), thd);
+
+				names[key] = std::make_pair(
+					std::string(name,
+						    ulint(name_end - name)),
+					std::string(index->name));
+			}
+		}
+	}
+
+	mutex_exit(&dict_sys->mutex);
+}
+
+/*******************************************************************//**
+Fill the dynamic table INFORMATION_SCHEMA.INNODB_CACHED_INDEXES
+from the page counters that the buffer pool maintains for each index.
+Unlike INNODB_BUFFER_PAGE, this does not walk the buffer pool.
+@return 0 on success, 1 on failure */
+static
+int
+i_s_innodb_cached_indexes_fill_table(
+/*=================================*/
+	THD*		thd,		/*!< in: thread */
+	TABLE_LIST*	tables,		/*!< in/out: tables to fill */
+	Item*		)		/*!< in: condition (ignored) */
+{
+	DBUG_ENTER("i_s_innodb_cached_indexes_fill_table");
+
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+	/* deny access to any users that do not hold PROCESS_ACL */
+	if (check_global_access(thd, PROCESS_ACL)) {
+		DBUG_RETURN(0);
+	}
+
+	buf_index_stats_t	stats;
+
+	buf_index_stats_get(stats);
+
+	i_s_cached_index_names_t	names;
+
+	i_s_innodb_cached_indexes_get_names(thd, stats, names);
+
+	TABLE*	table	= tables->table;
+	Field**	fields	= table->field;
+
+	for (buf_index_stats_t::const_iterator it = stats.begin();
+	     it != stats.end(); ++it) {
+		const ulint		space_id = it->first.first;
+		const index_id_t	index_id = it->first.second;
+		const buf_index_stat_t&	stat = it->second;
+
+		OK(fields[IDX_CACHED_INDEX_SPACE_ID]->store(space_id, true));
+
+		OK(fields[IDX_CACHED_INDEX_INDEX_ID]->store(index_id, true));
+
+		fields[IDX_CACHED_INDEX_TABLE_NAME]->set_null();
+
+		fields[IDX_CACHED_INDEX_INDEX_NAME]->set_null();
+
+		i_s_cached_index_names_t::const_iterator	name
+			= names.find(it->first);
+
+		if (name != names.end()) {
+			const std::string&	table_name
+				= name->second.first;
+
+			OK(fields[IDX_CACHED_INDEX_TABLE_NAME]->store(
+				   table_name.data(),
+				   static_cast<uint>(table_name.size()),
+				   system_charset_info));
+
+			fields[IDX_CACHED_INDEX_TABLE_NAME]->set_notnull();
+
+			OK(field_store_index_name(
+				   fields[IDX_CACHED_INDEX_INDEX_NAME],
+				   name->second.second.c_str()));
+		}
+
+		OK(fields[IDX_CACHED_INDEX_N_PAGES]->store(
+			   stat.n_pages, true));
+
+		OK(fields[IDX_CACHED_INDEX_N_DIRTY]->store(
+			   stat.n_dirty, true));
+
+		OK(fields[IDX_CACHED_INDEX_N_READ]->store(
+			   stat.n_pages_read, true));
+
+		OK(fields[IDX_CACHED_INDEX_N_YOUNG]->store(
+			   stat.n_pages_made_young, true));
+
+		OK(schema_table_store_record(thd, table));
+	}
+
+	DBUG_RETURN(0);
+}
+
+/*******************************************************************//**
+Bind the dynamic table INFORMATION_SCHEMA.INNODB_CACHED_INDEXES.
+@return 0 on success, 1 on failure */
+static
+int
+i_s_innodb_cached_indexes_init(
+/*===========================*/
+	void*	p)	/*!< in/out: table schema object */
+{
+	ST_SCHEMA_TABLE*	schema;
+
+	DBUG_ENTER("i_s_innodb_cached_indexes_init");
+
+	schema = reinterpret_cast<ST_SCHEMA_TABLE*>(p);
+
+	schema->fields_info = i_s_innodb_cached_indexes_fields_info;
+	schema->fill_table = i_s_innodb_cached_indexes_fill_table;
+
+	DBUG_RETURN(0);
+}
+
+UNIV_INTERN struct st_maria_plugin	i_s_innodb_cached_indexes =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	STRUCT_FLD(type, MYSQL_INFORMATION_SCHEMA_PLUGIN),
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	STRUCT_FLD(info, &i_s_info),
+
+	/* plugin name */
+	/* const char* */
+	STRUCT_FLD(name, "INNODB_CACHED_INDEXES"),
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(author, plugin_author),
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(descr, "InnoDB Buffer Pool Pages per Index"),
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	STRUCT_FLD(license, PLUGIN_LICENSE_GPL),
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(init, i_s_innodb_cached_indexes_init),
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(deinit, i_s_common_deinit),
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	STRUCT_FLD(version, INNODB_VERSION_SHORT),
+
+	/* struct st_mysql_show_var* */
+	STRUCT_FLD(status_vars, NULL),
+
+	/* struct st_mysql_sys_var** */
+	STRUCT_FLD(system_vars, NULL),
+
+        /* Maria extension */
+	STRUCT_FLD(version_info, INNODB_VERSION_STR),
+        STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
+};
+
 /*******************************************************************//**
 Unbind a dynamic INFORMATION_SCHEMA table.
 @return 0 on success */
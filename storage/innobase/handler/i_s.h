@@ -50,6 +50,7 @@ extern struct st_maria_plugin	i_s_innodb_ft_config;
 extern struct st_maria_plugin	i_s_innodb_buffer_page;
 extern struct st_maria_plugin	i_s_innodb_buffer_page_lru;
 extern struct st_maria_plugin	i_s_innodb_buffer_stats;
+extern struct st_maria_plugin	i_s_innodb_cached_indexes;
 extern struct st_maria_plugin	i_s_innodb_sys_tables;
 extern struct st_maria_plugin	i_s_innodb_sys_tablestats;
 extern struct st_maria_plugin	i_s_innodb_sys_indexes;
@@ -39,7 +39,7 @@ extern	long	innobase_fill_factor;
 The proper function call sequence of PageBulk is as below:
 -- PageBulk::init
 -- PageBulk::insert
--- PageBulk::finish
+-- PageBulk::finish (PageBulk::sortRecs for SPATIAL INDEX)
 -- PageBulk::compress(COMPRESSED table only)
 -- PageBulk::pageSplit(COMPRESSED table only)
 -- PageBulk::commit
@@ -83,7 +83,6 @@ class PageBulk
 		m_flush_observer(observer),
 		m_err(DB_SUCCESS)
 	{
-		ut_ad(!dict_index_is_spatial(m_index));
 	}
 
 	/** Deconstructor */
@@ -106,6 +105,11 @@ class PageBulk
 	dirs, and set page header members. */
 	void finish();
 
+	/** Sort the records of an R-tree page. A SPATIAL INDEX is loaded
+	in Hilbert curve order, while the records within each page must be
+	in the order of cmp_rec_rec(). */
+	void sortRecs();
+
 	/** Commit mtr for a page
 	@param[in]	success		Flag whether all inserts succeed. */
 	void commit(bool success);
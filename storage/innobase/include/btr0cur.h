@@ -256,6 +256,21 @@ btr_cur_open_at_rnd_pos_func(
 	mtr_t*		mtr);		/*!< in: mtr */
 #define btr_cur_open_at_rnd_pos(i,l,c,m)				\
 	btr_cur_open_at_rnd_pos_func(i,l,c,__FILE__,__LINE__,m)
+/** Look up the number of the leaf page that a PAGE_CUR_LE search for a
+tuple would end up on, without accessing the leaf page itself.
+The index tree is s-latched and the non-leaf pages on the path are
+s-latched until the mini-transaction is committed.
+@param[in]	index	B-tree index, not a spatial index
+@param[in]	tuple	search tuple
+@param[in,out]	mtr	mini-transaction
+@return leaf page number
+@retval FIL_NULL if the root page is a leaf page or the index is
+unavailable */
+ulint
+btr_cur_get_leaf_page_no(
+	dict_index_t*	index,
+	const dtuple_t*	tuple,
+	mtr_t*		mtr);
 /*************************************************************//**
 Tries to perform an insert to a page in an index tree, next to cursor.
 It is assumed that mtr holds an x-latch on the page. The operation does
@@ -206,6 +206,30 @@ struct buf_pool_info_t{
 					interval */
 };
 
+/** Page counters of an index in the buffer pool. These are maintained
+incrementally when pages are read, modified, written, made young or
+evicted, so that INFORMATION_SCHEMA.INNODB_CACHED_INDEXES does not have
+to scan the buffer pool. */
+struct buf_index_stat_t {
+	ulint	n_pages;		/*!< number of pages of the index
+					in the buffer pool */
+	ulint	n_dirty;		/*!< number of pages of the index
+					in the flush list */
+	ulint	n_pages_read;		/*!< number of pages of the index
+					read into the buffer pool */
+	ulint	n_pages_made_young;	/*!< number of pages of the index
+					made young */
+};
+
+/** Page counters of indexes, keyed by (tablespace id, index id) */
+typedef std::map<
+	std::pair<ulint, index_id_t>,
+	buf_index_stat_t,
+	std::less<std::pair<ulint, index_id_t> >,
+	ut_allocator<std::pair<const std::pair<ulint, index_id_t>,
+			       buf_index_stat_t> > >
+	buf_index_stats_t;
+
 /** The occupied bytes of lists in all buffer pools */
 struct buf_pools_list_size_t {
 	ulint	LRU_bytes;		/*!< LRU size in bytes */
@@ -374,6 +398,30 @@ buf_frame_will_withdrawn(
 	buf_pool_t*	buf_pool,
 	const byte*	ptr);
 
+/** Register a lookup that accesses buf_pool->page_hash, the adaptive hash
+index, or the buffer pool blocks that they point to, without holding
+any latch. The memory will not be freed before buf_pool_lock_free_exit().
+@return the counter to pass to buf_pool_lock_free_exit()
+@retval NULL if lock-free lookups are disabled */
+ulint*
+buf_pool_lock_free_enter();
+
+/** Unregister a lookup that was registered by buf_pool_lock_free_enter().
+@param[in,out]	n	return value of buf_pool_lock_free_enter() */
+void
+buf_pool_lock_free_exit(ulint* n);
+
+/** Make buf_pool_lock_free_enter() fail, and wait for the lookups in
+progress to finish, so that buffer pool chunks, page_hash or the adaptive
+hash index tables may be freed. */
+void
+buf_pool_lock_free_disable();
+
+/** Allow buf_pool_lock_free_enter() again after
+buf_pool_lock_free_disable(). */
+void
+buf_pool_lock_free_enable();
+
 /** This is the thread for resizing buffer pool. It waits for an event and
 when waked up either performs a resizing and sleeps again.
 @return	this function does not return, calls os_thread_exit()
@@ -410,21 +458,23 @@ lsn_t
 buf_pool_get_oldest_modification(void);
 /*==================================*/
 
-/********************************************************************//**
-Allocates a buf_page_t descriptor. This function must succeed. In case
-of failure we assert in this function. */
+/** Allocate a buf_page_t descriptor for a compressed-only page.
+A descriptor that was freed by buf_page_free_descriptor() is reused
+if possible. This function must succeed. In case of failure we assert
+in this function.
+@param[in,out]	buf_pool	buffer pool instance
+@return the allocated descriptor, filled with zero bytes */
 UNIV_INLINE
 buf_page_t*
-buf_page_alloc_descriptor(void)
-/*===========================*/
-	MY_ATTRIBUTE((malloc));
-/********************************************************************//**
-Free a buf_page_t descriptor. */
+buf_page_alloc_descriptor(buf_pool_t* buf_pool);
+/** Free a buf_page_t descriptor. The memory is retained in
+buf_pool->free_desc, because buf_block_hash_fix_lock_free() may
+still be reading the descriptor through a stale page_hash chain.
+@param[in,out]	buf_pool	buffer pool instance
+@param[in]	bpage		descriptor to free */
 UNIV_INLINE
 void
-buf_page_free_descriptor(
-/*=====================*/
-	buf_page_t*	bpage)	/*!< in: bpage descriptor to free. */
+buf_page_free_descriptor(buf_pool_t* buf_pool, buf_page_t* bpage)
 	MY_ATTRIBUTE((nonnull));
 
 /********************************************************************//**
@@ -931,6 +981,29 @@ buf_stats_get_pool_info(
 	ulint			pool_id,	/*!< in: buffer pool ID */
 	buf_pool_info_t*	all_pool_info);	/*!< in/out: buffer pool info
 						to fill */
+/** Collect the page counters of the indexes in the buffer pool.
+@param[out]	stats	page counters of all buffer pool instances */
+void
+buf_index_stats_get(buf_index_stats_t& stats);
+/** Note that the PAGE_INDEX_ID of a page was initialized.
+@param[in,out]	block		buffer block
+@param[in]	index_id	index identifier, or 0 if the page
+				no longer belongs to an index */
+void
+buf_block_set_index_stat(buf_block_t* block, index_id_t index_id);
+/** Stop counting a page that is leaving the buffer pool.
+@param[in,out]	bpage	page; buf_page_get_mutex(bpage) must be held */
+void
+buf_index_stat_evict(buf_page_t* bpage);
+/** Count a page that was added to or removed from the flush list.
+@param[in]	bpage	page; buf_page_get_mutex(bpage) must be held
+@param[in]	dirty	whether the page was added to the flush list */
+void
+buf_index_stat_dirty(const buf_page_t* bpage, bool dirty);
+/** Count a page that was made young.
+@param[in]	bpage	page; buf_pool->mutex must be held */
+void
+buf_index_stat_made_young(const buf_page_t* bpage);
 /** Return the ratio in percents of modified pages in the buffer pool /
 database pages in the buffer pool.
 @return modified page percentage ratio */
@@ -1691,6 +1764,11 @@ class buf_page_t {
 					0 if the block was never accessed
 					in the buffer pool. Protected by
 					block mutex */
+	index_id_t	stat_index_id;	/*!< index identifier under which
+					the page is counted in
+					buf_pool->index_stats, or 0 if
+					the page is not counted.
+					Protected by block mutex */
 # ifdef UNIV_DEBUG
 	ibool		file_page_was_freed;
 					/*!< this is set to TRUE when
@@ -1846,6 +1924,16 @@ struct buf_block_t{
 	bool		skip_flush_check;
 					/*!< Skip check in buf_dblwr_check_block
 					during bulk load, protected by lock.*/
+	ulint		n_lock_free_pins;
+					/*!< number of
+					buf_block_hash_fix_lock_free() calls
+					that may be buffer-fixing the block;
+					protected by atomic memory access.
+					Eviction waits for this to be 0 after
+					changing the page_hash version, so
+					that such a call either sees the
+					change or leaves the block
+					buffer-fixed. */
 # ifdef UNIV_DEBUG
 	/** @name Debug fields */
 	/* @{ */
@@ -2076,6 +2164,18 @@ typedef struct {
 					array */
 } buf_tmp_array_t;
 
+/** Version counter of a page_hash latch partition. It is odd while
+a writer that holds the page_hash latch in exclusive mode is inserting
+or removing pages of the partition, so that
+buf_block_hash_fix_lock_free() can detect concurrent modifications
+like a sequence lock. */
+struct buf_page_hash_version_t {
+	/** the version counter */
+	ulint	version;
+	/** padding to prevent false sharing between the counters */
+	byte	pad[CACHE_LINE_SIZE - sizeof(ulint)];
+};
+
 /** @brief The buffer pool structure.
 
 NOTE! The definition appears here only for other modules of this
@@ -2126,9 +2226,15 @@ struct buf_pool_t{
 					by buf_pool->mutex and the relevant
 					page_hash mutex. Lookups can happen
 					while holding the buf_pool->mutex or
-					the relevant page_hash mutex. */
+					the relevant page_hash mutex, or
+					without either, in
+					buf_block_hash_fix_lock_free(). */
 	hash_table_t*	page_hash_old;	/*!< old pointer to page_hash to be
 					freed after resizing buffer pool */
+	buf_page_hash_version_t* page_hash_versions;
+					/*!< version counters of the
+					page_hash latch partitions;
+					see buf_page_hash_insert() */
 	hash_table_t*	zip_hash;	/*!< hash table of buf_block_t blocks
 					whose frames are allocated to the
 					zip buddy system,
@@ -2145,6 +2251,13 @@ struct buf_pool_t{
 					indexed by block size */
 	buf_pool_stat_t	stat;		/*!< current statistics */
 	buf_pool_stat_t	old_stat;	/*!< old statistics */
+	ib_mutex_t	index_stats_mutex;
+					/*!< mutex protecting
+					index_stats */
+	hash_table_t*	index_stats;	/*!< hash table of
+					buf_index_stat_node_t,
+					indexed by (space id, index id);
+					see buf_block_set_index_stat() */
 
 	/* @} */
 
@@ -2212,6 +2325,14 @@ struct buf_pool_t{
 					we flush a batch from the
 					buffer pool. Protected by the
 					buf_pool->mutex */
+	os_event_t	lru_manager_event;
+					/*!< set to wake up
+					buf_lru_manager_thread of this
+					instance; NULL if innodb_lru_manager
+					is not enabled */
+	bool		lru_manager_active;
+					/*!< whether buf_lru_manager_thread
+					of this instance is running */
 	/* @} */
 
 	/** @name LRU replacement algorithm fields */
@@ -2276,6 +2397,11 @@ struct buf_pool_t{
 #endif /* UNIV_DEBUG || UNIV_BUF_DEBUG */
 	UT_LIST_BASE_NODE_T(buf_buddy_free_t) zip_free[BUF_BUDDY_SIZES_MAX];
 					/*!< buddy free lists */
+	UT_LIST_BASE_NODE_T(buf_page_t)	free_desc;
+					/*!< freed descriptors of
+					compressed-only pages, to be reused
+					by buf_page_alloc_descriptor();
+					protected by buf_pool->mutex */
 
 	buf_page_t*			watch;
 					/*!< Sentinel records for buffer
@@ -2348,6 +2474,54 @@ buf_page_hash_lock_get(const buf_pool_t* buf_pool, const page_id_t& page_id)
 	return hash_get_lock(buf_pool->page_hash, page_id.fold());
 }
 
+/** Get the version counter of the page_hash latch partition of a page.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	fold		page_id_t::fold() of the page
+@return version counter */
+UNIV_INLINE
+ulint*
+buf_page_hash_version(const buf_pool_t* buf_pool, ulint fold)
+{
+	return(&buf_pool->page_hash_versions[hash_get_sync_obj_index(
+			buf_pool->page_hash, fold)].version);
+}
+
+/** Insert a page to buf_pool->page_hash. The caller must hold the
+page_hash latch in exclusive mode. The version counter of the latch
+partition is odd during the modification, so that
+buf_block_hash_fix_lock_free() will not trust what it found in the chain.
+@param[in,out]	buf_pool	buffer pool instance
+@param[in]	fold		bpage->id.fold()
+@param[in,out]	bpage		page to insert */
+UNIV_INLINE
+void
+buf_page_hash_insert(buf_pool_t* buf_pool, ulint fold, buf_page_t* bpage)
+{
+	ulint*	version = buf_page_hash_version(buf_pool, fold);
+
+	/* Use full memory barriers, so that the modification of the
+	chain cannot be reordered with the version changes. */
+	my_atomic_addlint(version, 1);
+	HASH_INSERT(buf_page_t, hash, buf_pool->page_hash, fold, bpage);
+	my_atomic_addlint(version, 1);
+}
+
+/** Remove a page from buf_pool->page_hash. The caller must hold the
+page_hash latch in exclusive mode.
+@param[in,out]	buf_pool	buffer pool instance
+@param[in]	fold		bpage->id.fold()
+@param[in,out]	bpage		page to remove */
+UNIV_INLINE
+void
+buf_page_hash_delete(buf_pool_t* buf_pool, ulint fold, buf_page_t* bpage)
+{
+	ulint*	version = buf_page_hash_version(buf_pool, fold);
+
+	my_atomic_addlint(version, 1);
+	HASH_DELETE(buf_page_t, hash, buf_pool->page_hash, fold, bpage);
+	my_atomic_addlint(version, 1);
+}
+
 /** If not appropriate page_hash_lock, relock until appropriate. */
 # define buf_page_hash_lock_s_confirm(hash_lock, buf_pool, page_id)\
 	hash_lock_s_confirm(hash_lock, (buf_pool)->page_hash, (page_id).fold())
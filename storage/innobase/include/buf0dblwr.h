@@ -109,6 +109,14 @@ of threads can occur. */
 void
 buf_dblwr_flush_buffered_writes();
 
+/** Flush possible buffered writes of the doublewrite area that serves
+a buffer pool instance. This is like buf_dblwr_flush_buffered_writes(),
+but it does not wait for batches of other buffer pool instances that
+are written to other innodb_doublewrite_files.
+@param[in]	buf_pool	buffer pool instance */
+void
+buf_dblwr_flush_buffered_writes(const buf_pool_t* buf_pool);
+
 /********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
 the page to the datafile and sync the datafile. This function is used
@@ -123,13 +131,16 @@ buf_dblwr_write_single_page(
 	buf_page_t*	bpage,	/*!< in: buffer block to write */
 	bool		sync);	/*!< in: true if sync IO requested */
 
-/** Doublewrite control struct */
-struct buf_dblwr_t{
+/** A doublewrite area for batch flushes: either the part of the
+doublewrite buffer in the system tablespace that is not reserved for
+single page flushes, or one of the innodb_doublewrite_files */
+struct buf_dblwr_batch_t{
 	ib_mutex_t	mutex;	/*!< mutex protecting the first_free
 				field and write_buf */
-	ulint		block1;	/*!< the page number of the first
-				doublewrite block (64 pages) */
-	ulint		block2;	/*!< page number of the second block */
+	char*		name;	/*!< file name, or NULL for the
+				system tablespace */
+	pfs_os_file_t	file;	/*!< file handle, or OS_FILE_CLOSED
+				for the system tablespace */
 	ulint		first_free;/*!< first free position in write_buf
 				measured in units of UNIV_PAGE_SIZE */
 	ulint		b_reserved;/*!< number of slots currently reserved
@@ -137,7 +148,39 @@ struct buf_dblwr_t{
 	os_event_t	b_event;/*!< event where threads wait for a
 				batch flush to end;
 				os_event_set() and os_event_reset()
-				are protected by buf_dblwr_t::mutex */
+				are protected by mutex */
+	bool		batch_running;/*!< set to TRUE if currently a batch
+				is being written from the doublewrite
+				buffer. */
+	byte*		write_buf;/*!< write buffer used in writing to the
+				doublewrite area, aligned to an
+				address divisible by UNIV_PAGE_SIZE */
+	byte*		write_buf_unaligned;/*!< pointer to write_buf,
+				but unaligned, or NULL if write_buf
+				is part of buf_dblwr_t::write_buf */
+	buf_page_t**	buf_block_arr;/*!< array to store pointers to
+				the buffer blocks which have been
+				cached to write_buf */
+};
+
+/** Doublewrite control struct */
+struct buf_dblwr_t{
+	ib_mutex_t	mutex;	/*!< mutex protecting the single page
+				flush slots */
+	ulint		block1;	/*!< the page number of the first
+				doublewrite block (64 pages) */
+	ulint		block2;	/*!< page number of the second block */
+	buf_dblwr_batch_t batch;/*!< batch flush area in block1
+				and block2; only used if n_files == 0 */
+	ulint		n_files;/*!< number of doublewrite files used
+				for batch flushes; buffer pool instance
+				i is served by files[i % n_files] */
+	ulint		n_stale;/*!< number of doublewrite files after
+				files[n_files - 1] that were left by a
+				larger innodb_doublewrite_files; they are
+				only read in crash recovery */
+	buf_dblwr_batch_t* files;/*!< doublewrite files, followed by
+				the stale ones */
 	ulint		s_reserved;/*!< number of slots currently
 				reserved for single page flushes. */
 	os_event_t	s_event;/*!< event where threads wait for a
@@ -145,9 +188,6 @@ struct buf_dblwr_t{
 	bool*		in_use;	/*!< flag used to indicate if a slot is
 				in use. Only used for single page
 				flushes. */
-	bool		batch_running;/*!< set to TRUE if currently a batch
-				is being written from the doublewrite
-				buffer. */
 	byte*		write_buf;/*!< write buffer used in writing to the
 				doublewrite buffer, aligned to an
 				address divisible by UNIV_PAGE_SIZE
@@ -35,6 +35,9 @@ Created 11/5/1995 Heikki Tuuri
 /** Flag indicating if the page_cleaner is in active state. */
 extern bool buf_page_cleaner_is_active;
 
+/** Number of buf_lru_manager_thread that are running */
+extern ulint buf_lru_manager_n_active;
+
 #ifdef UNIV_DEBUG
 
 /** Value of MySQL global variable used to disable page cleaner. */
@@ -258,6 +261,14 @@ DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 void
 buf_flush_page_cleaner_init(void);
 
+/** Start one buf_lru_manager_thread for each buffer pool instance. */
+void
+buf_lru_manager_start();
+
+/** Wake up all buf_lru_manager_thread, for example at shutdown. */
+void
+buf_lru_manager_wake_all();
+
 /** Wait for any possible LRU flushes that are in progress to end. */
 void
 buf_flush_wait_LRU_batch_end(void);
@@ -83,6 +83,24 @@ buf_read_ahead_random(
 	const page_size_t&	page_size,
 	ibool			inside_ibuf);
 
+/** Issue asynchronous read requests for the given pages of a tablespace
+that are not in the buffer pool, for example the clustered index leaf pages
+that a secondary index range scan is about to access.
+NOTE: the calling thread may own latches on pages: to avoid deadlocks this
+function must be written such that it cannot end up waiting for these
+latches!
+@param[in]	space_id	tablespace identifier
+@param[in]	page_size	page size
+@param[in]	page_nos	page numbers, in ascending order
+@param[in]	n		number of elements in page_nos
+@return number of page read requests issued */
+ulint
+buf_read_ahead_pages(
+	ulint			space_id,
+	const page_size_t&	page_size,
+	const ulint*		page_nos,
+	ulint			n);
+
 /** Applies linear read-ahead if in the buf_pool the page is a border page of
 a linear read-ahead area and all the pages in the area have been accessed.
 Does not read any page if the read-ahead mechanism is not activated. Note
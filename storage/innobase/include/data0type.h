@@ -37,6 +37,8 @@ Created 1/16/1996 Heikki Tuuri
 
 extern ulint	data_mysql_default_charset_coll;
 #define DATA_MYSQL_BINARY_CHARSET_COLL 63
+/** The collation of latin1_bin, which compares like memcmp() */
+#define DATA_MYSQL_LATIN1_BIN_CHARSET_COLL 47
 
 /* SQL data type struct */
 struct dtype_t;
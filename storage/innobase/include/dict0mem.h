@@ -891,6 +891,10 @@ struct dict_index_t{
 	records; usually equal to UT_BITS_IN_BYTES(n_nullable), but
 	can be less in clustered indexes with instant ADD COLUMN */
 	unsigned	n_core_null_bytes:8;
+	/** number of leading fields that are stored at fixed offsets
+	from the origin of every record and that compare like memcmp();
+	see page_cur_search_with_match() */
+	unsigned	n_memcmp_fields:10;
 	/** magic value signalling that n_core_null_bytes was not
 	initialized yet */
 	static const unsigned NO_CORE_NULL_BYTES = 0xff;
@@ -1576,6 +1580,12 @@ struct dict_table_t {
 	process of altering partitions */
 	unsigned                                skip_alter_undo:1;
 
+	/** TRUE if this is a TEMPORARY TABLE that was created with
+	innodb_intrinsic_temp_tables=ON. Its changes are not undo logged,
+	so they cannot be rolled back, and records are removed
+	immediately instead of being delete-marked. */
+	unsigned				intrinsic:1;
+
 	/*!< whether this is in a single-table tablespace and the .ibd
 	file is missing or page decryption failed and page is corrupted */
 	unsigned				file_unreadable:1;
@@ -1880,7 +1890,8 @@ struct dict_table_t {
 
 	/** Count of the number of record locks on this table. We use this to
 	determine whether we can evict the table from the dictionary cache.
-	It is protected by lock_sys.mutex. */
+	It is incremented atomically while holding a record lock shard latch
+	of lock_sys, and decremented while holding lock_sys.mutex. */
 	ulint					n_rec_locks;
 
 #ifndef DBUG_ASSERT_EXISTS
@@ -39,6 +39,13 @@ enum dict_stats_upd_option_t {
 				storage, if the persistent storage is
 				not present then emit a warning and
 				fall back to transient stats */
+	DICT_STATS_RECALC_PERSISTENT_INCREMENTAL,/* like
+				DICT_STATS_RECALC_PERSISTENT, but sample
+				fewer leaf pages, in proportion to the
+				modified rows, and merge the results into
+				the previous estimates; used by the
+				automatic recalculation when
+				innodb_stats_incremental=ON */
 	DICT_STATS_RECALC_TRANSIENT,/* (re) calculate the statistics
 				using an imprecise quick algo
 				without saving the results
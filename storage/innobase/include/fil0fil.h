@@ -45,6 +45,9 @@ class truncate_t;
 /** Structure containing encryption specification */
 struct fil_space_crypt_t;
 
+/** Zstandard dictionary of a page_compressed tablespace */
+struct fil_zstd_dict_t;
+
 /** File types */
 enum fil_type_t {
 	/** temporary tablespace (temporary undo log or tables) */
@@ -151,7 +154,7 @@ struct fil_space_t {
 	The tablespace object cannot be freed while this is nonzero,
 	but it can be detached from fil_system.
 	Note that fil_node_t::n_pending tracks actual pending I/O requests.
-	Protected by fil_system.mutex. */
+	Updated with my_atomic_addlint(), without fil_system.mutex. */
 	ulint		n_pending_ios;
 	hash_node_t	hash;	/*!< hash chain node */
 	hash_node_t	name_hash;/*!< hash chain the name_hash table */
@@ -176,6 +179,10 @@ struct fil_space_t {
 	/** MariaDB encryption data */
 	fil_space_crypt_t* crypt_data;
 
+	/** Zstandard dictionary for page_compressed pages, or NULL;
+	set once and never changed before the tablespace is freed */
+	fil_zstd_dict_t* zstd_dict;
+
 	/** True if we have already printed compression failure */
 	bool		printed_compression_failure;
 
@@ -273,7 +280,11 @@ struct fil_node_t {
 	ulint		init_size;
 	/** maximum size of the file in database pages (0 if unlimited) */
 	ulint		max_size;
-	/** count of pending i/o's; is_open must be true if nonzero */
+	/** count of pending i/o's; is_open must be true if nonzero.
+	Updated with atomic operations. The changes from 0 to 1 and from
+	1 to 0 move the node out of or into fil_system.LRU, and they are
+	protected by fil_system.mutex; other changes can be made by fil_io()
+	and fil_aio_wait() without holding the mutex. */
 	ulint		n_pending;
 	/** count of pending flushes; is_open must be true if nonzero */
 	ulint		n_pending_flushes;
@@ -62,8 +62,53 @@ fil_decompress_page(
 	ulong	len,		/*!< in: length of output buffer.*/
 	ulint*	write_size,	/*!< in/out: Actual payload size of
 				the compressed data. */
-	bool	return_error=false);
+	bool	return_error=false,
 				/*!< in: true if only an error should
 				be produced when decompression fails.
 				By default this parameter is false. */
+	const fil_zstd_dict_t*	zstd_dict=NULL);
+				/*!< in: Zstandard dictionary of the
+				tablespace, or NULL to look it up
+				if the page needs one */
+
+/** Read the Zstandard dictionary from the first page of a tablespace.
+@param[in]	flags	tablespace flags
+@param[in]	page	first page of the tablespace
+@return the dictionary
+@retval NULL if the tablespace has no dictionary */
+fil_zstd_dict_t*
+fil_zstd_dict_read(ulint flags, const byte* page);
+
+/** Write a Zstandard dictionary to the first page of a tablespace.
+@param[in]	dict	dictionary
+@param[in]	flags	tablespace flags
+@param[in,out]	page	first page of the tablespace
+@param[in,out]	mtr	mini-transaction */
+void
+fil_zstd_dict_write_page0(
+	const fil_zstd_dict_t*	dict,
+	ulint			flags,
+	byte*			page,
+	mtr_t*			mtr);
+
+/** Free a Zstandard dictionary.
+@param[in,out]	dict	dictionary, or NULL */
+void
+fil_zstd_dict_free(fil_zstd_dict_t* dict);
+
+/** Train a Zstandard dictionary on a sample of the index pages of a
+page_compressed tablespace, store it in the first page, and use it for
+subsequently written pages.
+@param[in,out]	space	tablespace
+@retval DB_SUCCESS		on success
+@retval DB_UNSUPPORTED		if zstd is not available or the tablespace
+				is not page_compressed
+@retval DB_DUPLICATE_KEY	if the tablespace already has a dictionary
+@retval DB_ERROR		if there are too few pages to train on */
+dberr_t
+fil_zstd_dict_train(fil_space_t* space);
+
+/** Free the cached Zstandard compression contexts at shutdown. */
+void
+fil_pagecompress_close();
 #endif
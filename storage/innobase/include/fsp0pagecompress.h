@@ -36,7 +36,8 @@ Created 11/12/2013 Jan Lindström jan.lindstrom@skysql.com
 #define PAGE_LZMA_ALGORITHM	4
 #define PAGE_BZIP2_ALGORITHM	5
 #define PAGE_SNAPPY_ALGORITHM	6
-#define PAGE_ALGORITHM_LAST	PAGE_SNAPPY_ALGORITHM
+#define PAGE_ZSTD_ALGORITHM	7
+#define PAGE_ALGORITHM_LAST	PAGE_ZSTD_ALGORITHM
 
 /**********************************************************************//**
 Reads the page compression level from the first page of a tablespace.
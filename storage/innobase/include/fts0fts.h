@@ -135,6 +135,10 @@ extern ulong		fts_sort_pll_degree;
 call */
 extern ulong		fts_num_word_optimize;
 
+/** Variable specifying the number of threads that optimize FTS tables in
+the background; with 1, the FTS optimize thread does it itself */
+extern ulong		fts_optimize_threads;
+
 /** Variable specifying whether we do additional FTS diagnostic printout
 in the log */
 extern char		fts_enable_diag_print;
@@ -45,6 +45,43 @@ ha_search_and_get_data(
 /*===================*/
 	hash_table_t*	table,	/*!< in: hash table */
 	ulint		fold);	/*!< in: folded value of the searched data */
+
+/** Look for an element in a hash table of the adaptive hash index without
+holding the latch of the partition. The result is only valid for as long as
+ha_chain_version_validate() returns true for the returned version.
+The caller must have registered itself with buf_pool_lock_free_enter().
+@param[in]	table	hash table
+@param[in]	fold	folded value of the searched data
+@param[out]	data	pointer to the data of the first hash table node
+			in chain having the fold number, or NULL if not found
+@return version of the hash chain
+@retval ULINT_UNDEFINED if the hash chain was being modified; data is
+not set and the search must be retried while holding the latch */
+UNIV_INLINE
+ulint
+ha_search_and_get_data_lock_free(
+	hash_table_t*	table,
+	ulint		fold,
+	const rec_t**	data);
+
+/** Check if a hash chain of the adaptive hash index has been left
+unmodified since ha_search_and_get_data_lock_free().
+@param[in]	table	hash table
+@param[in]	fold	folded value of the searched data
+@param[in]	version	return value of ha_search_and_get_data_lock_free()
+@return whether the hash chain was not modified */
+UNIV_INLINE
+bool
+ha_chain_version_validate(
+	hash_table_t*	table,
+	ulint		fold,
+	ulint		version);
+
+/** Mark all hash chains of the adaptive hash index partition as being
+modified or no longer modified, around hash_table_clear().
+@param[in,out]	table	hash table */
+void
+ha_chain_version_inc_all(hash_table_t* table);
 /*********************************************************//**
 Looks for an element when we know the pointer to the data and updates
 the pointer to data if found.
@@ -200,6 +237,23 @@ ha_validate(
 	ulint		end_index);	/*!< in: end index */
 #endif /* defined UNIV_AHI_DEBUG || defined UNIV_DEBUG */
 
+/** Number of version counters in an adaptive hash index partition.
+Each counter covers the hash chains whose cell numbers are congruent
+modulo HA_N_VERSIONS. */
+#define HA_N_VERSIONS	256
+
+/** Version counter of a set of hash chains of the adaptive hash index.
+It is odd while a writer that holds the partition latch in exclusive mode
+is modifying any of the chains, and incremented again when the writer is
+done, so that ha_search_and_get_data_lock_free() can detect concurrent
+modifications like a sequence lock. */
+struct ha_version_t {
+	/** the version counter */
+	ulint	version;
+	/** padding to prevent false sharing between the counters */
+	byte	pad[CACHE_LINE_SIZE - sizeof(ulint)];
+};
+
 /** The hash table external chain node */
 struct ha_node_t {
 	ulint		fold;	/*!< fold value for the data */
@@ -33,6 +33,9 @@ Created 5/20/1997 Heikki Tuuri
 
 struct hash_table_t;
 struct hash_cell_t;
+#ifdef BTR_CUR_HASH_ADAPT
+struct ha_version_t;
+#endif /* BTR_CUR_HASH_ADAPT */
 
 typedef void*	hash_node_t;
 
@@ -503,6 +506,12 @@ struct hash_table_t {
 					heaps; there are then n_mutexes
 					many of these heaps */
 	mem_heap_t*		heap;
+#ifdef BTR_CUR_HASH_ADAPT
+	ha_version_t*		versions;/*!< NULL, or HA_N_VERSIONS
+					version counters of the hash chains
+					of an adaptive hash index partition;
+					see ha_chain_version() */
+#endif /* BTR_CUR_HASH_ADAPT */
 #ifdef UNIV_DEBUG
 	ulint			magic_n;
 # define HASH_TABLE_MAGIC_N	76561114
@@ -58,6 +58,9 @@ class ReadView;
 /** The value of innodb_deadlock_detect */
 extern my_bool	innobase_deadlock_detect;
 
+/** The value of innodb_deadlock_detect_background */
+extern my_bool	innobase_deadlock_detect_background;
+
 /*********************************************************************//**
 Gets the size of a lock struct.
 @return size in bytes */
@@ -452,13 +455,13 @@ lock_table(
 	lock_mode	mode,	/*!< in: lock mode */
 	que_thr_t*	thr)	/*!< in: query thread */
 	MY_ATTRIBUTE((warn_unused_result));
-/*********************************************************************//**
-Creates a table IX lock object for a resurrected transaction. */
+/** Create a table lock object for a resurrected transaction.
+@param[in,out]	table	table
+@param[in,out]	trx	recovered transaction
+@param[in]	mode	LOCK_IX, or LOCK_X if the transaction wrote
+			a TRX_UNDO_EMPTY record for the table */
 void
-lock_table_ix_resurrect(
-/*====================*/
-	dict_table_t*	table,	/*!< in/out: table */
-	trx_t*		trx);	/*!< in/out: transaction */
+lock_table_resurrect(dict_table_t* table, trx_t* trx, lock_mode mode);
 
 /** Sets a lock on a table based on the given mode.
 @param[in]	table	table to lock
@@ -714,6 +717,22 @@ DECLARE_THREAD(lock_wait_timeout_thread)(
 	void*	arg);	/*!< in: a dummy parameter required by
 			os_thread_create */
 
+/** A thread which resolves the deadlocks between waiting transactions
+when innodb_deadlock_detect_background is set.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(lock_deadlock_detect_thread)(void*);
+
+/** Start lock_deadlock_detect_thread, unless it is already running. */
+void
+lock_deadlock_detect_start();
+
+/** Resolve the deadlocks of the transactions that started to wait for a
+lock since the previous call. Invoked by lock_deadlock_detect_thread. */
+void
+lock_deadlock_check_all();
+
 /********************************************************************//**
 Releases a user OS thread waiting for a lock to be released, if the
 thread is already suspended. */
@@ -891,6 +910,29 @@ class lock_sys_t
 	hash_table_t*	prdt_page_hash;		/*!< hash table of the page
 						lock */
 
+	/** Number of latches that the cells of rec_hash are divided
+	between */
+	static const ulint	N_REC_SHARDS = 32;
+
+	/** A latch on the record locks of a subset of the rec_hash cells.
+	It is acquired while holding rec_shards_latch in shared mode.
+	A thread that holds just one shard latch may only access the
+	lock queues of the pages that hash to it. */
+	struct rec_shard_t
+	{
+		MY_ALIGNED(CACHE_LINE_SIZE)
+		LockMutex	mutex;
+	};
+
+	/** Latches on the record locks; see rec_shard_t */
+	rec_shard_t	rec_shards[N_REC_SHARDS];
+
+	/** Shared by the holders of rec_shards[], and exclusively
+	locked together with lock_sys.mutex, so that lock_mutex_own()
+	implies exclusive access to every queue */
+	MY_ALIGNED(CACHE_LINE_SIZE)
+	rw_lock_t	rec_shards_latch;
+
 	MY_ALIGNED(CACHE_LINE_SIZE)
 	LockMutex	wait_mutex;		/*!< Mutex protecting the
 						next two fields */
@@ -919,6 +961,23 @@ class lock_sys_t
 	bool		timeout_thread_active;	/*!< True if the timeout thread
 						is running */
 
+	os_event_t	deadlock_event;		/*!< An event waited for by
+						lock_deadlock_detect_thread,
+						signaled when a lock wait is
+						enqueued and
+						innodb_deadlock_detect_background
+						is set */
+
+	bool		deadlock_thread_active;	/*!< True if the deadlock
+						detector thread is running */
+
+	/** A list of transactions */
+	typedef std::vector<trx_t*, ut_allocator<trx_t*> > trx_vector_t;
+
+	/** Transactions that started to wait for a lock since
+	lock_deadlock_detect_thread last checked; protected by mutex */
+	trx_vector_t	deadlock_waiters;
+
 
   /**
     Constructor.
@@ -950,6 +1009,51 @@ class lock_sys_t
 
   /** Closes the lock system at database shutdown. */
   void close();
+
+
+  /**
+    Get the record lock shard latch of a rec_hash cell.
+
+    @param[in] cell lock hash value of a page
+    @return the latch protecting the record locks of the cell
+  */
+  LockMutex& rec_shard(ulint cell)
+  {
+    return rec_shards[cell % N_REC_SHARDS].mutex;
+  }
+
+
+  /**
+    Acquire the record lock shard latch of a page, without acquiring
+    lock_sys.mutex. The caller must not hold any lock_sys latch.
+
+    @param[in] block index page
+    @return the acquired latch, to be released with rec_shard_exit()
+  */
+  LockMutex* rec_shard_enter(const buf_block_t* block);
+
+
+  /**
+    Release a record lock shard latch.
+
+    @param[in,out] shard latch returned by rec_shard_enter()
+  */
+  void rec_shard_exit(LockMutex* shard)
+  {
+    mutex_exit(shard);
+    rw_lock_s_unlock(&rec_shards_latch);
+  }
+
+#ifdef UNIV_DEBUG
+  /**
+    @param[in] cell lock hash value of a page
+    @return whether the record locks of the cell may be accessed
+  */
+  bool rec_own(ulint cell)
+  {
+    return mutex.is_owned() || rec_shard(cell).is_owned();
+  }
+#endif /* UNIV_DEBUG */
 };
 
 /*********************************************************************//**
@@ -1065,21 +1169,27 @@ lock_rec_free_all_from_discard_page(
 /** The lock system */
 extern lock_sys_t lock_sys;
 
-/** Test if lock_sys.mutex can be acquired without waiting. */
-#define lock_mutex_enter_nowait() 		\
-	(lock_sys.mutex.trylock(__FILE__, __LINE__))
+/** Try to acquire lock_sys.mutex and lock_sys.rec_shards_latch
+without waiting.
+@return 0 if both were acquired; nonzero if neither is held */
+#define lock_mutex_enter_nowait()					\
+	(lock_sys.mutex.trylock(__FILE__, __LINE__)			\
+	 || (!rw_lock_x_lock_nowait(&lock_sys.rec_shards_latch)		\
+	     && (lock_sys.mutex.exit(), true)))
 
 /** Test if lock_sys.mutex is owned. */
 #define lock_mutex_own() (lock_sys.mutex.is_owned())
 
-/** Acquire the lock_sys.mutex. */
-#define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys.mutex);		\
+/** Acquire the lock_sys.mutex and exclusive lock_sys.rec_shards_latch. */
+#define lock_mutex_enter() do {				\
+	mutex_enter(&lock_sys.mutex);			\
+	rw_lock_x_lock(&lock_sys.rec_shards_latch);	\
 } while (0)
 
-/** Release the lock_sys.mutex. */
-#define lock_mutex_exit() do {			\
-	lock_sys.mutex.exit();			\
+/** Release the lock_sys.mutex and lock_sys.rec_shards_latch. */
+#define lock_mutex_exit() do {				\
+	rw_lock_x_unlock(&lock_sys.rec_shards_latch);	\
+	lock_sys.mutex.exit();				\
 } while (0)
 
 /** Test if lock_sys.wait_mutex is owned. */
@@ -566,6 +566,19 @@ enum lock_rec_req_status {
 static const ulint      lock_types = UT_ARR_SIZE(lock_compatibility_matrix);
 #endif /* UNIV_DEBUG */
 
+/** Test if the record locks of a page may be accessed, that is,
+if lock_sys.mutex or the record lock shard latch of the page is owned.
+@param block	index page */
+#define lock_rec_page_own(block)					\
+	lock_sys.rec_own(buf_block_get_lock_hash_val(block))
+
+/** Test if the queue that a record lock belongs to may be accessed.
+@param lock	record lock */
+#define lock_rec_queue_own(lock)					\
+	lock_sys.rec_own(lock_rec_hash(					\
+		(lock)->un_member.rec_lock.space,			\
+		(lock)->un_member.rec_lock.page_no))
+
 /*********************************************************************//**
 Gets the type of a lock.
 @return LOCK_TABLE or LOCK_REC */
@@ -59,17 +59,43 @@ typedef ulint (*log_checksum_func_t)(const byte* log_block);
 log_sys->mutex. */
 extern log_checksum_func_t log_checksum_algorithm_ptr;
 
-/** Append a string to the log.
+/** Number of events that log_wait_up_to() callers are spread over */
+#define LOG_N_WAIT_EVENTS	64
+
+/** Reserve space for a string in the current log block.
+The caller must hold log_sys->mutex. The string must be copied with
+log_write_reserved() and the reservation released with
+log_write_reserved_complete(), which can be done after releasing the mutex.
 @param[in]	str		string
 @param[in]	len		string length
 @param[out]	start_lsn	start LSN of the log record
+@param[out]	ptr		where to copy the string
 @return end lsn of the log record, zero if did not succeed */
 UNIV_INLINE
 lsn_t
-log_reserve_and_write_fast(
+log_reserve_fast(
 	const void*	str,
 	ulint		len,
-	lsn_t*		start_lsn);
+	lsn_t*		start_lsn,
+	byte**		ptr);
+/** Copy a part of a string to the space that was reserved in the
+log buffer by log_reserve_fast() or log_reserve_low().
+The caller need not hold log_sys->mutex.
+@param[in]	ptr	current position in the reserved space
+@param[in]	str	string
+@param[in]	len	string length
+@return position after the copied string */
+UNIV_INLINE
+byte*
+log_write_reserved(
+	byte*		ptr,
+	const byte*	str,
+	ulint		len);
+/** Release a reservation after log_write_reserved() has copied
+the whole string. */
+UNIV_INLINE
+void
+log_write_reserved_complete();
 /***********************************************************************//**
 Checks if there is need for a log buffer flush or a new checkpoint, and does
 this if yes. Any database operation should call this when it has modified
@@ -101,6 +127,16 @@ log_margin_checkpoint_age(
 lsn_t
 log_reserve_and_open(
 	ulint	len);
+/** Reserve space in the log buffer for a string, and initialize the
+headers of any log blocks that it spans. It is assumed that the caller
+holds the log mutex and has invoked log_reserve_and_open(). The string
+must be copied with log_write_reserved() and the reservation released
+with log_write_reserved_complete(), which can be done after releasing
+the log mutex.
+@param[in]	len	string length
+@return where to copy the string */
+byte*
+log_reserve_low(ulint len);
 /************************************************************//**
 Writes to the log the string given. It is assumed that the caller holds the
 log mutex. */
@@ -189,6 +225,20 @@ log_write_up_to(
 	bool	flush_to_disk);
 			/*!< in: true if we want the written log
 			also to be flushed to disk */
+/** Wait for log_writer_thread and log_flusher_thread to write the log
+up to a given log entry (such as that of a transaction commit).
+If the threads are not running, invoke log_write_up_to() instead.
+@param[in]	lsn		log sequence number that should be
+included in the redo log file write
+@param[in]	flush_to_disk	whether the written log should also
+be flushed to the file system */
+void
+log_wait_up_to(
+	lsn_t	lsn,
+	bool	flush_to_disk);
+/** Start log_writer_thread and log_flusher_thread. */
+void
+log_writer_threads_start();
 /** write to the log file up to the last log entry.
 @param[in]	sync	whether we want the written log
 also to be flushed to disk. */
@@ -653,6 +703,13 @@ struct log_t{
 					groups */
 	volatile bool	is_extending;	/*!< this is set to true during extend
 					the log buffer size */
+	ulint		n_pending_copies;/*!< number of reservations made by
+					log_reserve_fast() or log_reserve_low()
+					whose contents have not been copied to
+					buf yet; buf must not be written,
+					switched or resized before this drops
+					to 0. Incremented while holding mutex,
+					decremented without it. */
 	lsn_t		write_lsn;	/*!< last written lsn */
 	lsn_t		current_flush_lsn;/*!< end lsn for the current running
 					write + flush operation */
@@ -666,6 +723,15 @@ struct log_t{
 					when a flush is running;
 					os_event_set() and os_event_reset()
 					are protected by log_sys_t::mutex */
+	os_event_t	writer_event;	/*!< set to wake up log_writer_thread */
+	os_event_t	flusher_event;	/*!< set to wake up log_flusher_thread */
+	os_event_t	wait_events[LOG_N_WAIT_EVENTS];
+					/*!< events that log_wait_up_to() waits
+					on, indexed by the log block number of
+					the awaited lsn; set by the writer and
+					flusher threads when write_lsn or
+					flushed_to_disk_lsn advances past
+					the block */
 	ulint		n_log_ios;	/*!< number of log i/os initiated thus
 					far */
 	ulint		n_log_ios_old;	/*!< number of log i/o's at the
@@ -796,6 +862,11 @@ extern os_event_t	log_scrub_event;
 /** Whether log_scrub_thread is active */
 extern bool		log_scrub_thread_active;
 
+/** Whether log_writer_thread is active */
+extern bool		log_writer_thread_active;
+/** Whether log_flusher_thread is active */
+extern bool		log_flusher_thread_active;
+
 #include "log0log.ic"
 
 #endif
@@ -289,6 +289,14 @@ struct recv_sys_t{
 	hash_table_t*	addr_hash;/*!< hash table of file addresses of pages */
 	ulint		n_addrs;/*!< number of not processed hashed file
 				addresses in the hash table */
+	ulint		n_apply_threads;
+				/*!< number of threads applying the
+				hashed log records to pages that are in
+				the buffer pool in the current batch;
+				see innodb_recovery_threads */
+	ulint		n_apply_threads_active;
+				/*!< number of those threads that have
+				not finished yet; protected by mutex */
 
 	recv_dblwr_t	dblwr;
 
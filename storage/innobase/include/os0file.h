@@ -1483,6 +1483,20 @@ os_aio_wait_until_no_pending_writes();
 void
 os_aio_simulated_wake_handler_threads();
 
+#ifdef HAVE_URING
+struct iovec;
+
+/** Register memory areas as fixed buffers with io_uring, so that reads
+and writes of buffers inside them avoid mapping the pages on each request.
+Requests that are already in progress keep using the buffers that were
+registered when they were submitted. Does nothing unless
+innodb_use_io_uring is in effect.
+@param[in]	iov	memory areas
+@param[in]	n	number of memory areas, or 0 to unregister all */
+void
+os_aio_register_buffers(const struct iovec* iov, ulint n);
+#endif /* HAVE_URING */
+
 #ifdef _WIN32
 /** This function can be called if one wants to post a batch of reads and
 prefers an i/o-handler thread to handle them all at once later. You must
@@ -171,6 +171,16 @@ row_ins_sec_index_entry(
 				/*!< in: if true, just do duplicate check
 				and return. don't execute actual insert. */
 	MY_ATTRIBUTE((warn_unused_result));
+/** Flag an intrinsic temporary table corrupted after a change to an
+index failed, unless it is known that no index was modified.
+@param[in]	index	the index whose modification failed
+@param[in]	err	error code
+@param[in]	ctx	context, for the error message */
+void
+row_ins_intrinsic_failed(
+	const dict_index_t*	index,
+	dberr_t			err,
+	const char*		ctx);
 /***********************************************************//**
 Inserts a row to a table. This is a high-level function used in
 SQL execution graphs.
@@ -103,7 +103,7 @@ struct row_merge_buf_t {
 struct merge_file_t {
 	int		fd;		/*!< file descriptor */
 	ulint		offset;		/*!< file offset (end of file) */
-	ib_uint64_t	n_rec;		/*!< number of records in the file */
+	ulint		n_rec;		/*!< number of records in the file */
 };
 
 /** Index field definition */
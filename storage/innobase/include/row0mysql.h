@@ -800,6 +800,11 @@ struct row_prebuilt_t {
 					fetched row in fetch_cache */
 	ulint		n_fetch_cached;	/*!< number of not yet fetched rows
 					in fetch_cache */
+	ulint		n_clust_read_ahead;/*!< number of secondary index
+					records whose clustered index leaf
+					pages were read ahead and which
+					have not been visited yet;
+					see innodb_clustered_read_ahead */
 	mem_heap_t*	blob_heap;	/*!< in SELECTS BLOB fields are copied
 					to this heap */
 	mem_heap_t*	old_vers_heap;	/*!< memory heap where a previous
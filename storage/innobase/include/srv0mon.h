@@ -316,6 +316,7 @@ enum monitor_id_t {
 	MONITOR_DML_PURGE_DELAY,
 	MONITOR_PURGE_STOP_COUNT,
 	MONITOR_PURGE_RESUME_COUNT,
+	MONITOR_PURGE_TRX_NO_LAG,
 
 	/* Recovery related counters */
 	MONITOR_MODULE_RECOVERY,
@@ -137,6 +137,11 @@ struct srv_stats_t
 	ulint_ctr_64_t          n_rowlog_blocks_encrypted;
 	/* Number of row log blocks decrypted */
 	ulint_ctr_64_t          n_rowlog_blocks_decrypted;
+	/** Number of row log blocks applied by multiple threads */
+	ulint_ctr_64_t		n_rowlog_blocks_parallel;
+	/** Number of times the row log was applied while ALTER TABLE
+	was waiting for the exclusive meta-data lock */
+	ulint_ctr_64_t		n_rowlog_background_applies;
 
 	/** Number of data read in total (in bytes) */
 	ulint_ctr_1_t		data_read;
@@ -267,6 +272,10 @@ extern ibool	srv_locks_unsafe_for_binlog;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Number of threads that scan the clustered index in index creation */
+extern ulong	srv_alter_scan_threads;
+/** Number of threads that apply the log of online table rebuild */
+extern ulong	srv_alter_log_apply_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -275,6 +284,9 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
+/** innodb_use_io_uring: whether to use io_uring for asynchronous I/O;
+reset to FALSE at startup if io_uring is not available */
+extern my_bool	srv_use_io_uring;
 extern my_bool	srv_numa_interleave;
 
 /* Use atomic writes i.e disable doublewrite buffer */
@@ -350,6 +362,10 @@ extern ulint	srv_log_buffer_size;
 extern ulong	srv_flush_log_at_trx_commit;
 extern uint	srv_flush_log_at_timeout;
 extern ulong	srv_log_write_ahead_size;
+/** innodb_log_writer_threads */
+extern my_bool	srv_log_writer_threads;
+/** innodb_recovery_threads */
+extern ulong	srv_n_recovery_threads;
 extern char	srv_adaptive_flushing;
 extern my_bool	srv_flush_sync;
 
@@ -380,6 +396,9 @@ extern const ulong	srv_buf_pool_instances_default;
 extern ulong	srv_n_page_hash_locks;
 /** Scan depth for LRU flush batch i.e.: number of blocks scanned*/
 extern ulong	srv_LRU_scan_depth;
+/** innodb_lru_manager; whether each buffer pool instance has its own
+thread for keeping the free list populated */
+extern my_bool	srv_lru_manager;
 /** Whether or not to flush neighbors of a block */
 extern ulong	srv_flush_neighbors;
 /** Previously requested size */
@@ -390,6 +409,8 @@ extern ulint	srv_buf_pool_base_size;
 extern ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 extern ulong	srv_buf_pool_dump_pct;
+/** Number of threads that read pages during BP load */
+extern ulong	srv_buf_pool_load_threads;
 #ifdef UNIV_DEBUG
 /** Abort load after this amount of pages */
 extern ulong srv_buf_pool_load_pages_abort;
@@ -400,6 +421,7 @@ extern ulint	srv_lock_table_size;
 extern ulint	srv_n_file_io_threads;
 extern my_bool	srv_random_read_ahead;
 extern ulong	srv_read_ahead_threshold;
+extern ulong	srv_clustered_read_ahead;
 extern ulint	srv_n_read_io_threads;
 extern ulint	srv_n_write_io_threads;
 
@@ -467,12 +489,18 @@ extern unsigned long long	srv_stats_transient_sample_pages;
 extern my_bool			srv_stats_persistent;
 extern unsigned long long	srv_stats_persistent_sample_pages;
 extern my_bool			srv_stats_auto_recalc;
+/** innodb_stats_incremental: whether the automatic recalculation of
+persistent statistics merges a smaller sample into the previous estimates */
+extern my_bool			srv_stats_incremental;
 extern my_bool			srv_stats_include_delete_marked;
 extern unsigned long long	srv_stats_modified_counter;
 extern my_bool			srv_stats_sample_traditional;
 
 extern ibool	srv_use_doublewrite_buf;
 extern ulong	srv_doublewrite_batch_size;
+/** innodb_doublewrite_files: number of files for the doublewrite buffer
+of LRU and flush_list batches, or 0 to use the system tablespace */
+extern ulong	srv_doublewrite_files;
 extern ulong	srv_checksum_algorithm;
 
 extern double	srv_max_buf_pool_modified_pct;
@@ -593,6 +621,7 @@ extern ulong srv_buf_dump_status_frequency;
 # ifdef UNIV_PFS_THREAD
 /* Keys to register InnoDB threads with performance schema */
 extern mysql_pfs_key_t	buf_dump_thread_key;
+extern mysql_pfs_key_t	buf_lru_manager_thread_key;
 extern mysql_pfs_key_t	dict_stats_thread_key;
 extern mysql_pfs_key_t	io_handler_thread_key;
 extern mysql_pfs_key_t	io_ibuf_thread_key;
@@ -601,8 +630,11 @@ extern mysql_pfs_key_t	io_read_thread_key;
 extern mysql_pfs_key_t	io_write_thread_key;
 extern mysql_pfs_key_t	page_cleaner_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
+extern mysql_pfs_key_t	row_merge_pscan_thread_key;
 extern mysql_pfs_key_t	srv_error_monitor_thread_key;
 extern mysql_pfs_key_t	srv_lock_timeout_thread_key;
+extern mysql_pfs_key_t	srv_lock_deadlock_thread_key;
 extern mysql_pfs_key_t	srv_master_thread_key;
 extern mysql_pfs_key_t	srv_monitor_thread_key;
 extern mysql_pfs_key_t	srv_purge_thread_key;
@@ -1019,6 +1051,12 @@ struct export_var_t{
 	ulint innodb_onlineddl_rowlog_pct_used; /*!< Online alter percentage
 						of used row log buffer */
 	ulint innodb_onlineddl_pct_progress;	/*!< Online alter progress */
+	ulint innodb_onlineddl_rowlog_blocks_parallel;
+					/*!< Online alter log blocks
+					applied by multiple threads */
+	ulint innodb_onlineddl_rowlog_background_applies;
+					/*!< Online alter log applies
+					in the background */
 
 #ifdef UNIV_DEBUG
 	ulint innodb_ahi_drop_lookups;		/*!< number of adaptive hash
@@ -160,6 +160,13 @@ V
 lock_sys_mutex				Mutex protecting lock_sys_t
 |
 V
+lock_sys_shards_latch			Latch on all record lock queues,
+|					X-locked with lock_sys_mutex,
+|					S-locked with lock_sys_shard_mutex
+V
+lock_sys_shard_mutex			Mutex protecting a subset of the
+|					record lock queues
+V
 trx_sys.mutex				Mutex protecting trx_sys_t
 |
 V
@@ -183,6 +190,9 @@ Log mutex
 Any other latch
 |
 V
+Buffer pool index_stats_mutex		Mutex protecting the per-index
+|					page counters
+V
 Memory pool mutex */
 
 /** Latching order levels. If you modify these, you have to also update
@@ -201,6 +211,8 @@ enum latch_level_t {
 
 	SYNC_MONITOR_MUTEX,
 
+	SYNC_BUF_INDEX_STATS,
+
 	SYNC_ANY_LATCH,
 
 	SYNC_DOUBLEWRITE,
@@ -235,6 +247,8 @@ enum latch_level_t {
 	SYNC_TRX,
 	SYNC_RW_TRX_HASH_ELEMENT,
 	SYNC_TRX_SYS,
+	SYNC_LOCK_SYS_SHARD,
+	SYNC_LOCK_SYS_SHARDS,
 	SYNC_LOCK_SYS,
 	SYNC_LOCK_WAIT_SYS,
 
@@ -300,6 +314,7 @@ enum latch_id_t {
 	LATCH_ID_BUF_BLOCK_MUTEX,
 	LATCH_ID_BUF_POOL,
 	LATCH_ID_BUF_POOL_ZIP,
+	LATCH_ID_BUF_INDEX_STATS,
 	LATCH_ID_CACHE_LAST_READ,
 	LATCH_ID_DICT_FOREIGN_ERR,
 	LATCH_ID_DICT_SYS,
@@ -344,6 +359,8 @@ enum latch_id_t {
 	LATCH_ID_TRX,
 	LATCH_ID_LOCK_SYS,
 	LATCH_ID_LOCK_SYS_WAIT,
+	LATCH_ID_LOCK_SYS_SHARD,
+	LATCH_ID_LOCK_SYS_SHARDS,
 	LATCH_ID_TRX_SYS,
 	LATCH_ID_SRV_SYS,
 	LATCH_ID_SRV_SYS_TASKS,
@@ -1178,10 +1195,16 @@ static inline void my_atomic_storelint(ulint *A, ulint B)
 {
   my_atomic_store64((volatile int64*)A, B);
 }
+
+static inline bool my_atomic_caslint(ulint *A, ulint *B, ulint C)
+{
+  return my_atomic_cas64((volatile int64*)A, (int64*)B, C);
+}
 #else
 #define my_atomic_addlint my_atomic_addlong
 #define my_atomic_loadlint my_atomic_loadlong
 #define my_atomic_storelint my_atomic_storelong
+#define my_atomic_caslint my_atomic_caslong
 #endif
 
 /** Simple counter aligned to CACHE_LINE_SIZE
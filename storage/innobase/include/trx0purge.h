@@ -483,6 +483,11 @@ class purge_sys_t
 	undo::Truncate	undo_trunc;	/*!< Track UNDO tablespace marked
 					for truncate. */
 
+	mem_heap_t*	heap;		/*!< Memory heap for the undo log
+					records of the current purge batch;
+					emptied when the next batch is
+					attached to the purge nodes */
+
 
   /**
     Constructor.
@@ -170,6 +170,15 @@ trx_undo_rec_get_partial_row(
 dberr_t
 trx_undo_report_rename(trx_t* trx, const dict_table_t* table)
 	MY_ATTRIBUTE((nonnull, warn_unused_result));
+/** Report that rows are about to be inserted into an empty table
+without writing undo log records for them. On rollback, the table
+will be emptied.
+@param[in,out]	trx	transaction
+@param[in]	table	empty table
+@return	DB_SUCCESS or error code */
+dberr_t
+trx_undo_report_empty(trx_t* trx, const dict_table_t* table)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
 /***********************************************************************//**
 Writes information to an undo log about an insert, update, or a delete marking
 of a clustered index record. This information is used in a rollback of the
@@ -275,6 +284,15 @@ trx_undo_rec_get_col_val(
         ulint*          len,
         ulint*          orig_len);
 
+/** Compute a hash value of the table id and the first primary key column
+of an undo log record. All undo log records of a clustered index record
+have the same value.
+@param[in]	undo_rec	undo log record
+@return hash value */
+ulint
+trx_undo_rec_get_row_fold(const trx_undo_rec_t* undo_rec)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+
 /** Read virtual column value from undo log
 @param[in]	table		the table
 @param[in]	ptr		undo log pointer
@@ -310,6 +328,8 @@ trx_undo_read_v_idx(
 compilation info multiplied by 16 is ORed to this value in an undo log
 record */
 
+#define	TRX_UNDO_EMPTY		8	/*!< insert into an empty table
+					without undo logging of the rows */
 #define	TRX_UNDO_RENAME_TABLE	9	/*!< RENAME TABLE */
 #define	TRX_UNDO_INSERT_DEFAULT	10	/*!< insert a "default value"
 					pseudo-record for instant ALTER */
@@ -776,6 +776,108 @@ class rw_trx_hash_t
 };
 
 
+/**
+  The most recent MVCC snapshot, shared by all read views that are opened
+  while no transaction identifier or serialisation number was allocated and
+  no read-write transaction was deregistered.
+
+  Protected by a sequence lock: m_seq is odd while the snapshot is being
+  written. Readers never wait: if the snapshot is being written, or was
+  rewritten while it was being copied, they fall back to iterating
+  rw_trx_hash. Every payload field is accessed with atomic operations, the
+  reader loads use ACQUIRE so that the closing m_seq load cannot be
+  reordered before them.
+*/
+class trx_snapshot_cache_t
+{
+public:
+  /** Maximum number of transaction identifiers in the snapshot. */
+  static const ulint N_IDS= 1024;
+
+  trx_snapshot_cache_t(): m_seq(0), m_max_trx_id(0), m_erased(~0ULL) {}
+
+  /**
+    Copies the cached snapshot if it was taken at the given version.
+
+    @param[out] ids        sorted identifiers of the registered transactions
+    @param[in]  max_trx_id m_max_trx_id value the snapshot must be taken at
+    @param[in]  erased     trx_sys_t::m_rw_trx_hash_erased value the snapshot
+                           must be taken at
+    @param[out] min_trx_no min(trx->no) of the snapshot
+    @return whether the snapshot was copied
+  */
+  bool load(trx_ids_t *ids, trx_id_t max_trx_id, trx_id_t erased,
+            trx_id_t *min_trx_no)
+  {
+    int64 seq= my_atomic_load64_explicit(&m_seq, MY_MEMORY_ORDER_ACQUIRE);
+    if ((seq & 1) ||
+        get(&m_max_trx_id) != max_trx_id || get(&m_erased) != erased)
+      return false;
+    ulint n= ulint(get(&m_n_ids));
+    if (n > N_IDS)
+      return false;
+    ids->resize(n);
+    for (ulint i= 0; i < n; i++)
+      (*ids)[i]= get(&m_ids[i]);
+    *min_trx_no= get(&m_min_trx_no);
+    return my_atomic_load64_explicit(&m_seq, MY_MEMORY_ORDER_RELAXED) == seq;
+  }
+
+
+  /**
+    Publishes a snapshot. Does nothing if it is too large or if another
+    thread is publishing a snapshot concurrently.
+
+    @param[in] ids        sorted identifiers of the registered transactions
+    @param[in] max_trx_id m_max_trx_id value the snapshot was taken at
+    @param[in] erased     trx_sys_t::m_rw_trx_hash_erased value the snapshot
+                          was taken at
+    @param[in] min_trx_no min(trx->no) of the snapshot
+  */
+  void store(const trx_ids_t &ids, trx_id_t max_trx_id, trx_id_t erased,
+             trx_id_t min_trx_no)
+  {
+    const ulint n= ids.size();
+    int64 seq= my_atomic_load64_explicit(&m_seq, MY_MEMORY_ORDER_RELAXED);
+    if (n > N_IDS || (seq & 1) || !my_atomic_cas64(&m_seq, &seq, seq + 1))
+      return;
+    set(&m_max_trx_id, max_trx_id);
+    set(&m_erased, erased);
+    set(&m_min_trx_no, min_trx_no);
+    set(&m_n_ids, n);
+    for (ulint i= 0; i < n; i++)
+      set(&m_ids[i], ids[i]);
+    my_atomic_store64_explicit(&m_seq, seq + 2, MY_MEMORY_ORDER_RELEASE);
+  }
+
+private:
+  static trx_id_t get(trx_id_t *field)
+  {
+    return static_cast<trx_id_t>(my_atomic_load64_explicit(
+      reinterpret_cast<int64*>(field), MY_MEMORY_ORDER_ACQUIRE));
+  }
+
+  static void set(trx_id_t *field, trx_id_t value)
+  {
+    my_atomic_store64_explicit(reinterpret_cast<int64*>(field), value,
+                               MY_MEMORY_ORDER_RELAXED);
+  }
+
+  /** Sequence number, odd while the snapshot is being written. */
+  MY_ALIGNED(CACHE_LINE_SIZE) int64 m_seq;
+  /** m_max_trx_id at the time the snapshot was taken. */
+  trx_id_t m_max_trx_id;
+  /** trx_sys_t::m_rw_trx_hash_erased at the time the snapshot was taken. */
+  trx_id_t m_erased;
+  /** min(trx->no) of the snapshot. */
+  trx_id_t m_min_trx_no;
+  /** Number of elements in m_ids. */
+  trx_id_t m_n_ids;
+  /** Sorted identifiers of the registered read-write transactions. */
+  trx_id_t m_ids[N_IDS];
+};
+
+
 /** The transaction system central memory data structure. */
 class trx_sys_t
 {
@@ -797,6 +899,23 @@ class trx_sys_t
   MY_ALIGNED(CACHE_LINE_SIZE) trx_id_t m_rw_trx_hash_version;
 
 
+  /**
+    Number of transactions removed from rw_trx_hash by deregister_rw().
+
+    m_max_trx_id and this counter together identify the contents of
+    rw_trx_hash from the MVCC snapshot point of view: as long as neither of
+    them changes, snapshot_ids() may reuse m_snapshot.
+
+    @sa deregister_rw()
+    @sa snapshot_ids()
+  */
+  MY_ALIGNED(CACHE_LINE_SIZE) trx_id_t m_rw_trx_hash_erased;
+
+
+  /** The most recent MVCC snapshot. */
+  trx_snapshot_cache_t m_snapshot;
+
+
   /**
     TRX_RSEG_HISTORY list length (number of committed transactions to purge)
   */
@@ -943,12 +1062,19 @@ class trx_sys_t
     We rely on get_rw_trx_hash_version() to issue ACQUIRE memory barrier so
     that loading of m_rw_trx_hash_version happens before accessing rw_trx_hash.
 
+    If no transaction identifier or serialisation number was allocated and no
+    transaction was deregistered since the previous snapshot was taken, the
+    previous snapshot is copied from m_snapshot instead of iterating
+    rw_trx_hash. Otherwise the new snapshot is published there for the views
+    that are opened next.
+
     To optimise snapshot creation rw_trx_hash.iterate() is being used instead
-    of rw_trx_hash.iterate_no_dups(). It means that some transaction
-    identifiers may appear multiple times in ids.
+    of rw_trx_hash.iterate_no_dups(). Duplicate identifiers are removed after
+    sorting.
 
     @param[in,out] caller_trx used to get access to rw_trx_hash_pins
-    @param[out]    ids        array to store registered transaction identifiers
+    @param[out]    ids        sorted array of registered transaction
+                              identifiers
     @param[out]    max_trx_id variable to store m_max_trx_id value
     @param[out]    mix_trx_no variable to store min(trx->no) value
   */
@@ -959,18 +1085,25 @@ class trx_sys_t
     ut_ad(!mutex_own(&mutex));
     snapshot_ids_arg arg(ids);
 
+    trx_id_t erased= get_rw_trx_hash_erased();
     while ((arg.m_id= get_rw_trx_hash_version()) != get_max_trx_id())
       ut_delay(1);
-    arg.m_no= arg.m_id;
+    *max_trx_id= arg.m_id;
+
+    if (m_snapshot.load(ids, arg.m_id, erased, min_trx_no))
+      return;
 
+    arg.m_no= arg.m_id;
     ids->clear();
     ids->reserve(rw_trx_hash.size() + 32);
     rw_trx_hash.iterate(caller_trx,
                         reinterpret_cast<my_hash_walk_action>(copy_one_id),
                         &arg);
+    std::sort(ids->begin(), ids->end());
+    ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
 
-    *max_trx_id= arg.m_id;
     *min_trx_no= arg.m_no;
+    m_snapshot.store(*ids, arg.m_id, erased, arg.m_no);
   }
 
 
@@ -978,6 +1111,7 @@ class trx_sys_t
   void init_max_trx_id(trx_id_t value)
   {
     m_max_trx_id= m_rw_trx_hash_version= value;
+    m_rw_trx_hash_erased= 0;
   }
 
 
@@ -1027,11 +1161,16 @@ class trx_sys_t
 
     Transaction is removed from rw_trx_hash, which releases all implicit locks.
     MVCC snapshot won't see this transaction anymore.
+
+    We rely on my_atomic_add64() to issue RELEASE memory barrier so that
+    m_rw_trx_hash_erased increment happens after transaction is removed from
+    rw_trx_hash, which invalidates m_snapshot.
   */
 
   void deregister_rw(trx_t *trx)
   {
     rw_trx_hash.erase(trx);
+    my_atomic_add64(reinterpret_cast<int64*>(&m_rw_trx_hash_erased), 1);
   }
 
 
@@ -1165,6 +1304,16 @@ class trx_sys_t
   }
 
 
+  /** Getter for m_rw_trx_hash_erased, must issue ACQUIRE memory barrier. */
+  trx_id_t get_rw_trx_hash_erased()
+  {
+    return static_cast<trx_id_t>
+           (my_atomic_load64_explicit(reinterpret_cast<int64*>
+                                      (&m_rw_trx_hash_erased),
+                                      MY_MEMORY_ORDER_ACQUIRE));
+  }
+
+
   /** Increments m_rw_trx_hash_version, must issue RELEASE memory barrier. */
   void refresh_rw_trx_hash_version()
   {
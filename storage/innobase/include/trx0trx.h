@@ -623,6 +623,9 @@ class trx_mod_table_time_t
 	undo_no_t	first;
 	/** First modification of a system versioned column */
 	undo_no_t	first_versioned;
+	/** Whether the table was empty and rows are being inserted
+	into it without undo log records (innodb_bulk_insert) */
+	bool		bulk;
 
 	/** Magic value signifying that a system versioned column of a
 	table was never modified in a transaction. */
@@ -632,7 +635,7 @@ class trx_mod_table_time_t
 	/** Constructor
 	@param[in]	rows	number of modified rows so far */
 	trx_mod_table_time_t(undo_no_t rows)
-		: first(rows), first_versioned(UNVERSIONED) {}
+		: first(rows), first_versioned(UNVERSIONED), bulk(false) {}
 
 #ifdef UNIV_DEBUG
 	/** Validation
@@ -655,6 +658,25 @@ class trx_mod_table_time_t
 		ut_ad(valid());
 	}
 
+	/** After writing a TRX_UNDO_EMPTY record, start inserting
+	rows without undo log records */
+	void start_bulk_insert()
+	{
+		ut_ad(!bulk);
+		bulk = true;
+	}
+
+	/** @return whether rows can be inserted without undo log records
+	@param[in]	stmt_start	number of modified rows when the current
+	SQL statement started */
+	bool is_bulk_insert(undo_no_t stmt_start) const
+	{
+		/* The bulk insert is confined to the statement that
+		started it, so that ROLLBACK TO SAVEPOINT will never
+		have to remove some rows without undo log records. */
+		return bulk && first >= stmt_start;
+	}
+
 	/** Invoked after partial rollback
 	@param[in]	limit	number of surviving modified rows
 	@return	whether this should be erased from trx_t::mod_tables */
@@ -896,6 +918,9 @@ struct trx_t {
 					for secondary indexes when we decide
 					if we can use the insert buffer for
 					them, we set this FALSE */
+	bool		bulk_insert;	/*!< innodb_bulk_insert: whether
+					rows may be inserted into an empty
+					table without undo log records */
 	bool		flush_log_later;/* In 2PC, we hold the
 					prepare_commit mutex across
 					both phases. In that case, we
@@ -24,6 +24,7 @@ INCLUDE(lzo.cmake)
 INCLUDE(lzma.cmake)
 INCLUDE(bzip2.cmake)
 INCLUDE(snappy.cmake)
+INCLUDE(zstd.cmake)
 INCLUDE(numa)
 
 MYSQL_CHECK_LZ4()
@@ -31,6 +32,7 @@ MYSQL_CHECK_LZO()
 MYSQL_CHECK_LZMA()
 MYSQL_CHECK_BZIP2()
 MYSQL_CHECK_SNAPPY()
+MYSQL_CHECK_ZSTD()
 MYSQL_CHECK_NUMA()
 
 IF(CMAKE_CROSSCOMPILING)
@@ -66,6 +68,19 @@ IF(UNIX)
       ADD_DEFINITIONS(-DLINUX_NATIVE_AIO=1)
       LINK_LIBRARIES(aio)
     ENDIF()
+
+    CHECK_C_SOURCE_COMPILES("
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+int main()
+{
+  return __NR_io_uring_setup + __NR_io_uring_enter + __NR_io_uring_register
+    + IORING_OP_READ_FIXED + IORING_REGISTER_BUFFERS;
+}" HAVE_URING)
+
+    IF(HAVE_URING)
+      ADD_DEFINITIONS(-DHAVE_URING=1)
+    ENDIF()
     IF(HAVE_LIBNUMA)
       LINK_LIBRARIES(numa)
     ENDIF()
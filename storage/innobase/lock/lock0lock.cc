@@ -46,6 +46,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "row0mysql.h"
 #include "row0vers.h"
 #include "pars0pars.h"
+#include "sync0sync.h"
 
 #include <set>
 
@@ -59,6 +60,9 @@ ulong innodb_lock_schedule_algorithm;
 /** The value of innodb_deadlock_detect */
 my_bool	innobase_deadlock_detect;
 
+/** The value of innodb_deadlock_detect_background */
+my_bool	innobase_deadlock_detect_background;
+
 /** Total number of cached record locks */
 static const ulint	REC_LOCK_CACHE = 8;
 
@@ -123,7 +127,25 @@ class DeadlockChecker {
 		const lock_t*	lock,
 		trx_t*		trx);
 
+	/** Check the transactions that started to wait for a lock
+	since the previous call, in lock_sys.deadlock_waiters.
+	This is invoked by lock_deadlock_detect_thread when
+	innodb_deadlock_detect_background=ON. */
+	static void check_all();
+
 private:
+	/** Search for the deadlocks that a lock request is part of,
+	and roll back victims until the request is no longer part of any.
+	@param[in]	lock		lock the transaction is waiting for
+	@param[in]	trx		the waiting transaction
+	@param[in]	report_waiters	whether to invoke
+					thd_rpl_deadlock_check()
+	@return trx if it was chosen as the victim, or NULL */
+	static const trx_t* resolve(
+		const lock_t*	lock,
+		const trx_t*	trx,
+		bool		report_waiters);
+
 	/** Do a shallow copy. Default destructor OK.
 	@param trx the start transaction (start node)
 	@param wait_lock lock that a transaction wants
@@ -484,7 +506,15 @@ void lock_sys_t::create(ulint n_cells)
 
 	mutex_create(LATCH_ID_LOCK_SYS_WAIT, &wait_mutex);
 
+	for (ulint i = 0; i < N_REC_SHARDS; i++) {
+		mutex_create(LATCH_ID_LOCK_SYS_SHARD, &rec_shards[i].mutex);
+	}
+
+	rw_lock_create(lock_shards_latch_key, &rec_shards_latch,
+		       SYNC_LOCK_SYS_SHARDS);
+
 	timeout_event = os_event_create(0);
+	deadlock_event = os_event_create(0);
 
 	rec_hash = hash_create(n_cells);
 	prdt_hash = hash_create(n_cells);
@@ -518,7 +548,7 @@ void lock_sys_t::resize(ulint n_cells)
 {
 	ut_ad(this == &lock_sys);
 
-	mutex_enter(&mutex);
+	lock_mutex_enter();
 
 	hash_table_t* old_hash = rec_hash;
 	rec_hash = hash_create(n_cells);
@@ -563,7 +593,30 @@ void lock_sys_t::resize(ulint n_cells)
 		buf_pool_mutex_exit(buf_pool);
 	}
 
-	mutex_exit(&mutex);
+	lock_mutex_exit();
+}
+
+
+/**
+  Acquire the record lock shard latch of a page, without acquiring
+  lock_sys.mutex. The caller must not hold any lock_sys latch.
+
+  @param[in] block index page
+  @return the acquired latch, to be released with rec_shard_exit()
+*/
+LockMutex* lock_sys_t::rec_shard_enter(const buf_block_t* block)
+{
+	ut_ad(!lock_mutex_own());
+
+	/* resize() changes block->lock_hash_val while holding
+	rec_shards_latch in exclusive mode, so the value is stable. */
+	rw_lock_s_lock(&rec_shards_latch);
+
+	LockMutex*	shard = &rec_shard(buf_block_get_lock_hash_val(block));
+
+	mutex_enter(shard);
+
+	return(shard);
 }
 
 
@@ -584,10 +637,23 @@ void lock_sys_t::close()
 	hash_table_free(prdt_page_hash);
 
 	os_event_destroy(timeout_event);
+	os_event_destroy(deadlock_event);
+	trx_vector_t().swap(deadlock_waiters);
 
 	mutex_destroy(&mutex);
 	mutex_destroy(&wait_mutex);
 
+	for (ulint i = 0; i < N_REC_SHARDS; i++) {
+		mutex_destroy(&rec_shards[i].mutex);
+	}
+
+	rw_lock_free(&rec_shards_latch);
+	/* rw_lock_free() already called rec_shards_latch.~rw_lock_t();
+	tame the debug assertions when the destructor will be called
+	once more. */
+	ut_ad(rec_shards_latch.magic_n == 0);
+	ut_d(rec_shards_latch.magic_n = RW_LOCK_MAGIC_N);
+
 	for (ulint i = srv_max_n_threads; i--; ) {
 		if (os_event_t& event = waiting_threads[i].event) {
 			os_event_destroy(event);
@@ -1024,7 +1090,7 @@ lock_rec_has_expl(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(block));
 	ut_ad((precise_mode & LOCK_MODE_MASK) == LOCK_S
 	      || (precise_mode & LOCK_MODE_MASK) == LOCK_X);
 	ut_ad(!(precise_mode & LOCK_INSERT_INTENTION));
@@ -1073,7 +1139,7 @@ lock_rec_other_has_expl_req(
 					are taken into account */
 {
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(block));
 	ut_ad(mode == LOCK_X || mode == LOCK_S);
 
 	/* Only GAP lock can be on SUPREMUM, and we are not looking for
@@ -1186,7 +1252,7 @@ lock_rec_other_has_conflicting(
 {
 	lock_t*		lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(block));
 
 	bool	is_supremum = (heap_no == PAGE_HEAP_NO_SUPREMUM);
 
@@ -1365,7 +1431,7 @@ lock_rec_create_low(
 	ulint		n_bits;
 	ulint		n_bytes;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_sys.rec_own(lock_rec_hash(space, page_no)));
 	ut_ad(holds_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1434,7 +1500,9 @@ lock_rec_create_low(
  	}
 	lock_rec_bitmap_reset(lock);
 	lock_rec_set_nth_bit(lock, heap_no);
-	index->table->n_rec_locks++;
+	/* Record locks on different pages of the table may be
+	created concurrently under different record lock shard latches. */
+	my_atomic_addlint(&index->table->n_rec_locks, 1);
 	ut_ad(index->table->n_ref_count > 0 || !index->table->can_be_evicted);
 
 #ifdef WITH_WSREP
@@ -1527,8 +1595,8 @@ lock_rec_create_low(
 	if (!holds_trx_mutex) {
 		trx_mutex_exit(trx);
 	}
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return lock;
 }
@@ -1826,7 +1894,7 @@ lock_rec_add_to_queue(
 					transaction mutex */
 {
 #ifdef UNIV_DEBUG
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(block));
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index)
 	      || dict_index_get_online_status(index) != ONLINE_INDEX_CREATION);
@@ -1936,6 +2004,11 @@ possible, enqueues a waiting lock request. This is a low-level function
 which does NOT look at implicit locks! Checks lock compatibility within
 explicit locks. This function sets a normal next-key lock, or in the case
 of a page supremum record, a gap type lock.
+
+The request is first attempted while holding only the record lock shard
+latch of the page. Only if another transaction holds a conflicting lock,
+so that we may have to wait and check for deadlocks, is the request
+retried under the global lock_sys.mutex.
 @return DB_SUCCESS, DB_SUCCESS_LOCKED_REC, DB_LOCK_WAIT, or DB_DEADLOCK */
 static
 dberr_t
@@ -1965,8 +2038,22 @@ lock_rec_lock(
         (mode & LOCK_TYPE_MASK) == 0);
   ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
   DBUG_EXECUTE_IF("innodb_report_deadlock", return DB_DEADLOCK;);
+  MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+
+  /* Galera conflict resolution may cancel the waits of other
+  transactions, which requires the global lock_sys.mutex. */
+  bool global= false;
+#ifdef WITH_WSREP
+  global= wsrep_on_trx(trx);
+#endif /* WITH_WSREP */
+
+retry:
+  LockMutex *shard= NULL;
+  if (global)
+    lock_mutex_enter();
+  else
+    shard= lock_sys.rec_shard_enter(block);
 
-  lock_mutex_enter();
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_S ||
         lock_table_has(trx, index->table, LOCK_IS));
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_X ||
@@ -1989,6 +2076,15 @@ lock_rec_lock(
 #endif
 	    lock_rec_other_has_conflicting(mode, block, heap_no, trx))
         {
+          if (!global)
+          {
+            /* We may have to wait. Retry under lock_sys.mutex,
+            which is needed for deadlock detection. */
+            trx_mutex_exit(trx);
+            lock_sys.rec_shard_exit(shard);
+            global= true;
+            goto retry;
+          }
           /*
             If another transaction has a non-gap conflicting
             request in the queue, as this transaction does not
@@ -2038,8 +2134,11 @@ lock_rec_lock(
 
     err= DB_SUCCESS_LOCKED_REC;
   }
-  lock_mutex_exit();
-  MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+
+  if (global)
+    lock_mutex_exit();
+  else
+    lock_sys.rec_shard_exit(shard);
   return err;
 }
 
@@ -3951,17 +4050,18 @@ lock_table(
 	return(err);
 }
 
-/*********************************************************************//**
-Creates a table IX lock object for a resurrected transaction. */
+/** Create a table lock object for a resurrected transaction.
+@param[in,out]	table	table
+@param[in,out]	trx	recovered transaction
+@param[in]	mode	LOCK_IX, or LOCK_X if the transaction wrote
+			a TRX_UNDO_EMPTY record for the table */
 void
-lock_table_ix_resurrect(
-/*====================*/
-	dict_table_t*	table,	/*!< in/out: table */
-	trx_t*		trx)	/*!< in/out: transaction */
+lock_table_resurrect(dict_table_t* table, trx_t* trx, lock_mode mode)
 {
 	ut_ad(trx->is_recovered);
+	ut_ad(mode == LOCK_IX || mode == LOCK_X);
 
-	if (lock_table_has(trx, table, LOCK_IX)) {
+	if (lock_table_has(trx, table, mode)) {
 		return;
 	}
 
@@ -3971,10 +4071,10 @@ lock_table_ix_resurrect(
 	other transactions have in the table lock queue. */
 
 	ut_ad(!lock_table_other_has_incompatible(
-		      trx, LOCK_WAIT, table, LOCK_IX));
+		      trx, LOCK_WAIT, table, mode));
 
 	trx_mutex_enter(trx);
-	lock_table_create(table, LOCK_IX, trx);
+	lock_table_create(table, mode, trx);
 	lock_mutex_exit();
 	trx_mutex_exit(trx);
 }
@@ -5359,7 +5459,22 @@ lock_rec_insert_check_and_lock(
 	ulint		heap_no = page_rec_get_heap_no(next_rec);
 	ut_ad(!rec_is_default_row(next_rec, index));
 
-	lock_mutex_enter();
+	/* Galera conflict resolution may cancel the waits of other
+	transactions, which requires the global lock_sys.mutex. */
+	bool		global = false;
+#ifdef WITH_WSREP
+	global = wsrep_on_trx(trx);
+#endif /* WITH_WSREP */
+	/* Unless we have to wait, it suffices to hold the record lock
+	shard latch of the page. */
+	LockMutex*	shard = NULL;
+retry:
+	if (global) {
+		lock_mutex_enter();
+	} else {
+		shard = lock_sys.rec_shard_enter(block);
+	}
+
 	/* Because this code is invoked for a running transaction by
 	the thread that is serving the transaction, it is not necessary
 	to hold trx->mutex here. */
@@ -5374,7 +5489,11 @@ lock_rec_insert_check_and_lock(
 	if (lock == NULL) {
 		/* We optimize CPU time usage in the simplest case */
 
-		lock_mutex_exit();
+		if (global) {
+			lock_mutex_exit();
+		} else {
+			lock_sys.rec_shard_exit(shard);
+		}
 
 		if (inherit_in && !dict_index_is_clust(index)) {
 			/* Update the page max trx id field */
@@ -5413,6 +5532,14 @@ lock_rec_insert_check_and_lock(
 	    lock_t* c_lock =
 #endif /* WITH_WSREP */
 	    lock_rec_other_has_conflicting(type_mode, block, heap_no, trx)) {
+		if (!global) {
+			/* Retry under lock_sys.mutex, which is needed
+			for enqueueing a waiting request. */
+			lock_sys.rec_shard_exit(shard);
+			global = true;
+			goto retry;
+		}
+
 		/* Note that we may get DB_SUCCESS also here! */
 		trx_mutex_enter(trx);
 
@@ -5427,7 +5554,11 @@ lock_rec_insert_check_and_lock(
 		err = DB_SUCCESS;
 	}
 
-	lock_mutex_exit();
+	if (global) {
+		lock_mutex_exit();
+	} else {
+		lock_sys.rec_shard_exit(shard);
+	}
 
 	switch (err) {
 	case DB_SUCCESS_LOCKED_REC:
@@ -6523,6 +6654,14 @@ lock_set_timeout_event()
 	os_event_set(lock_sys.timeout_event);
 }
 
+/** Resolve the deadlocks of the transactions that started to wait for a
+lock since the previous call. Invoked by lock_deadlock_detect_thread. */
+void
+lock_deadlock_check_all()
+{
+	DeadlockChecker::check_all();
+}
+
 #ifdef UNIV_DEBUG
 /*******************************************************************//**
 Check if the transaction holds any locks on the sys tables
@@ -7031,6 +7170,18 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 		return(NULL);
 	}
 
+	const bool	report_waiters = trx->mysql_thd
+		&& thd_need_wait_reports(trx->mysql_thd);
+
+	/* Leave the search to lock_deadlock_detect_thread, unless
+	the waits must be reported to parallel replication. */
+	if (innobase_deadlock_detect_background && !report_waiters
+	    && lock_sys.deadlock_thread_active) {
+		lock_sys.deadlock_waiters.push_back(trx);
+		os_event_set(lock_sys.deadlock_event);
+		return(NULL);
+	}
+
 	/*  Release the mutex to obey the latching order.
 	This is safe, because DeadlockChecker::check_and_resolve()
 	is invoked when a lock wait is enqueued for the currently
@@ -7041,9 +7192,29 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 
 	trx_mutex_exit(trx);
 
+	const trx_t*	victim_trx = resolve(lock, trx, report_waiters);
+
+	trx_mutex_enter(trx);
+
+	return(victim_trx);
+}
+
+/** Search for the deadlocks that a lock request is part of, and roll back
+victims until the request is no longer part of any.
+@param[in]	lock		lock the transaction is waiting for
+@param[in]	trx		the waiting transaction
+@param[in]	report_waiters	whether to invoke thd_rpl_deadlock_check()
+@return trx if it was chosen as the victim, or NULL */
+const trx_t*
+DeadlockChecker::resolve(
+	const lock_t*	lock,
+	const trx_t*	trx,
+	bool		report_waiters)
+{
+	ut_ad(lock_mutex_own());
+	ut_ad(!trx_mutex_own(trx));
+
 	const trx_t*	victim_trx;
-	const bool	report_waiters = trx->mysql_thd
-		&& thd_need_wait_reports(trx->mysql_thd);
 
 	/* Try and resolve as many deadlocks as possible. */
 	do {
@@ -7088,11 +7259,47 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 		lock_deadlock_found = true;
 	}
 
-	trx_mutex_enter(trx);
-
 	return(victim_trx);
 }
 
+/** Check the transactions that started to wait for a lock since the
+previous call. Any new cycle in the wait-for graph was closed by one of
+them, so the graph is only searched from these transactions, and only
+while holding lock_sys.mutex for one of them at a time. */
+void
+DeadlockChecker::check_all()
+{
+	ut_ad(!lock_mutex_own());
+
+	lock_sys_t::trx_vector_t	waiters;
+
+	lock_mutex_enter();
+	waiters.swap(lock_sys.deadlock_waiters);
+	lock_mutex_exit();
+
+	for (ulint i = 0; i < waiters.size(); i++) {
+		trx_t*	trx = waiters[i];
+
+		lock_mutex_enter();
+
+		/* The transaction may have been granted its lock or
+		chosen as a victim meanwhile. The transaction objects are
+		never freed while the server is running, so it is safe to
+		look at them. */
+		if (const lock_t* lock = trx->lock.wait_lock) {
+			if (resolve(lock, trx, false) && trx->lock.wait_lock) {
+				trx_mutex_enter(trx);
+				trx->lock.was_chosen_as_deadlock_victim = true;
+				lock_cancel_waiting_and_release(
+					trx->lock.wait_lock);
+				trx_mutex_exit(trx);
+			}
+		}
+
+		lock_mutex_exit();
+	}
+}
+
 /**
 Allocate cached locks for the transaction.
 @param trx		allocate cached record locks for this transaction */
@@ -586,3 +586,57 @@ DECLARE_THREAD(lock_wait_timeout_thread)(void*)
 	OS_THREAD_DUMMY_RETURN;
 }
 
+/** A thread which resolves the deadlocks between waiting transactions
+when innodb_deadlock_detect_background is set. Lock waits only add the
+transaction to lock_sys.deadlock_waiters and signal
+lock_sys.deadlock_event, and this thread searches the wait-for graph
+from those transactions. innodb_lock_wait_timeout remains the backstop
+for any deadlock that is not detected.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(lock_deadlock_detect_thread)(void*)
+{
+	int64_t		sig_count = 0;
+	os_event_t	event = lock_sys.deadlock_event;
+
+	ut_ad(!srv_read_only_mode);
+	my_thread_init();
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(srv_lock_deadlock_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	do {
+		os_event_wait_low(event, sig_count);
+		sig_count = os_event_reset(event);
+
+		if (srv_shutdown_state >= SRV_SHUTDOWN_CLEANUP) {
+			break;
+		}
+
+		if (innobase_deadlock_detect
+		    && innobase_deadlock_detect_background) {
+			lock_deadlock_check_all();
+		}
+	} while (srv_shutdown_state < SRV_SHUTDOWN_CLEANUP);
+
+	lock_sys.deadlock_thread_active = false;
+
+	my_thread_end();
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start lock_deadlock_detect_thread, unless it is already running. */
+void
+lock_deadlock_detect_start()
+{
+	ut_ad(!srv_read_only_mode);
+
+	if (!lock_sys.deadlock_thread_active) {
+		lock_sys.deadlock_thread_active = true;
+		os_thread_create(lock_deadlock_detect_thread, NULL, NULL);
+	}
+}
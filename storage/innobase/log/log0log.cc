@@ -132,6 +132,11 @@ extern "C" UNIV_INTERN
 os_thread_ret_t
 DECLARE_THREAD(log_scrub_thread)(void*);
 
+/** Whether log_writer_thread is active */
+bool		log_writer_thread_active;
+/** Whether log_flusher_thread is active */
+bool		log_flusher_thread_active;
+
 /******************************************************//**
 Completes a checkpoint write i/o to a log file. */
 static
@@ -162,6 +167,25 @@ log_buf_pool_get_oldest_modification(void)
 	return(lsn);
 }
 
+/** Wait until the strings reserved by log_reserve_fast() or
+log_reserve_low() have been copied to the log buffer. New reservations
+are blocked by the caller holding log_sys->mutex. */
+static
+void
+log_wait_for_pending_copies()
+{
+	ut_ad(log_mutex_own());
+
+	for (ulint i = 0; my_atomic_loadlint(&log_sys->n_pending_copies);
+	     i++) {
+		if (i < srv_n_spin_wait_rounds) {
+			ut_delay(srv_spin_wait_delay);
+		} else {
+			os_thread_yield();
+		}
+	}
+}
+
 /** Extends the log buffer.
 @param[in]	len	requested minimum size in bytes */
 void
@@ -214,6 +238,8 @@ log_buffer_extend(
 		log_mutex_enter_all();
 	}
 
+	log_wait_for_pending_copies();
+
 	move_start = ut_calc_align_down(
 		log_sys->buf_free,
 		OS_FILE_LOG_BLOCK_SIZE);
@@ -401,14 +427,16 @@ log_reserve_and_open(
 	return(log_sys->lsn);
 }
 
-/************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
+/** Advance log_sys->buf_free and log_sys->lsn over a string, and
+initialize the headers of any log blocks that it spans.
+@param[in]	str	string to copy, or NULL if the caller will copy
+it later by log_write_reserved()
+@param[in]	str_len	string length */
+static
 void
-log_write_low(
-/*==========*/
-	const byte*	str,		/*!< in: string */
-	ulint		str_len)	/*!< in: string length */
+log_write_or_reserve_low(
+	const byte*	str,
+	ulint		str_len)
 {
 	log_t*	log	= log_sys;
 	ulint	len;
@@ -434,10 +462,12 @@ log_write_low(
 			- LOG_BLOCK_TRL_SIZE;
 	}
 
-	ut_memcpy(log->buf + log->buf_free, str, len);
+	if (str) {
+		ut_memcpy(log->buf + log->buf_free, str, len);
+		str = str + len;
+	}
 
 	str_len -= len;
-	str = str + len;
 
 	log_block = static_cast<byte*>(
 		ut_align_down(
@@ -471,6 +501,38 @@ log_write_low(
 	srv_stats.log_write_requests.inc();
 }
 
+/** Reserve space in the log buffer for a string, and initialize the
+headers of any log blocks that it spans. It is assumed that the caller
+holds the log mutex and has invoked log_reserve_and_open(). The string
+must be copied with log_write_reserved() and the reservation released
+with log_write_reserved_complete(), which can be done after releasing
+the log mutex.
+@param[in]	len	string length
+@return where to copy the string */
+byte*
+log_reserve_low(ulint len)
+{
+	byte*	ptr = log_sys->buf + log_sys->buf_free;
+
+	ut_ad(len > 0);
+	my_atomic_addlint(&log_sys->n_pending_copies, 1);
+	log_write_or_reserve_low(NULL, len);
+
+	return(ptr);
+}
+
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+void
+log_write_low(
+/*==========*/
+	const byte*	str,		/*!< in: string */
+	ulint		str_len)	/*!< in: string length */
+{
+	log_write_or_reserve_low(str, str_len);
+}
+
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -1054,7 +1116,9 @@ log_write_flush_to_disk_low()
 
 	bool	do_flush = srv_file_flush_method != SRV_O_DSYNC;
 
-	if (do_flush) {
+	/* With innodb_flush_method=nosync the log file is not synced,
+	but flushed_to_disk_lsn is advanced all the same. */
+	if (do_flush && srv_file_flush_method != SRV_NOSYNC) {
 		fil_flush(SRV_LOG_SPACE_FIRST_ID);
 	}
 
@@ -1214,6 +1278,11 @@ log_write_up_to(
 		}
 	}
 
+	/* Mini-transactions copy their log records to the buffer
+	after releasing log_sys->mutex. Wait for them before writing
+	or switching the buffer. */
+	log_wait_for_pending_copies();
+
 	start_offset = log_sys->buf_next_to_write;
 	end_offset = log_sys->buf_free;
 
@@ -1298,6 +1367,213 @@ log_write_up_to(
 	}
 }
 
+/** @return the event that log_wait_up_to() waits on for an lsn
+@param[in]	lsn	log sequence number */
+static inline
+os_event_t
+log_wait_event(lsn_t lsn)
+{
+	return(log_sys->wait_events[(lsn / OS_FILE_LOG_BLOCK_SIZE)
+				    % LOG_N_WAIT_EVENTS]);
+}
+
+/** @return how far the log has been written or flushed
+@param[in]	flush_to_disk	whether to return flushed_to_disk_lsn
+				instead of write_lsn */
+static inline
+lsn_t
+log_get_written_lsn(bool flush_to_disk)
+{
+#if UNIV_WORD_SIZE > 7
+	/* We can do a dirty read of LSN. */
+	return(flush_to_disk
+	       ? log_sys->flushed_to_disk_lsn : log_sys->write_lsn);
+#else
+	if (flush_to_disk) {
+		return(log_get_flush_lsn());
+	}
+
+	log_write_mutex_enter();
+	lsn_t	lsn = log_sys->write_lsn;
+	log_write_mutex_exit();
+	return(lsn);
+#endif
+}
+
+/** Wake up the log_wait_up_to() callers that are waiting for an lsn
+in the range (old_lsn, new_lsn].
+@param[in]	old_lsn	write_lsn or flushed_to_disk_lsn when the
+			waiters were last woken up
+@param[in]	new_lsn	current write_lsn or flushed_to_disk_lsn */
+static
+void
+log_wake_waiters(lsn_t old_lsn, lsn_t new_lsn)
+{
+	lsn_t	first = old_lsn / OS_FILE_LOG_BLOCK_SIZE;
+	lsn_t	last = new_lsn / OS_FILE_LOG_BLOCK_SIZE;
+
+	if (last - first >= LOG_N_WAIT_EVENTS) {
+		first = 0;
+		last = LOG_N_WAIT_EVENTS - 1;
+	}
+
+	for (lsn_t i = first; i <= last; i++) {
+		os_event_set(log_sys->wait_events[i % LOG_N_WAIT_EVENTS]);
+	}
+}
+
+/** Wait for log_writer_thread and log_flusher_thread to write the log
+up to a given log entry (such as that of a transaction commit).
+If the threads are not running, invoke log_write_up_to() instead.
+@param[in]	lsn		log sequence number that should be
+included in the redo log file write
+@param[in]	flush_to_disk	whether the written log should also
+be flushed to the file system */
+void
+log_wait_up_to(
+	lsn_t	lsn,
+	bool	flush_to_disk)
+{
+	ut_ad(!srv_read_only_mode);
+
+	if (!log_writer_thread_active || !log_flusher_thread_active) {
+		log_write_up_to(lsn, flush_to_disk);
+		return;
+	}
+
+	if (log_get_written_lsn(flush_to_disk) >= lsn) {
+		return;
+	}
+
+	os_event_t	event = log_wait_event(lsn);
+
+	for (;;) {
+		int64_t	sig_count = os_event_reset(event);
+
+		if (log_get_written_lsn(flush_to_disk) >= lsn) {
+			return;
+		}
+
+		if (!log_writer_thread_active || !log_flusher_thread_active) {
+			log_write_up_to(lsn, flush_to_disk);
+			return;
+		}
+
+		os_event_set(log_get_written_lsn(false) < lsn
+			     ? log_sys->writer_event
+			     : log_sys->flusher_event);
+
+		/* The timeout is only a safety net in case the threads
+		exit while we are waiting. */
+		os_event_wait_time_low(event, 100000, sig_count);
+	}
+}
+
+/******************************************************************//**
+This is the main thread of the background log writer. It writes the log
+buffer to the log file whenever it contains something, and wakes up the
+log_flusher_thread and the log_wait_up_to() callers.
+@return this function does not return, it calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(void*)
+{
+	ut_ad(!srv_read_only_mode);
+
+	lsn_t	notified_lsn = log_get_written_lsn(false);
+
+	while (srv_shutdown_state < SRV_SHUTDOWN_FLUSH_PHASE) {
+		int64_t	sig_count = os_event_reset(log_sys->writer_event);
+		lsn_t	lsn = log_get_lsn();
+
+		if (lsn > log_get_written_lsn(false)) {
+			log_write_up_to(lsn, false);
+		}
+
+		lsn = log_get_written_lsn(false);
+
+		if (lsn > notified_lsn) {
+			os_event_set(log_sys->flusher_event);
+			log_wake_waiters(notified_lsn, lsn);
+			notified_lsn = lsn;
+			continue;
+		}
+
+		os_event_wait_time_low(log_sys->writer_event, 1000000,
+				       sig_count);
+	}
+
+	log_writer_thread_active = false;
+	log_wake_waiters(0, LSN_MAX);
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+This is the main thread of the background log flusher. It flushes the
+log file after log_writer_thread has written to it, and wakes up the
+log_wait_up_to() callers. Commits that arrive while the file is being
+flushed will be covered by the next flush.
+@return this function does not return, it calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(void*)
+{
+	ut_ad(!srv_read_only_mode);
+
+	lsn_t	notified_lsn = log_get_written_lsn(true);
+
+	while (srv_shutdown_state < SRV_SHUTDOWN_FLUSH_PHASE) {
+		int64_t	sig_count = os_event_reset(log_sys->flusher_event);
+		lsn_t	lsn = log_get_written_lsn(false);
+
+		if (lsn > log_get_written_lsn(true)) {
+			log_write_up_to(lsn, true);
+		}
+
+		lsn = log_get_written_lsn(true);
+
+		if (lsn > notified_lsn) {
+			log_wake_waiters(notified_lsn, lsn);
+			notified_lsn = lsn;
+			continue;
+		}
+
+		os_event_wait_time_low(log_sys->flusher_event, 1000000,
+				       sig_count);
+	}
+
+	log_flusher_thread_active = false;
+	log_wake_waiters(0, LSN_MAX);
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start log_writer_thread and log_flusher_thread. */
+void
+log_writer_threads_start()
+{
+	ut_ad(!srv_read_only_mode);
+	ut_ad(!log_writer_thread_active);
+	ut_ad(!log_flusher_thread_active);
+
+	log_sys->writer_event = os_event_create("log_writer_event");
+	log_sys->flusher_event = os_event_create("log_flusher_event");
+
+	for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+		log_sys->wait_events[i] = os_event_create(0);
+	}
+
+	log_writer_thread_active = true;
+	log_flusher_thread_active = true;
+	os_thread_create(log_writer_thread, NULL, NULL);
+	os_thread_create(log_flusher_thread, NULL, NULL);
+}
+
 /** write to the log file up to the last log entry.
 @param[in]	sync	whether we want the written log
 also to be flushed to disk. */
@@ -1893,6 +2169,9 @@ logs_empty_and_mark_files_at_shutdown(void)
 		if (lock_sys.timeout_thread_active) {
 			os_event_set(lock_sys.timeout_event);
 		}
+		if (lock_sys.deadlock_thread_active) {
+			os_event_set(lock_sys.deadlock_event);
+		}
 		if (dict_stats_event) {
 			os_event_set(dict_stats_event);
 		} else {
@@ -1942,11 +2221,16 @@ logs_empty_and_mark_files_at_shutdown(void)
 		thread_name = "dict_stats_thread";
 	} else if (lock_sys.timeout_thread_active) {
 		thread_name = "lock_wait_timeout_thread";
+	} else if (lock_sys.deadlock_thread_active) {
+		thread_name = "lock_deadlock_detect_thread";
 	} else if (srv_buf_dump_thread_active) {
 		thread_name = "buf_dump_thread";
 		goto wait_suspend_loop;
 	} else if (btr_defragment_thread_active) {
 		thread_name = "btr_defragment_thread";
+	} else if (buf_lru_manager_n_active) {
+		buf_lru_manager_wake_all();
+		thread_name = "buf_lru_manager_thread";
 	} else if (srv_fast_shutdown != 2 && trx_rollback_is_active) {
 		thread_name = "rollback of recovered transactions";
 	} else {
@@ -2006,13 +2290,22 @@ logs_empty_and_mark_files_at_shutdown(void)
 		os_event_set(log_scrub_event);
 	}
 
+	if (log_writer_thread_active) {
+		os_event_set(log_sys->writer_event);
+	}
+
+	if (log_flusher_thread_active) {
+		os_event_set(log_sys->flusher_event);
+	}
+
 	if (log_sys) {
 		log_mutex_enter();
 		const ulint	n_write	= log_sys->n_pending_checkpoint_writes;
 		const ulint	n_flush	= log_sys->n_pending_flushes;
 		log_mutex_exit();
 
-		if (log_scrub_thread_active || n_write || n_flush) {
+		if (log_scrub_thread_active || log_writer_thread_active
+		    || log_flusher_thread_active || n_write || n_flush) {
 			if (srv_print_verbose_log && count > 600) {
 				ib::info() << "Pending checkpoint_writes: "
 					<< n_write
@@ -2025,6 +2318,8 @@ logs_empty_and_mark_files_at_shutdown(void)
 	}
 
 	ut_ad(!log_scrub_thread_active);
+	ut_ad(!log_writer_thread_active);
+	ut_ad(!log_flusher_thread_active);
 
 	if (!buf_pool_ptr) {
 		ut_ad(!srv_was_started);
@@ -2265,6 +2560,15 @@ log_shutdown()
 
 	os_event_destroy(log_sys->flush_event);
 
+	if (log_sys->writer_event) {
+		os_event_destroy(log_sys->writer_event);
+		os_event_destroy(log_sys->flusher_event);
+
+		for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+			os_event_destroy(log_sys->wait_events[i]);
+		}
+	}
+
 	rw_lock_free(&log_sys->checkpoint_lock);
 
 	mutex_free(&log_sys->mutex);
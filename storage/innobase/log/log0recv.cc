@@ -122,6 +122,7 @@ static lsn_t	recv_max_page_lsn;
 #ifdef UNIV_PFS_THREAD
 mysql_pfs_key_t	trx_rollback_clean_thread_key;
 mysql_pfs_key_t	recv_writer_thread_key;
+mysql_pfs_key_t	recv_apply_thread_key;
 #endif /* UNIV_PFS_THREAD */
 
 /** Is recv_writer_thread active? */
@@ -1922,50 +1923,22 @@ recv_read_in_area(
 	return(n);
 }
 
-/** Apply the hash table of stored log records to persistent data pages.
-@param[in]	last_batch	whether the change buffer merge will be
-				performed as part of the operation */
+/** Apply the hashed log records to the pages in a subset of the cells
+of recv_sys->addr_hash. The caller must hold recv_sys->mutex.
+@param[in]	first	the first cell to process; every
+			recv_sys->n_apply_threads'th cell after it
+			will be processed as well */
+static
 void
-recv_apply_hashed_log_recs(bool last_batch)
+recv_apply_hashed_log_recs_low(ulint first)
 {
-	ut_ad(srv_operation == SRV_OPERATION_NORMAL
-	      || srv_operation == SRV_OPERATION_RESTORE
-	      || srv_operation == SRV_OPERATION_RESTORE_EXPORT);
-
-	mutex_enter(&recv_sys->mutex);
-
-	while (recv_sys->apply_batch_on) {
-		bool abort = recv_sys->found_corrupt_log;
-		mutex_exit(&recv_sys->mutex);
+	ut_ad(mutex_own(&recv_sys->mutex));
+	ut_ad(recv_sys->apply_batch_on);
+	ut_ad(recv_sys->n_apply_threads_active > 0);
 
-		if (abort) {
-			return;
-		}
-
-		os_thread_sleep(500000);
-		mutex_enter(&recv_sys->mutex);
-	}
-
-	ut_ad(!last_batch == log_mutex_own());
-
-	recv_no_ibuf_operations = !last_batch
-		|| srv_operation == SRV_OPERATION_RESTORE
-		|| srv_operation == SRV_OPERATION_RESTORE_EXPORT;
-
-	ut_d(recv_no_log_write = recv_no_ibuf_operations);
-
-	if (ulint n = recv_sys->n_addrs) {
-		const char* msg = last_batch
-			? "Starting final batch to recover "
-			: "Starting a batch to recover ";
-		ib::info() << msg << n << " pages from redo log.";
-		sd_notifyf(0, "STATUS=%s" ULINTPF " pages from redo log",
-			   msg, n);
-	}
-	recv_sys->apply_log_recs = TRUE;
-	recv_sys->apply_batch_on = TRUE;
-
-	for (ulint i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
+	for (ulint i = first; i < hash_get_n_cells(recv_sys->addr_hash)
+		     && !recv_sys->found_corrupt_log;
+	     i += recv_sys->n_apply_threads) {
 		for (recv_addr_t* recv_addr = static_cast<recv_addr_t*>(
 			     HASH_GET_FIRST(recv_sys->addr_hash, i));
 		     recv_addr;
@@ -2021,9 +1994,99 @@ recv_apply_hashed_log_recs(bool last_batch)
 		}
 	}
 
+	ut_a(recv_sys->n_apply_threads_active > 0);
+	recv_sys->n_apply_threads_active--;
+}
+
+/** Thread that applies the hashed log records to a subset of the pages
+in recv_apply_hashed_log_recs().
+@param[in]	arg	the first hash table cell to process
+@return this function does not return, it calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(void* arg)
+{
+	my_thread_init();
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	mutex_enter(&recv_sys->mutex);
+	recv_apply_hashed_log_recs_low(reinterpret_cast<ulint>(arg));
+	mutex_exit(&recv_sys->mutex);
+
+	my_thread_end();
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Apply the hash table of stored log records to persistent data pages.
+@param[in]	last_batch	whether the change buffer merge will be
+				performed as part of the operation */
+void
+recv_apply_hashed_log_recs(bool last_batch)
+{
+	ut_ad(srv_operation == SRV_OPERATION_NORMAL
+	      || srv_operation == SRV_OPERATION_RESTORE
+	      || srv_operation == SRV_OPERATION_RESTORE_EXPORT);
+
+	mutex_enter(&recv_sys->mutex);
+
+	while (recv_sys->apply_batch_on) {
+		bool abort = recv_sys->found_corrupt_log;
+		mutex_exit(&recv_sys->mutex);
+
+		if (abort) {
+			return;
+		}
+
+		os_thread_sleep(500000);
+		mutex_enter(&recv_sys->mutex);
+	}
+
+	ut_ad(!last_batch == log_mutex_own());
+
+	recv_no_ibuf_operations = !last_batch
+		|| srv_operation == SRV_OPERATION_RESTORE
+		|| srv_operation == SRV_OPERATION_RESTORE_EXPORT;
+
+	ut_d(recv_no_log_write = recv_no_ibuf_operations);
+
+	/* Pages that are not in the buffer pool will be read in and
+	recovered by the I/O handler threads. Pages that are in the
+	buffer pool are recovered by this thread and
+	innodb_recovery_threads - 1 recv_apply_thread. Each thread
+	processes a disjoint subset of the hash table cells. */
+	recv_sys->n_apply_threads = std::min(
+		std::max<ulint>(srv_n_recovery_threads, 1),
+		hash_get_n_cells(recv_sys->addr_hash));
+	recv_sys->n_apply_threads_active = recv_sys->n_apply_threads;
+
+	if (ulint n = recv_sys->n_addrs) {
+		const char* msg = last_batch
+			? "Starting final batch to recover "
+			: "Starting a batch to recover ";
+		ib::info() << msg << n << " pages from redo log using "
+			<< recv_sys->n_apply_threads << " threads.";
+		sd_notifyf(0, "STATUS=%s" ULINTPF " pages from redo log",
+			   msg, n);
+	}
+	recv_sys->apply_log_recs = TRUE;
+	recv_sys->apply_batch_on = TRUE;
+
+	for (ulint i = 1; i < recv_sys->n_apply_threads; i++) {
+		os_thread_create(recv_apply_thread,
+				 reinterpret_cast<void*>(i), NULL);
+	}
+
+	recv_apply_hashed_log_recs_low(0);
+
 	/* Wait until all the pages have been processed */
 
-	while (recv_sys->n_addrs != 0) {
+	while (recv_sys->n_addrs != 0
+	       || recv_sys->n_apply_threads_active != 0) {
 		bool abort = recv_sys->found_corrupt_log;
 
 		mutex_exit(&(recv_sys->mutex));
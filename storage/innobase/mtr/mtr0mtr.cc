@@ -385,7 +385,8 @@ class mtr_t::Command {
 	@param[in,out]	mtr	mini-transaction */
 	explicit Command(mtr_t* mtr)
 		:
-		m_locks_released()
+		m_locks_released(),
+		m_log_ptr()
 	{
 		init(mtr);
 	}
@@ -422,6 +423,10 @@ class mtr_t::Command {
 	@param[in]	len	number of bytes to write */
 	void finish_write(ulint len);
 
+	/** Copy the redo log records to the space that was reserved
+	by finish_write(). This need not hold log_sys->mutex. */
+	void copy_log();
+
 private:
 	/** Prepare to write the mini-transaction log to the redo log buffer.
 	@return number of bytes to write in finish_write() */
@@ -442,6 +447,10 @@ class mtr_t::Command {
 
 	/** End lsn of the possible log entry for this mtr */
 	lsn_t			m_end_lsn;
+
+	/** Space reserved in the redo log buffer by finish_write(),
+	or NULL if there is nothing left to copy */
+	byte*			m_log_ptr;
 };
 
 /** Check if a mini-transaction is dirtying a clean page.
@@ -469,6 +478,26 @@ struct mtr_write_log_t {
 	}
 };
 
+/** Copy the block contents to space reserved in the REDO log buffer */
+struct mtr_copy_log_t {
+	/** Constructor
+	@param[in]	ptr	space reserved by log_reserve_fast()
+				or log_reserve_low() */
+	explicit mtr_copy_log_t(byte* ptr) : m_ptr(ptr) {}
+
+	/** Append a block to the reserved space.
+	@return whether the appending should continue */
+	bool operator()(const mtr_buf_t::block_t* block)
+	{
+		m_ptr = log_write_reserved(
+			m_ptr, block->begin(), block->used());
+		return(true);
+	}
+
+	/** Current position in the reserved space */
+	byte*	m_ptr;
+};
+
 /** Append records to the system-wide redo log buffer.
 @param[in]	log	redo log records */
 void
@@ -619,6 +648,7 @@ mtr_t::commit_checkpoint(
 
 	Command	cmd(this);
 	cmd.finish_write(m_impl.m_log.size());
+	cmd.copy_log();
 	cmd.release_resources();
 
 	if (write_mlog_checkpoint) {
@@ -854,23 +884,38 @@ mtr_t::Command::finish_write(
 		const mtr_buf_t::block_t*	front = m_impl->m_log.front();
 		ut_ad(len <= front->used());
 
-		m_end_lsn = log_reserve_and_write_fast(
-			front->begin(), len, &m_start_lsn);
+		m_end_lsn = log_reserve_fast(
+			front->begin(), len, &m_start_lsn, &m_log_ptr);
 
 		if (m_end_lsn > 0) {
 			return;
 		}
 	}
 
-	/* Open the database log for log_write_low */
+	/* Open the database log for log_reserve_low */
 	m_start_lsn = log_reserve_and_open(len);
 
-	mtr_write_log_t	write_log;
-	m_impl->m_log.for_each_block(write_log);
+	m_log_ptr = log_reserve_low(len);
 
 	m_end_lsn = log_close();
 }
 
+/** Copy the redo log records to the space that was reserved
+by finish_write(). This need not hold log_sys->mutex. */
+void
+mtr_t::Command::copy_log()
+{
+	if (m_log_ptr == NULL) {
+		return;
+	}
+
+	mtr_copy_log_t	copy_log(m_log_ptr);
+	m_impl->m_log.for_each_block(copy_log);
+	m_log_ptr = NULL;
+
+	log_write_reserved_complete();
+}
+
 /** Release the latches and blocks acquired by this mini-transaction */
 void
 mtr_t::Command::release_all()
@@ -935,6 +980,12 @@ mtr_t::Command::execute()
 		log_flush_order_mutex_exit();
 	}
 
+	/* The space for the log records was reserved while holding
+	log_sys->mutex. Copy the records while other threads are
+	reserving space for theirs. log_write_up_to() will wait for
+	the copying to complete. */
+	copy_log();
+
 	release_latches();
 
 	release_resources();
@@ -64,6 +64,21 @@ Created 10/21/1995 Heikki Tuuri
 #include <libaio.h>
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef HAVE_URING
+#include <algorithm>
+#include <limits.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#ifndef IORING_FEAT_RSRC_TAGS
+/** Linux 5.13 introduced this feature together with the registration
+of buffers that does not have to quiesce the io_uring instance */
+# define IORING_FEAT_RSRC_TAGS	(1U << 10)
+#endif
+#endif /* HAVE_URING */
+
 #ifdef HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE
 # include <fcntl.h>
 # include <linux/falloc.h>
@@ -276,11 +291,74 @@ struct Slot {
 	ulint			n_bytes;
 #endif /* WIN_ASYNC_IO */
 
+#ifdef HAVE_URING
+	/** io_uring: the buffer of a request that is not submitted
+	with IORING_OP_READ_FIXED or IORING_OP_WRITE_FIXED */
+	struct iovec		iov;
+
+	/** io_uring: 0 on success, or the negated errno of the request */
+	int			uring_ret;
+#endif /* HAVE_URING */
+
 	/** Length of the block before it was compressed */
 	uint32			original_len;
 
 };
 
+#ifdef HAVE_URING
+/** An io_uring instance. There is one such instance for each segment
+of an AIO array. The submission queue is filled by the threads that
+dispatch requests, while holding AIO::m_mutex. The completion queue
+is emptied only by the I/O handler thread of the segment. */
+struct os_uring_t {
+	/** the io_uring file descriptor, or -1 */
+	int			fd;
+	/** IORING_FEAT_ flags reported by io_uring_setup() */
+	unsigned		features;
+
+	/** the mapped submission queue ring */
+	void*			sq_ring;
+	/** size of sq_ring in bytes */
+	size_t			sq_ring_size;
+	/** the mapped completion queue ring */
+	void*			cq_ring;
+	/** size of cq_ring in bytes */
+	size_t			cq_ring_size;
+
+	/** submission queue head, advanced by the kernel */
+	unsigned*		sq_head;
+	/** submission queue tail, advanced by us */
+	unsigned*		sq_tail;
+	/** mask for indexing sq_array and sqes */
+	unsigned		sq_mask;
+	/** number of submission queue entries */
+	unsigned		sq_entries;
+	/** indexes of the submission queue entries */
+	unsigned*		sq_array;
+	/** the submission queue entries */
+	struct io_uring_sqe*	sqes;
+
+	/** completion queue head, advanced by us */
+	unsigned*		cq_head;
+	/** completion queue tail, advanced by the kernel */
+	unsigned*		cq_tail;
+	/** mask for indexing cqes */
+	unsigned		cq_mask;
+	/** the completion queue entries */
+	struct io_uring_cqe*	cqes;
+
+	/** number of entries that were added to the submission queue
+	but not yet passed to io_uring_enter(); protected by AIO::m_mutex */
+	unsigned		n_unsubmitted;
+
+	/** the registered buffers, ordered by address; protected by
+	AIO::m_mutex */
+	struct iovec*		bufs;
+	/** number of elements in bufs */
+	unsigned		n_bufs;
+};
+#endif /* HAVE_URING */
+
 /** The asynchronous i/o array structure */
 class AIO {
 public:
@@ -442,6 +520,59 @@ class AIO {
 		MY_ATTRIBUTE((warn_unused_result));
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef HAVE_URING
+	/** Add a request to the io_uring submission queue of the segment
+	that the slot belongs to. The caller must own the mutex.
+	@param[in,out]	slot	an already reserved slot */
+	void uring_queue(Slot* slot);
+
+	/** Dispatch an AIO request to the kernel via io_uring.
+	@param[in,out]	slot	an already reserved slot
+	@param[in]	submit	whether to pass the queued requests to the
+				kernel now; if false, the request will be
+				submitted by os_aio_simulated_wake_handler_threads()
+				or by the I/O handler thread of the segment */
+	void uring_dispatch(Slot* slot, bool submit);
+
+	/** Pass the queued requests of a segment to the kernel, and
+	optionally wait for a completion.
+	@param[in]	segment		local segment
+	@param[in]	wait		whether to wait for a completion
+	@return nonnegative on success, or -1 and errno */
+	int uring_submit(ulint segment, bool wait);
+
+	/** Accessor for the io_uring instance
+	@param[in]	segment	Segment for which to get the instance
+	@return the io_uring instance of the segment */
+	os_uring_t* uring(ulint segment)
+		MY_ATTRIBUTE((warn_unused_result))
+	{
+		ut_ad(segment < get_n_segments());
+
+		return(&m_uring[segment]);
+	}
+
+	/** Check if io_uring can be used, by creating as many io_uring
+	instances as os_aio_init() would need.
+	@param[in]	n_rings		number of instances
+	@param[in]	n_entries	number of entries per instance
+	@return true if supported, false otherwise. */
+	static bool is_uring_supported(ulint n_rings, ulint n_entries)
+		MY_ATTRIBUTE((warn_unused_result));
+
+	/** Submit the queued requests of all io_uring instances. */
+	static void uring_submit_all();
+
+	/** Wake up the I/O handler threads that wait for completions. */
+	static void uring_wake_at_shutdown();
+
+	/** Register memory areas as fixed buffers with the io_uring
+	instances of the arrays that read and write buffer pool pages.
+	@param[in]	iov	memory areas
+	@param[in]	n	number of memory areas, or 0 to unregister */
+	static void uring_register_buffers(const struct iovec* iov, ulint n);
+#endif /* HAVE_URING */
+
 #ifdef WIN_ASYNC_IO
 	
 	/** Wake up all AIO threads in Windows native aio */
@@ -587,6 +718,18 @@ class AIO {
 		MY_ATTRIBUTE((warn_unused_result));
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef HAVE_URING
+	/** Create the io_uring instances of the segments
+	@return DB_SUCCESS or error code */
+	dberr_t init_uring()
+		MY_ATTRIBUTE((warn_unused_result));
+
+	/** Replace the fixed buffers of the io_uring instances.
+	@param[in]	bufs	memory areas ordered by address
+	@return true on success */
+	bool uring_register(const std::vector<iovec>& bufs);
+#endif /* HAVE_URING */
+
 private:
 	typedef std::vector<Slot> Slots;
 
@@ -629,6 +772,12 @@ class AIO {
 	IOEvents		m_events;
 #endif /* LINUX_NATIV_AIO */
 
+#ifdef HAVE_URING
+	/** io_uring instances, one for each segment. Each I/O handler
+	thread reaps the completions of one instance exclusively. */
+	os_uring_t*		m_uring;
+#endif /* HAVE_URING */
+
 	/** The aio arrays for non-ibuf i/o and ibuf i/o, as well as
 	sync AIO. These are NULL when the module has not yet been
 	initialized. */
@@ -1223,6 +1372,13 @@ AIO::release(Slot* slot)
 	}
 
 #endif /* WIN_ASYNC_IO */
+
+#ifdef HAVE_URING
+	if (srv_use_io_uring) {
+		slot->uring_ret = 0;
+		slot->n_bytes = 0;
+	}
+#endif /* HAVE_URING */
 }
 
 /** Frees a slot in the AIO array. Assumes caller doesn't own the mutex.
@@ -2135,219 +2291,1112 @@ AIO::linux_dispatch(Slot* slot)
 	/* io_submit() returns number of successfully queued requests
 	or -errno. */
 
-	if (ret != 1) {
-		errno = -ret;
+	if (ret != 1) {
+		errno = -ret;
+	}
+
+	return(ret == 1);
+}
+
+/** Creates an io_context for native linux AIO.
+@param[in]	max_events	number of events
+@param[out]	io_ctx		io_ctx to initialize.
+@return true on success. */
+bool
+AIO::linux_create_io_ctx(
+	unsigned	max_events,
+	io_context_t*	io_ctx)
+{
+	ssize_t		n_retries = 0;
+
+	for (;;) {
+
+		memset(io_ctx, 0x0, sizeof(*io_ctx));
+
+		/* Initialize the io_ctx. Tell it how many pending
+		IO requests this context will handle. */
+
+		int	ret = io_setup(max_events, io_ctx);
+
+		if (ret == 0) {
+			/* Success. Return now. */
+			return(true);
+		}
+
+		/* If we hit EAGAIN we'll make a few attempts before failing. */
+
+		switch (ret) {
+		case -EAGAIN:
+			if (n_retries == 0) {
+				/* First time around. */
+				ib::warn()
+					<< "io_setup() failed with EAGAIN."
+					" Will make "
+					<< OS_AIO_IO_SETUP_RETRY_ATTEMPTS
+					<< " attempts before giving up.";
+			}
+
+			if (n_retries < OS_AIO_IO_SETUP_RETRY_ATTEMPTS) {
+
+				++n_retries;
+
+				ib::warn()
+					<< "io_setup() attempt "
+					<< n_retries << ".";
+
+				os_thread_sleep(OS_AIO_IO_SETUP_RETRY_SLEEP);
+
+				continue;
+			}
+
+			/* Have tried enough. Better call it a day. */
+			ib::error()
+				<< "io_setup() failed with EAGAIN after "
+				<< OS_AIO_IO_SETUP_RETRY_ATTEMPTS
+				<< " attempts.";
+			break;
+
+		case -ENOSYS:
+			ib::error()
+				<< "Linux Native AIO interface"
+				" is not supported on this platform. Please"
+				" check your OS documentation and install"
+				" appropriate binary of InnoDB.";
+
+			break;
+
+		default:
+			ib::error()
+				<< "Linux Native AIO setup"
+				<< " returned following error["
+				<< ret << "]";
+			break;
+		}
+
+		ib::info()
+			<< "You can disable Linux Native AIO by"
+			" setting innodb_use_native_aio = 0 in my.cnf";
+
+		break;
+	}
+
+	return(false);
+}
+
+/** Checks if the system supports native linux aio. On some kernel
+versions where native aio is supported it won't work on tmpfs. In such
+cases we can't use native aio as it is not possible to mix simulated
+and native aio.
+@return: true if supported, false otherwise. */
+bool
+AIO::is_linux_native_aio_supported()
+{
+	int		fd;
+	io_context_t	io_ctx;
+	char		name[1000];
+
+	if (!linux_create_io_ctx(1, &io_ctx)) {
+
+		/* The platform does not support native aio. */
+
+		return(false);
+
+	} else if (!srv_read_only_mode) {
+
+		/* Now check if tmpdir supports native aio ops. */
+		fd = innobase_mysql_tmpfile(NULL);
+
+		if (fd < 0) {
+			ib::warn()
+				<< "Unable to create temp file to check"
+				" native AIO support.";
+
+			return(false);
+		}
+	} else {
+
+		os_normalize_path(srv_log_group_home_dir);
+
+		ulint	dirnamelen = strlen(srv_log_group_home_dir);
+
+		ut_a(dirnamelen < (sizeof name) - 10 - sizeof "ib_logfile");
+
+		memcpy(name, srv_log_group_home_dir, dirnamelen);
+
+		/* Add a path separator if needed. */
+		if (dirnamelen && name[dirnamelen - 1] != OS_PATH_SEPARATOR) {
+
+			name[dirnamelen++] = OS_PATH_SEPARATOR;
+		}
+
+		strcpy(name + dirnamelen, "ib_logfile0");
+
+		fd = open(name, O_RDONLY | O_CLOEXEC);
+
+		if (fd == -1) {
+
+			ib::warn()
+				<< "Unable to open"
+				<< " \"" << name << "\" to check native"
+				<< " AIO read support.";
+
+			return(false);
+		}
+	}
+
+	struct io_event	io_event;
+
+	memset(&io_event, 0x0, sizeof(io_event));
+
+	byte*	buf = static_cast<byte*>(ut_malloc_nokey(UNIV_PAGE_SIZE * 2));
+	byte*	ptr = static_cast<byte*>(ut_align(buf, UNIV_PAGE_SIZE));
+
+	struct iocb	iocb;
+
+	/* Suppress valgrind warning. */
+	memset(buf, 0x00, UNIV_PAGE_SIZE * 2);
+	memset(&iocb, 0x0, sizeof(iocb));
+
+	struct iocb*	p_iocb = &iocb;
+
+	if (!srv_read_only_mode) {
+
+		io_prep_pwrite(p_iocb, fd, ptr, UNIV_PAGE_SIZE, 0);
+
+	} else {
+		ut_a(UNIV_PAGE_SIZE >= 512);
+		io_prep_pread(p_iocb, fd, ptr, 512, 0);
+	}
+
+	int	err = io_submit(io_ctx, 1, &p_iocb);
+
+	if (err >= 1) {
+		/* Now collect the submitted IO request. */
+		err = io_getevents(io_ctx, 1, 1, &io_event, NULL);
+	}
+
+	ut_free(buf);
+	close(fd);
+
+	switch (err) {
+	case 1:
+		return(true);
+
+	case -EINVAL:
+	case -ENOSYS:
+		ib::error()
+			<< "Linux Native AIO not supported. You can either"
+			" move "
+			<< (srv_read_only_mode ? name : "tmpdir")
+			<< " to a file system that supports native"
+			" AIO or you can set innodb_use_native_aio to"
+			" FALSE to avoid this message.";
+
+		/* fall through. */
+	default:
+		ib::error()
+			<< "Linux Native AIO check on "
+			<< (srv_read_only_mode ? name : "tmpdir")
+			<< "returned error[" << -err << "]";
+	}
+
+	return(false);
+}
+
+#endif /* LINUX_NATIVE_AIO */
+
+#ifdef HAVE_URING
+/** Wrapper for the io_uring_setup() system call.
+@param[in]	entries	number of submission queue entries
+@param[in,out]	p	parameters
+@return file descriptor, or -1 and errno */
+static
+int
+os_uring_setup(unsigned entries, struct io_uring_params* p)
+{
+	return(static_cast<int>(syscall(__NR_io_uring_setup, entries, p)));
+}
+
+/** Wrapper for the io_uring_enter() system call.
+@param[in]	fd		io_uring file descriptor
+@param[in]	to_submit	number of submission queue entries to submit
+@param[in]	min_complete	number of completions to wait for
+@param[in]	flags		IORING_ENTER_GETEVENTS or 0
+@return number of submitted entries, or -1 and errno */
+static
+int
+os_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+	return(static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+					min_complete, flags, NULL, 0)));
+}
+
+/** Wrapper for the io_uring_register() system call.
+@param[in]	fd	io_uring file descriptor
+@param[in]	opcode	IORING_REGISTER_BUFFERS or IORING_UNREGISTER_BUFFERS
+@param[in]	arg	argument of the operation
+@param[in]	n	number of elements in arg
+@return 0, or -1 and errno */
+static
+int
+os_uring_register(int fd, unsigned opcode, const void* arg, unsigned n)
+{
+	return(static_cast<int>(syscall(__NR_io_uring_register, fd, opcode,
+					arg, n)));
+}
+
+/** Read a ring index that is written by the kernel.
+@param[in]	p	head or tail of a ring
+@return the index */
+static inline
+unsigned
+os_uring_load(unsigned* p)
+{
+	return(static_cast<unsigned>(my_atomic_load32_explicit(
+		reinterpret_cast<int32*>(p), MY_MEMORY_ORDER_ACQUIRE)));
+}
+
+/** Publish a ring index to the kernel.
+@param[out]	p	head or tail of a ring
+@param[in]	i	the index */
+static inline
+void
+os_uring_store(unsigned* p, unsigned i)
+{
+	my_atomic_store32_explicit(reinterpret_cast<int32*>(p),
+				   static_cast<int32>(i),
+				   MY_MEMORY_ORDER_RELEASE);
+}
+
+/** Close an io_uring instance. This also releases the registered
+buffers of the instance.
+@param[in,out]	ring	the io_uring instance */
+static
+void
+os_uring_close(os_uring_t* ring)
+{
+	if (ring->sqes != NULL) {
+		munmap(ring->sqes, ring->sq_entries * sizeof *ring->sqes);
+	}
+
+	if (ring->cq_ring != NULL) {
+		munmap(ring->cq_ring, ring->cq_ring_size);
+	}
+
+	if (ring->sq_ring != NULL) {
+		munmap(ring->sq_ring, ring->sq_ring_size);
+	}
+
+	if (ring->fd != -1) {
+		close(ring->fd);
+	}
+
+	ut_free(ring->bufs);
+
+	memset(ring, 0x0, sizeof *ring);
+	ring->fd = -1;
+}
+
+/** Create an io_uring instance.
+@param[in]	entries	minimum number of submission queue entries
+@param[out]	ring	the io_uring instance
+@return 0 on success, or errno */
+static
+int
+os_uring_create(unsigned entries, os_uring_t* ring)
+{
+	struct io_uring_params	p;
+
+	memset(&p, 0x0, sizeof p);
+	memset(ring, 0x0, sizeof *ring);
+
+	ring->fd = os_uring_setup(entries, &p);
+
+	if (ring->fd == -1) {
+		return(errno);
+	}
+
+	ring->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	ring->cq_ring_size = p.cq_off.cqes
+		+ p.cq_entries * sizeof(struct io_uring_cqe);
+
+	void*	sq_ring = mmap(NULL, ring->sq_ring_size,
+			       PROT_READ | PROT_WRITE,
+			       MAP_SHARED | MAP_POPULATE,
+			       ring->fd, IORING_OFF_SQ_RING);
+	void*	cq_ring = sq_ring == MAP_FAILED
+		? MAP_FAILED
+		: mmap(NULL, ring->cq_ring_size,
+		       PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		       ring->fd, IORING_OFF_CQ_RING);
+	void*	sqes = cq_ring == MAP_FAILED
+		? MAP_FAILED
+		: mmap(NULL, p.sq_entries * sizeof(struct io_uring_sqe),
+		       PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		       ring->fd, IORING_OFF_SQES);
+
+	if (sqes == MAP_FAILED) {
+		int	err = errno;
+
+		ring->sq_ring = sq_ring == MAP_FAILED ? NULL : sq_ring;
+		ring->cq_ring = cq_ring == MAP_FAILED ? NULL : cq_ring;
+		os_uring_close(ring);
+
+		return(err);
+	}
+
+	byte*	sq = static_cast<byte*>(sq_ring);
+	byte*	cq = static_cast<byte*>(cq_ring);
+
+	ring->features = p.features;
+	ring->sq_ring = sq_ring;
+	ring->cq_ring = cq_ring;
+	ring->sq_head = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+	ring->sq_tail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+	ring->sq_mask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+	ring->sq_entries = p.sq_entries;
+	ring->sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+	ring->sqes = static_cast<struct io_uring_sqe*>(sqes);
+	ring->cq_head = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+	ring->cq_tail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+	ring->cq_mask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+	ring->cqes = reinterpret_cast<struct io_uring_cqe*>(
+		cq + p.cq_off.cqes);
+
+	return(0);
+}
+
+/** Compare a buffer address with a registered buffer.
+@param[in]	ptr	buffer address
+@param[in]	buf	registered buffer
+@return whether ptr precedes buf */
+static
+bool
+os_uring_buf_less(const void* ptr, const struct iovec& buf)
+{
+	return(ptr < buf.iov_base);
+}
+
+/** Look up the registered buffer that contains an I/O buffer.
+@param[in]	ring	io_uring instance
+@param[in]	ptr	start of the I/O buffer
+@param[in]	len	length of the I/O buffer
+@return index of the registered buffer, or -1 if there is none */
+static
+int
+os_uring_find_buf(const os_uring_t* ring, const byte* ptr, ulint len)
+{
+	const struct iovec*	bufs = ring->bufs;
+	const struct iovec*	buf = std::upper_bound(
+		bufs, bufs + ring->n_bufs, static_cast<const void*>(ptr),
+		os_uring_buf_less);
+
+	if (buf == bufs) {
+		return(-1);
+	}
+
+	--buf;
+
+	if (ptr + len > static_cast<const byte*>(buf->iov_base)
+	    + buf->iov_len) {
+		return(-1);
+	}
+
+	return(static_cast<int>(buf - bufs));
+}
+
+/** io_uring handler */
+class UringAIOHandler {
+public:
+	/**
+	@param[in]	global_segment	The global segment*/
+	UringAIOHandler(ulint global_segment)
+		:
+		m_global_segment(global_segment)
+	{
+		/* Should never be doing Sync IO here. */
+		ut_a(m_global_segment != ULINT_UNDEFINED);
+
+		/* Find the array and the local segment. */
+
+		m_segment = AIO::get_array_and_local_segment(
+			&m_array, m_global_segment);
+
+		m_n_slots = m_array->slots_per_segment();
+	}
+
+	/**
+	Process an io_uring request
+	@param[out]	m1		the messages passed with the
+	@param[out]	m2		AIO request; note that in case the
+					AIO operation failed, these output
+					parameters are valid and can be used to
+					restart the operation.
+	@param[out]	request		IO context
+	@return DB_SUCCESS or error code */
+	dberr_t poll(fil_node_t** m1, void** m2, IORequest* request);
+
+private:
+	/** Queue the remaining part of a partially completed request.
+	@param[in,out]	slot		Request to resubmit */
+	void resubmit(Slot* slot);
+
+	/** Check if the request succeeded
+	@param[in,out]	slot		The slot to check
+	@return DB_SUCCESS, DB_FAIL if the operation should be retried or
+		DB_IO_ERROR on all other errors */
+	dberr_t check_state(Slot* slot);
+
+	/** @return true if a shutdown was detected */
+	bool is_shutdown() const
+	{
+		return(srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS
+		       && !buf_page_cleaner_is_active);
+	}
+
+	/** If no slot was found then the m_array->m_mutex will be released.
+	@param[out]	n_pending	The number of pending IOs
+	@return NULL or a slot that has completed IO */
+	Slot* find_completed_slot(ulint* n_pending);
+
+	/** Submit the queued requests of the segment and reap at least
+	one completion. Unlike io_getevents(), the wait has no timeout:
+	at shutdown, AIO::uring_wake_at_shutdown() submits a no-op
+	request to wake up the thread. */
+	void collect();
+
+private:
+	/** Slot array */
+	AIO*			m_array;
+
+	/** Number of slots in the local segment */
+	ulint			m_n_slots;
+
+	/** The local segment to check */
+	ulint			m_segment;
+
+	/** The global segment */
+	ulint			m_global_segment;
+};
+
+/** Queue the remaining part of a partially completed request.
+The I/O handler thread will submit it before waiting in collect().
+@param[in,out]	slot		Request to resubmit */
+void
+UringAIOHandler::resubmit(Slot* slot)
+{
+	ut_ad(m_array->is_mutex_owned());
+	ut_ad(slot->len > slot->n_bytes);
+
+	slot->len -= slot->n_bytes;
+	slot->ptr += slot->n_bytes;
+	slot->offset += slot->n_bytes;
+
+	/* Resetting the bytes read/written */
+	slot->n_bytes = 0;
+	slot->uring_ret = 0;
+	slot->io_already_done = false;
+
+	m_array->uring_queue(slot);
+}
+
+/** Check if the request succeeded
+@param[in,out]	slot		The slot to check
+@return DB_SUCCESS, DB_FAIL if the operation should be retried or
+	DB_IO_ERROR on all other errors */
+dberr_t
+UringAIOHandler::check_state(Slot* slot)
+{
+	ut_ad(m_array->is_mutex_owned());
+
+	srv_set_io_thread_op_info(
+		m_global_segment, "processing completed aio requests");
+
+	ut_ad(slot->io_already_done);
+
+	if (slot->uring_ret == 0) {
+		return(AIOHandler::post_io_processing(slot));
+	}
+
+	errno = -slot->uring_ret;
+
+	os_file_handle_error(slot->name, "io_uring");
+
+	return(DB_IO_ERROR);
+}
+
+/** If no slot was found then the m_array->m_mutex will be released.
+@param[out]	n_pending		The number of pending IOs
+@return NULL or a slot that has completed IO */
+Slot*
+UringAIOHandler::find_completed_slot(ulint* n_pending)
+{
+	ulint	offset = m_n_slots * m_segment;
+
+	*n_pending = 0;
+
+	m_array->acquire();
+
+	Slot*	slot = m_array->at(offset);
+
+	for (ulint i = 0; i < m_n_slots; ++i, ++slot) {
+
+		if (slot->is_reserved) {
+
+			++*n_pending;
+
+			if (slot->io_already_done) {
+
+				/* Something for us to work on.
+				Note: We don't release the mutex. */
+				return(slot);
+			}
+		}
+	}
+
+	m_array->release();
+
+	return(NULL);
+}
+
+/** Submit the queued requests of the segment and reap at least one
+completion. */
+void
+UringAIOHandler::collect()
+{
+	os_uring_t*	ring = m_array->uring(m_segment);
+
+	/* Starting point of the m_segment we will be working on. */
+	ulint	start_pos = m_segment * m_n_slots;
+
+	/* End point. */
+	ulint	end_pos = start_pos + m_n_slots;
+
+	unsigned	head = *ring->cq_head;
+	unsigned	tail;
+
+	while ((tail = os_uring_load(ring->cq_tail)) == head) {
+
+		if (m_array->uring_submit(m_segment, true) >= 0) {
+			continue;
+		}
+
+		switch (errno) {
+		case EAGAIN:
+		case EBUSY:
+		case EINTR:
+			continue;
+		}
+
+		ib::fatal()
+			<< "io_uring_enter() failed with error "
+			<< errno;
+	}
+
+	do {
+		const struct io_uring_cqe*	cqe
+			= &ring->cqes[head & ring->cq_mask];
+
+		Slot*	slot = reinterpret_cast<Slot*>(cqe->user_data);
+		int	res = cqe->res;
+
+		++head;
+
+		if (slot == NULL) {
+			/* A wakeup from uring_wake_at_shutdown() */
+			continue;
+		}
+
+		/* Some sanity checks. */
+		ut_a(slot->is_reserved);
+		ut_a(slot->pos >= start_pos);
+		ut_a(slot->pos < end_pos);
+
+		/* Deallocate unused blocks from file system.
+		This is newer done to page 0 or to log files.*/
+		if (slot->offset > 0
+		    && !slot->type.is_log()
+		    && slot->type.is_write()
+		    && slot->type.punch_hole()) {
+
+			slot->err = slot->type.punch_hole(
+				slot->file,
+				slot->offset, slot->len);
+		} else {
+			slot->err = DB_SUCCESS;
+		}
+
+		/* Mark this request as completed. The error handling
+		will be done in the calling function. */
+		m_array->acquire();
+
+		slot->uring_ret = res < 0 ? res : 0;
+		slot->n_bytes = res < 0 ? 0 : ulint(res);
+		slot->io_already_done = true;
+
+		m_array->release();
+	} while (head != tail);
+
+	os_uring_store(ring->cq_head, head);
+}
+
+/** Process an io_uring request
+@param[out]	m1		the messages passed with the
+@param[out]	m2		AIO request; note that in case the
+				AIO operation failed, these output
+				parameters are valid and can be used to
+				restart the operation.
+@param[out]	request		IO context
+@return DB_SUCCESS or error code */
+dberr_t
+UringAIOHandler::poll(fil_node_t** m1, void** m2, IORequest* request)
+{
+	dberr_t		err = DB_SUCCESS;
+	Slot*		slot;
+
+	/* Loop until we have found a completed request. */
+	for (;;) {
+
+		ulint	n_pending;
+
+		slot = find_completed_slot(&n_pending);
+
+		if (slot != NULL) {
+
+			ut_ad(m_array->is_mutex_owned());
+
+			err = check_state(slot);
+
+			/* DB_FAIL is not a hard error, we should retry */
+			if (err != DB_FAIL) {
+				break;
+			}
+
+			/* Partial IO, queue a request for the
+			remaining bytes to read/write */
+			resubmit(slot);
+
+			m_array->release();
+
+		} else if (is_shutdown() && n_pending == 0) {
+
+			/* There is no completed request. If there is
+			no pending request at all, and the system is
+			being shut down, exit. */
+
+			*m1 = NULL;
+			*m2 = NULL;
+
+			return(DB_SUCCESS);
+
+		} else {
+
+			/* Wait for some request. Note that we return
+			from wait if we have found a request. */
+
+			srv_set_io_thread_op_info(
+				m_global_segment,
+				"waiting for completed aio requests");
+
+			collect();
+		}
+	}
+
+	*m1 = slot->m1;
+	*m2 = slot->m2;
+
+	*request = slot->type;
+
+	m_array->release(slot);
+
+	m_array->release();
+
+	return(err);
+}
+
+/** Add a request to the io_uring submission queue of the segment that
+the slot belongs to. The caller must own the mutex.
+@param[in,out]	slot		an already reserved slot */
+void
+AIO::uring_queue(Slot* slot)
+{
+	ut_ad(is_mutex_owned());
+	ut_a(slot->is_reserved);
+	ut_ad(slot->type.validate());
+
+	os_uring_t*	ring = uring(slot->pos / slots_per_segment());
+
+	/* Only threads that hold m_mutex advance the tail. Each
+	segment has fewer slots than the submission queue has
+	entries, so the queue cannot be full. */
+	unsigned	tail = *ring->sq_tail;
+
+	ut_a(tail - os_uring_load(ring->sq_head) < ring->sq_entries);
+
+	unsigned		index = tail & ring->sq_mask;
+	struct io_uring_sqe*	sqe = &ring->sqes[index];
+	int			buf = os_uring_find_buf(
+		ring, slot->ptr, slot->len);
+
+	memset(sqe, 0x0, sizeof *sqe);
+
+	sqe->fd = slot->file;
+	sqe->off = slot->offset;
+	sqe->user_data = reinterpret_cast<uintptr_t>(slot);
+
+	if (buf >= 0) {
+		/* The buffer pool frame is pinned already. */
+		sqe->opcode = slot->type.is_read()
+			? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+		sqe->addr = reinterpret_cast<uintptr_t>(slot->ptr);
+		sqe->len = static_cast<__u32>(slot->len);
+		sqe->buf_index = static_cast<__u16>(buf);
+	} else {
+		slot->iov.iov_base = slot->ptr;
+		slot->iov.iov_len = slot->len;
+
+		sqe->opcode = slot->type.is_read()
+			? IORING_OP_READV : IORING_OP_WRITEV;
+		sqe->addr = reinterpret_cast<uintptr_t>(&slot->iov);
+		sqe->len = 1;
+	}
+
+	ring->sq_array[index] = index;
+
+	os_uring_store(ring->sq_tail, tail + 1);
+
+	++ring->n_unsubmitted;
+}
+
+/** Dispatch an AIO request to the kernel via io_uring.
+@param[in,out]	slot		an already reserved slot
+@param[in]	submit		whether to pass the queued requests
+				of the segment to the kernel now */
+void
+AIO::uring_dispatch(Slot* slot, bool submit)
+{
+	acquire();
+
+	uring_queue(slot);
+
+	release();
+
+	if (submit) {
+		/* Failures are transient (EAGAIN, EBUSY, EINTR).
+		The requests remain queued, and the I/O handler thread
+		will submit them. */
+		uring_submit(slot->pos / slots_per_segment(), false);
 	}
-
-	return(ret == 1);
 }
 
-/** Creates an io_context for native linux AIO.
-@param[in]	max_events	number of events
-@param[out]	io_ctx		io_ctx to initialize.
-@return true on success. */
-bool
-AIO::linux_create_io_ctx(
-	unsigned	max_events,
-	io_context_t*	io_ctx)
+/** Pass the queued requests of a segment to the kernel, and optionally
+wait for a completion.
+@param[in]	segment		local segment
+@param[in]	wait		whether to wait for a completion
+@return nonnegative on success, or -1 and errno */
+int
+AIO::uring_submit(ulint segment, bool wait)
 {
-	ssize_t		n_retries = 0;
+	os_uring_t*	ring = uring(segment);
+	int		ret = 0;
 
-	for (;;) {
+	/* Submit while holding m_mutex, so that uring_register() cannot
+	replace the fixed buffers that the queued requests refer to by
+	index. Submitting does not block. */
+	acquire();
 
-		memset(io_ctx, 0x0, sizeof(*io_ctx));
+	if (unsigned n = ring->n_unsubmitted) {
+		ret = os_uring_enter(ring->fd, n, 0, 0);
 
-		/* Initialize the io_ctx. Tell it how many pending
-		IO requests this context will handle. */
+		/* The kernel consumes the submission queue in order.
+		Leave the rest for the next io_uring_enter(). */
+		if (ret > 0) {
+			ut_ad(unsigned(ret) <= n);
+			ring->n_unsubmitted -= unsigned(ret);
+		}
+	}
 
-		int	ret = io_setup(max_events, io_ctx);
+	release();
 
-		if (ret == 0) {
-			/* Success. Return now. */
-			return(true);
-		}
+	if (wait && ret >= 0) {
+		ret = os_uring_enter(ring->fd, 0, 1, IORING_ENTER_GETEVENTS);
+	}
 
-		/* If we hit EAGAIN we'll make a few attempts before failing. */
+	return(ret);
+}
 
-		switch (ret) {
-		case -EAGAIN:
-			if (n_retries == 0) {
-				/* First time around. */
-				ib::warn()
-					<< "io_setup() failed with EAGAIN."
-					" Will make "
-					<< OS_AIO_IO_SETUP_RETRY_ATTEMPTS
-					<< " attempts before giving up.";
-			}
+/** Create the io_uring instances of the segments
+@return DB_SUCCESS or error code */
+dberr_t
+AIO::init_uring()
+{
+	ut_a(m_uring == NULL);
 
-			if (n_retries < OS_AIO_IO_SETUP_RETRY_ATTEMPTS) {
+	m_uring = static_cast<os_uring_t*>(
+		ut_zalloc_nokey(m_n_segments * sizeof *m_uring));
 
-				++n_retries;
+	if (m_uring == NULL) {
+		return(DB_OUT_OF_MEMORY);
+	}
 
-				ib::warn()
-					<< "io_setup() attempt "
-					<< n_retries << ".";
+	/* Leave room for the no-op requests of
+	uring_wake_at_shutdown(). */
+	unsigned	entries = unsigned(slots_per_segment()) + 1;
 
-				os_thread_sleep(OS_AIO_IO_SETUP_RETRY_SLEEP);
+	for (ulint i = 0; i < m_n_segments; ++i) {
+		m_uring[i].fd = -1;
+	}
 
-				continue;
-			}
+	for (ulint i = 0; i < m_n_segments; ++i) {
+		int	err = os_uring_create(entries, &m_uring[i]);
 
-			/* Have tried enough. Better call it a day. */
-			ib::error()
-				<< "io_setup() failed with EAGAIN after "
-				<< OS_AIO_IO_SETUP_RETRY_ATTEMPTS
-				<< " attempts.";
-			break;
+		if (err != 0) {
+			ib::error() << "io_uring_setup() failed with error "
+				    << err;
+			return(DB_ERROR);
+		}
+	}
 
-		case -ENOSYS:
-			ib::error()
-				<< "Linux Native AIO interface"
-				" is not supported on this platform. Please"
-				" check your OS documentation and install"
-				" appropriate binary of InnoDB.";
+	return(DB_SUCCESS);
+}
 
-			break;
+/** Check if io_uring can be used, by creating as many io_uring
+instances as os_aio_init() would need.
+@param[in]	n_rings		number of instances
+@param[in]	n_entries	number of entries per instance
+@return true if supported, false otherwise. */
+bool
+AIO::is_uring_supported(ulint n_rings, ulint n_entries)
+{
+	std::vector<os_uring_t>	rings(n_rings);
+	ulint			n = 0;
+	int			err = 0;
 
-		default:
-			ib::error()
-				<< "Linux Native AIO setup"
-				<< " returned following error["
-				<< ret << "]";
+	while (n < n_rings) {
+		err = os_uring_create(unsigned(n_entries) + 1, &rings[n]);
+
+		if (err != 0) {
 			break;
 		}
 
-		ib::info()
-			<< "You can disable Linux Native AIO by"
-			" setting innodb_use_native_aio = 0 in my.cnf";
+		++n;
+	}
 
-		break;
+	while (n--) {
+		os_uring_close(&rings[n]);
 	}
 
-	return(false);
+	if (err != 0) {
+		ib::warn() << "io_uring_setup() failed with error " << err
+			   << ". You can disable io_uring by setting"
+			   " innodb_use_io_uring = 0 in my.cnf";
+	}
+
+	return(err == 0);
 }
 
-/** Checks if the system supports native linux aio. On some kernel
-versions where native aio is supported it won't work on tmpfs. In such
-cases we can't use native aio as it is not possible to mix simulated
-and native aio.
-@return: true if supported, false otherwise. */
-bool
-AIO::is_linux_native_aio_supported()
+/** Submit the queued requests of all io_uring instances. */
+void
+AIO::uring_submit_all()
 {
-	int		fd;
-	io_context_t	io_ctx;
-	char		name[1000];
+	AIO*	arrays[] = { s_ibuf, s_log, s_reads, s_writes };
 
-	if (!linux_create_io_ctx(1, &io_ctx)) {
-
-		/* The platform does not support native aio. */
+	for (ulint i = 0; i < UT_ARR_SIZE(arrays); ++i) {
+		AIO*	array = arrays[i];
 
-		return(false);
+		if (array == NULL) {
+			continue;
+		}
 
-	} else if (!srv_read_only_mode) {
+		for (ulint j = 0; j < array->m_n_segments; ++j) {
+			array->uring_submit(j, false);
+		}
+	}
+}
 
-		/* Now check if tmpdir supports native aio ops. */
-		fd = innobase_mysql_tmpfile(NULL);
+/** Wake up the I/O handler threads that wait for completions,
+by submitting a no-op request to each io_uring instance. */
+void
+AIO::uring_wake_at_shutdown()
+{
+	AIO*	arrays[] = { s_ibuf, s_log, s_reads, s_writes };
 
-		if (fd < 0) {
-			ib::warn()
-				<< "Unable to create temp file to check"
-				" native AIO support.";
+	for (ulint i = 0; i < UT_ARR_SIZE(arrays); ++i) {
+		AIO*	array = arrays[i];
 
-			return(false);
+		if (array == NULL) {
+			continue;
 		}
-	} else {
 
-		os_normalize_path(srv_log_group_home_dir);
+		for (ulint j = 0; j < array->m_n_segments; ++j) {
+			os_uring_t*	ring = array->uring(j);
 
-		ulint	dirnamelen = strlen(srv_log_group_home_dir);
+			array->acquire();
 
-		ut_a(dirnamelen < (sizeof name) - 10 - sizeof "ib_logfile");
+			unsigned	tail = *ring->sq_tail;
 
-		memcpy(name, srv_log_group_home_dir, dirnamelen);
+			if (tail - os_uring_load(ring->sq_head)
+			    < ring->sq_entries) {
+				unsigned		index
+					= tail & ring->sq_mask;
+				struct io_uring_sqe*	sqe
+					= &ring->sqes[index];
 
-		/* Add a path separator if needed. */
-		if (dirnamelen && name[dirnamelen - 1] != OS_PATH_SEPARATOR) {
+				memset(sqe, 0x0, sizeof *sqe);
+				sqe->opcode = IORING_OP_NOP;
 
-			name[dirnamelen++] = OS_PATH_SEPARATOR;
+				ring->sq_array[index] = index;
+				os_uring_store(ring->sq_tail, tail + 1);
+				++ring->n_unsubmitted;
+			}
+
+			array->release();
+
+			array->uring_submit(j, false);
 		}
+	}
+}
 
-		strcpy(name + dirnamelen, "ib_logfile0");
+/** Replace the fixed buffers of the io_uring instances.
+Requests that were passed to the kernel keep using the buffers that
+were registered at that time. Requests that were only queued refer to
+a fixed buffer by its index, which may change; they are submitted
+before the buffers are replaced.
+@param[in]	bufs		memory areas ordered by address
+@return true on success */
+bool
+AIO::uring_register(const std::vector<iovec>& bufs)
+{
+	for (ulint i = 0; i < m_n_segments; ++i) {
+		os_uring_t*	ring = uring(i);
 
-		fd = open(name, O_RDONLY | O_CLOEXEC);
+		acquire();
 
-		if (fd == -1) {
+		while (unsigned n = ring->n_unsubmitted) {
+			int	ret = os_uring_enter(ring->fd, n, 0, 0);
 
-			ib::warn()
-				<< "Unable to open"
-				<< " \"" << name << "\" to check native"
-				<< " AIO read support.";
+			if (ret > 0) {
+				ut_ad(unsigned(ret) <= n);
+				ring->n_unsubmitted -= unsigned(ret);
+			} else if (ret == 0
+				   || (errno != EAGAIN && errno != EINTR)) {
+				ib::fatal() << "io_uring_enter() failed"
+					" with error " << errno;
+			}
+		}
 
-			return(false);
+		if (ring->n_bufs) {
+			os_uring_register(ring->fd,
+					  IORING_UNREGISTER_BUFFERS, NULL, 0);
+			ut_free(ring->bufs);
+			ring->bufs = NULL;
+			ring->n_bufs = 0;
 		}
-	}
 
-	struct io_event	io_event;
+		if (bufs.empty()) {
+		} else if (os_uring_register(ring->fd,
+					     IORING_REGISTER_BUFFERS,
+					     &bufs[0],
+					     unsigned(bufs.size()))) {
+			int	err = errno;
 
-	memset(&io_event, 0x0, sizeof(io_event));
+			release();
 
-	byte*	buf = static_cast<byte*>(ut_malloc_nokey(UNIV_PAGE_SIZE * 2));
-	byte*	ptr = static_cast<byte*>(ut_align(buf, UNIV_PAGE_SIZE));
+			ib::info() << "io_uring could not register the"
+				" buffer pool (error " << err << ")."
+				" Check ulimit -l.";
 
-	struct iocb	iocb;
+			return(false);
+		} else {
+			ring->n_bufs = unsigned(bufs.size());
+			ring->bufs = static_cast<struct iovec*>(
+				ut_malloc_nokey(bufs.size() * sizeof bufs[0]));
+			memcpy(ring->bufs, &bufs[0],
+			       bufs.size() * sizeof bufs[0]);
+		}
 
-	/* Suppress valgrind warning. */
-	memset(buf, 0x00, UNIV_PAGE_SIZE * 2);
-	memset(&iocb, 0x0, sizeof(iocb));
+		release();
+	}
 
-	struct iocb*	p_iocb = &iocb;
+	return(true);
+}
 
-	if (!srv_read_only_mode) {
+/** Compare the addresses of two memory areas.
+@param[in]	a	memory area
+@param[in]	b	memory area
+@return whether a precedes b */
+static
+bool
+os_uring_iovec_less(const struct iovec& a, const struct iovec& b)
+{
+	return(a.iov_base < b.iov_base);
+}
 
-		io_prep_pwrite(p_iocb, fd, ptr, UNIV_PAGE_SIZE, 0);
+/** Register memory areas as fixed buffers with the io_uring instances
+of the arrays that read and write buffer pool pages.
+@param[in]	iov	memory areas
+@param[in]	n	number of memory areas, or 0 to unregister */
+void
+AIO::uring_register_buffers(const struct iovec* iov, ulint n)
+{
+	std::vector<iovec>	bufs(iov, iov + n);
 
-	} else {
-		ut_a(UNIV_PAGE_SIZE >= 512);
-		io_prep_pread(p_iocb, fd, ptr, 512, 0);
-	}
+	std::sort(bufs.begin(), bufs.end(), os_uring_iovec_less);
 
-	int	err = io_submit(io_ctx, 1, &p_iocb);
+	if (bufs.size() > IOV_MAX) {
+		ib::info() << "io_uring can register at most " << IOV_MAX
+			<< " buffers; not registering the " << bufs.size()
+			<< " buffer pool chunks";
 
-	if (err >= 1) {
-		/* Now collect the submitted IO request. */
-		err = io_getevents(io_ctx, 1, 1, &io_event, NULL);
+		bufs.clear();
 	}
 
-	ut_free(buf);
-	close(fd);
+	AIO*	arrays[] = { s_ibuf, s_reads, s_writes };
+	bool	ok = true;
 
-	switch (err) {
-	case 1:
-		return(true);
+	if (!bufs.empty()
+	    && !(s_reads->uring(0)->features & IORING_FEAT_RSRC_TAGS)) {
+		/* Before Linux 5.13, registering or unregistering buffers
+		waits until the io_uring instance is idle. That includes
+		the I/O handler threads that wait in io_uring_enter(), which
+		may never return while we are holding AIO::m_mutex. */
+		ib::info() << "io_uring fixed buffers require Linux 5.13"
+			" or later; not registering the buffer pool";
 
-	case -EINVAL:
-	case -ENOSYS:
-		ib::error()
-			<< "Linux Native AIO not supported. You can either"
-			" move "
-			<< (srv_read_only_mode ? name : "tmpdir")
-			<< " to a file system that supports native"
-			" AIO or you can set innodb_use_native_aio to"
-			" FALSE to avoid this message.";
+		bufs.clear();
+	}
 
-		/* fall through. */
-	default:
-		ib::error()
-			<< "Linux Native AIO check on "
-			<< (srv_read_only_mode ? name : "tmpdir")
-			<< "returned error[" << -err << "]";
+	for (ulint i = 0; i < UT_ARR_SIZE(arrays); ++i) {
+		if (arrays[i] != NULL && !arrays[i]->uring_register(
+			    ok ? bufs : std::vector<iovec>())) {
+			ok = false;
+		}
 	}
 
-	return(false);
+	if (!ok) {
+		/* Do not leave some instances with fixed buffers and
+		others without. */
+		uring_register_buffers(NULL, 0);
+	}
 }
 
-#endif /* LINUX_NATIVE_AIO */
+/** Process an io_uring request. See os_aio_linux_handler().
+@param[in]	global_segment	segment number in the aio array
+@param[out]	m1		the messages passed with the
+@param[out]	m2		AIO request
+@param[out]	request		IO context
+@return DB_SUCCESS if the IO was successful */
+static
+dberr_t
+os_aio_uring_handler(
+	ulint		global_segment,
+	fil_node_t**	m1,
+	void**		m2,
+	IORequest*	request)
+{
+	return UringAIOHandler(global_segment).poll(m1, m2, request);
+}
+#endif /* HAVE_URING */
 
 /** Retrieves the last error number if an error occurs in a file io function.
 The number should be retrieved before any other OS calls (because they may
@@ -5633,9 +6682,22 @@ os_aio_handler(
 
 		err = os_aio_windows_handler(segment, 0, m1, m2, request);
 
-#elif defined(LINUX_NATIVE_AIO)
+#elif defined(HAVE_URING) || defined(LINUX_NATIVE_AIO)
+
+# ifdef HAVE_URING
+		if (srv_use_io_uring) {
+			err = os_aio_uring_handler(segment, m1, m2, request);
+		} else
+# endif /* HAVE_URING */
+		{
+# ifdef LINUX_NATIVE_AIO
+			err = os_aio_linux_handler(segment, m1, m2, request);
+# else
+			ut_error;
 
-		err = os_aio_linux_handler(segment, m1, m2, request);
+			err = DB_ERROR;
+# endif /* LINUX_NATIVE_AIO */
+		}
 
 #else
 		ut_error;
@@ -5669,6 +6731,9 @@ AIO::AIO(
 	,m_aio_ctx(),
 	m_events(m_slots.size())
 # endif /* LINUX_NATIVE_AIO */
+# ifdef HAVE_URING
+	,m_uring()
+# endif /* HAVE_URING */
 {
 	ut_a(n > 0);
 	ut_a(m_n_segments > 0);
@@ -5771,6 +6836,17 @@ AIO::init()
 {
 	ut_a(!m_slots.empty());
 
+#ifdef HAVE_URING
+	if (srv_use_io_uring) {
+		dberr_t	err = init_uring();
+
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
+
+		return(init_slots());
+	}
+#endif /* HAVE_URING */
 
 	if (srv_use_native_aio) {
 #ifdef LINUX_NATIVE_AIO
@@ -5836,6 +6912,16 @@ AIO::~AIO()
 	}
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef HAVE_URING
+	if (m_uring != NULL) {
+		for (ulint i = 0; i < m_n_segments; ++i) {
+			os_uring_close(&m_uring[i]);
+		}
+
+		ut_free(m_uring);
+	}
+#endif /* HAVE_URING */
+
 	m_slots.clear();
 }
 
@@ -5858,9 +6944,25 @@ AIO::start(
 	ulint		n_writers,
 	ulint		n_slots_sync)
 {
+#ifdef HAVE_URING
+	/* io_uring takes precedence over innodb_use_native_aio. If it
+	is not available, fall back to Linux native AIO or simulated AIO. */
+	if (!srv_use_io_uring) {
+	} else if (is_uring_supported(
+			   n_readers + n_writers
+			   + (srv_read_only_mode ? 0 : 2), n_per_seg)) {
+		ib::info() << "Using io_uring";
+		srv_use_native_aio = TRUE;
+	} else {
+		ib::warn() << "io_uring disabled.";
+		srv_use_io_uring = FALSE;
+	}
+#endif /* HAVE_URING */
+
 #if defined(LINUX_NATIVE_AIO)
 	/* Check if native aio is supported on this system and tmpfs */
-	if (srv_use_native_aio && !is_linux_native_aio_supported()) {
+	if (srv_use_native_aio && !srv_use_io_uring
+	    && !is_linux_native_aio_supported()) {
 
 		ib::warn() << "Linux Native AIO disabled.";
 
@@ -6039,6 +7141,14 @@ os_aio_wake_all_threads_at_shutdown()
 	No need to do anything to wake them up. */
 #endif /* !WIN_ASYNC_AIO */
 
+#ifdef HAVE_URING
+	if (srv_use_io_uring) {
+		/* The io_uring handler threads wait without a timeout. */
+		AIO::uring_wake_at_shutdown();
+		return;
+	}
+#endif /* HAVE_URING */
+
 	if (srv_use_native_aio) {
 		return;
 	}
@@ -6059,6 +7169,19 @@ os_aio_wait_until_no_pending_writes()
 	AIO::wait_until_no_pending_writes();
 }
 
+#ifdef HAVE_URING
+/** Register memory areas as fixed buffers with io_uring.
+@param[in]	iov	memory areas
+@param[in]	n	number of memory areas, or 0 to unregister all */
+void
+os_aio_register_buffers(const struct iovec* iov, ulint n)
+{
+	if (srv_use_io_uring) {
+		AIO::uring_register_buffers(iov, n);
+	}
+}
+#endif /* HAVE_URING */
+
 /** Calculates segment number for a slot.
 @param[in]	array		AIO wait array
 @param[in]	slot		slot in this array
@@ -6152,9 +7275,11 @@ AIO::reserve_slot(
 
 		release();
 
-		if (!srv_use_native_aio) {
+		if (!srv_use_native_aio || srv_use_io_uring) {
 			/* If the handler threads are suspended,
-			wake them so that we get more slots */
+			or requests are waiting in the io_uring
+			submission queues, wake them so that we
+			get more slots */
 
 			os_aio_simulated_wake_handler_threads();
 		}
@@ -6320,6 +7445,14 @@ void
 os_aio_simulated_wake_handler_threads()
 {
 	if (srv_use_native_aio) {
+#ifdef HAVE_URING
+		if (srv_use_io_uring) {
+			/* Submit the requests that were posted with
+			IORequest::DO_NOT_WAKE as one batch */
+			AIO::uring_submit_all();
+		}
+#endif /* HAVE_URING */
+
 		/* We do not use simulated aio: do nothing */
 
 		return;
@@ -6628,10 +7761,18 @@ os_aio_func(
 			ret = ReadFile(
 				file, slot->ptr, slot->len,
 				NULL, &slot->control);
-#elif defined(LINUX_NATIVE_AIO)
-			if (!array->linux_dispatch(slot)) {
+#else
+# ifdef HAVE_URING
+			if (srv_use_io_uring) {
+				array->uring_dispatch(slot, type.is_wake());
+			}
+# endif /* HAVE_URING */
+# ifdef LINUX_NATIVE_AIO
+			if (!srv_use_io_uring
+			    && !array->linux_dispatch(slot)) {
 				goto err_exit;
 			}
+# endif /* LINUX_NATIVE_AIO */
 #endif /* WIN_ASYNC_IO */
 		} else if (type.is_wake()) {
 			AIO::wake_simulated_handler_thread(
@@ -6646,10 +7787,18 @@ os_aio_func(
 			ret = WriteFile(
 				file, slot->ptr, slot->len,
 				NULL, &slot->control);
-#elif defined(LINUX_NATIVE_AIO)
-			if (!array->linux_dispatch(slot)) {
+#else
+# ifdef HAVE_URING
+			if (srv_use_io_uring) {
+				array->uring_dispatch(slot, type.is_wake());
+			}
+# endif /* HAVE_URING */
+# ifdef LINUX_NATIVE_AIO
+			if (!srv_use_io_uring
+			    && !array->linux_dispatch(slot)) {
 				goto err_exit;
 			}
+# endif /* LINUX_NATIVE_AIO */
 #endif /* WIN_ASYNC_IO */
 
 		} else if (type.is_wake()) {
@@ -299,6 +299,123 @@ page_cur_rec_field_extends(
 }
 #endif /* PAGE_CUR_LE_OR_EXTENDS */
 
+/** Maximum number of fields in page_cur_memcmp_key_t */
+#define PAGE_CUR_MEMCMP_MAX_FIELDS	16
+/** Maximum number of bytes in page_cur_memcmp_key_t */
+#define PAGE_CUR_MEMCMP_MAX_LEN		128
+
+/** The leading fields of a search tuple in the format in which they
+are stored at the origin of the records, so that page_cur_search_with_match()
+can compare them with a single memcmp() per record and without
+rec_get_offsets(). See dict_index_t::n_memcmp_fields. */
+struct page_cur_memcmp_key_t {
+	/** number of fields in buf, or 0 if the fast path is unusable */
+	ulint	n_fields;
+	/** dtuple_get_n_fields_cmp() of the search tuple */
+	ulint	n_fields_cmp;
+	/** end offset of each field, both in buf and in the records */
+	ulint	end[PAGE_CUR_MEMCMP_MAX_FIELDS];
+	/** the concatenated field values */
+	byte	buf[PAGE_CUR_MEMCMP_MAX_LEN];
+};
+
+/** Copy the memcmp()-comparable prefix of a search tuple.
+@param[out]	key	the prefix of the search tuple
+@param[in]	index	B-tree index
+@param[in]	tuple	search tuple */
+static
+void
+page_cur_memcmp_key_init(
+	page_cur_memcmp_key_t*	key,
+	const dict_index_t*	index,
+	const dtuple_t*		tuple)
+{
+	key->n_fields = 0;
+	key->n_fields_cmp = dtuple_get_n_fields_cmp(tuple);
+
+	if (dtuple_get_info_bits(tuple) & REC_INFO_MIN_REC_FLAG) {
+		return;
+	}
+
+	const ulint	n = std::min<ulint>(
+		std::min<ulint>(index->n_memcmp_fields, key->n_fields_cmp),
+		PAGE_CUR_MEMCMP_MAX_FIELDS);
+	ulint		len = 0;
+
+	for (ulint i = 0; i < n; i++) {
+		const dfield_t*	dfield = dtuple_get_nth_field(tuple, i);
+		const ulint	flen = dfield_get_len(dfield);
+
+		if (flen != dict_index_get_nth_field(index, i)->fixed_len
+		    || len + flen > PAGE_CUR_MEMCMP_MAX_LEN) {
+			break;
+		}
+
+		memcpy(key->buf + len, dfield_get_data(dfield), flen);
+		len += flen;
+		key->end[key->n_fields++] = len;
+	}
+}
+
+/** Compare the memcmp()-comparable prefix of a search tuple to a record.
+@param[in]	key		the prefix of the search tuple
+@param[in]	rec		B-tree record
+@param[in,out]	matched_fields	number of completely matched fields
+@param[out]	cmp		the result of the comparison, if known
+@return whether the comparison was completed; if not, it must be
+continued from *matched_fields with cmp_dtuple_rec_with_match() */
+static inline
+bool
+page_cur_memcmp_key_cmp(
+	const page_cur_memcmp_key_t*	key,
+	const rec_t*			rec,
+	ulint*				matched_fields,
+	int*				cmp)
+{
+	ulint	cur = *matched_fields;
+
+	if (cur >= key->n_fields) {
+		return(false);
+	}
+
+	if (!cur && (rec_get_info_bits(rec, TRUE) & REC_INFO_MIN_REC_FLAG)) {
+		/* The record is smaller than any search tuple that
+		does not carry REC_INFO_MIN_REC_FLAG. */
+		*cmp = 1;
+		return(true);
+	}
+
+	const ulint	start = cur ? key->end[cur - 1] : 0;
+	const byte*	t = key->buf + start;
+	const byte*	r = rec + start;
+	const ulint	len = key->end[key->n_fields - 1] - start;
+
+	if (!memcmp(t, r, len)) {
+		*matched_fields = key->n_fields;
+
+		if (key->n_fields < key->n_fields_cmp) {
+			return(false);
+		}
+
+		*cmp = 0;
+		return(true);
+	}
+
+	ulint	i = 0;
+
+	while (t[i] == r[i]) {
+		i++;
+	}
+
+	while (key->end[cur] <= start + i) {
+		cur++;
+	}
+
+	*matched_fields = cur;
+	*cmp = int(t[i]) - int(r[i]);
+	return(true);
+}
+
 /****************************************************************//**
 Searches the right position for a page cursor. */
 void
@@ -408,6 +525,9 @@ page_cur_search_with_match(
 	up_matched_fields  = *iup_matched_fields;
 	low_matched_fields = *ilow_matched_fields;
 
+	page_cur_memcmp_key_t	key;
+	page_cur_memcmp_key_init(&key, index, tuple);
+
 	/* Perform binary search. First the search is done through the page
 	directory, after that as a linear search in the list of records
 	owned by the upper limit directory slot. */
@@ -426,13 +546,16 @@ page_cur_search_with_match(
 		cur_matched_fields = std::min(low_matched_fields,
 					      up_matched_fields);
 
-		offsets = offsets_;
-		offsets = rec_get_offsets(
-			mid_rec, index, offsets, is_leaf,
-			dtuple_get_n_fields_cmp(tuple), &heap);
+		if (!page_cur_memcmp_key_cmp(&key, mid_rec,
+					     &cur_matched_fields, &cmp)) {
+			offsets = offsets_;
+			offsets = rec_get_offsets(
+				mid_rec, index, offsets, is_leaf,
+				dtuple_get_n_fields_cmp(tuple), &heap);
 
-		cmp = cmp_dtuple_rec_with_match(
-			tuple, mid_rec, offsets, &cur_matched_fields);
+			cmp = cmp_dtuple_rec_with_match(
+				tuple, mid_rec, offsets, &cur_matched_fields);
+		}
 
 		if (cmp > 0) {
 low_slot_match:
@@ -480,13 +603,16 @@ page_cur_search_with_match(
 		cur_matched_fields = std::min(low_matched_fields,
 					      up_matched_fields);
 
-		offsets = offsets_;
-		offsets = rec_get_offsets(
-			mid_rec, index, offsets, is_leaf,
-			dtuple_get_n_fields_cmp(tuple), &heap);
+		if (!page_cur_memcmp_key_cmp(&key, mid_rec,
+					     &cur_matched_fields, &cmp)) {
+			offsets = offsets_;
+			offsets = rec_get_offsets(
+				mid_rec, index, offsets, is_leaf,
+				dtuple_get_n_fields_cmp(tuple), &heap);
 
-		cmp = cmp_dtuple_rec_with_match(
-			tuple, mid_rec, offsets, &cur_matched_fields);
+			cmp = cmp_dtuple_rec_with_match(
+				tuple, mid_rec, offsets, &cur_matched_fields);
+		}
 
 		if (cmp > 0) {
 low_rec_match:
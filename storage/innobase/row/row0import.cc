@@ -3273,6 +3273,8 @@ struct fil_iterator_t {
 						for IO */
 	byte*		io_buffer;		/*!< Buffer to use for IO */
 	fil_space_crypt_t *crypt_data;		/*!< Crypt data (if encrypted) */
+	fil_zstd_dict_t* zstd_dict;		/*!< Zstandard dictionary
+						(if any) */
 	byte*           crypt_io_buffer;        /*!< IO buffer when encrypted */
 };
 
@@ -3409,7 +3411,8 @@ fil_iterate(
 			to decompress it before adjusting further. */
 			if (page_compressed) {
 				fil_decompress_page(NULL, dst, ulong(size),
-						    NULL);
+						    NULL, false,
+						    iter.zstd_dict);
 				updated = true;
 			} else if (buf_page_is_corrupted(
 					   false,
@@ -3632,6 +3635,8 @@ fil_tablespace_iterate(
 		/* read (optional) crypt data */
 		iter.crypt_data = fil_space_read_crypt_data(
 			callback.get_page_size(), page);
+		iter.zstd_dict = fil_zstd_dict_read(
+			callback.get_space_flags(), page);
 
 		/* If tablespace is encrypted, it needs extra buffers */
 		if (iter.crypt_data && n_io_buffers > 1) {
@@ -3674,6 +3679,8 @@ fil_tablespace_iterate(
 			fil_space_destroy_crypt_data(&iter.crypt_data);
 		}
 
+		fil_zstd_dict_free(iter.zstd_dict);
+
 		ut_free(crypt_io_buffer);
 		ut_free(io_buffer);
 	}
@@ -3170,6 +3170,128 @@ row_ins_sec_index_entry_low(
 	DBUG_RETURN(err);
 }
 
+/** Determine if the current SQL statement is inserting rows into
+a table without writing undo log records (innodb_bulk_insert).
+@param[in]	table	table
+@param[in]	trx	transaction
+@return	whether the rows are being inserted without undo log records */
+static
+bool
+row_ins_is_bulk(const dict_table_t* table, const trx_t* trx)
+{
+	if (!trx->bulk_insert) {
+		return(false);
+	}
+
+	trx_mod_tables_t::const_iterator i = trx->mod_tables.find(
+		const_cast<dict_table_t*>(table));
+
+	return(i != trx->mod_tables.end()
+	       && i->second.is_bulk_insert(
+		       trx->last_sql_stat_start.least_undo_no));
+}
+
+/** Check if an index tree is empty.
+@param[in]	index	index tree
+@return	whether the root page is an empty leaf page */
+static
+bool
+row_ins_index_is_empty(const dict_index_t* index)
+{
+	mtr_t	mtr;
+	mtr.start();
+
+	const buf_block_t*	root = btr_root_block_get(
+		index, RW_S_LATCH, &mtr);
+	const bool		empty = root
+		&& page_is_leaf(root->frame) && page_is_empty(root->frame);
+
+	mtr.commit();
+	return(empty);
+}
+
+/** Determine if a row can be inserted into the clustered index without
+writing an undo log record (innodb_bulk_insert). When the current SQL
+statement is inserting the first row into an empty table, lock the
+table exclusively and write a TRX_UNDO_EMPTY record, so that a rollback
+will empty the table instead of removing the rows one by one.
+@param[in,out]	index	clustered index
+@param[in,out]	thr	query thread
+@param[out]	bulk	whether the row can be inserted without undo logging
+@return	DB_SUCCESS, DB_LOCK_WAIT or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_ins_clust_index_bulk(dict_index_t* index, que_thr_t* thr, bool* bulk)
+{
+	trx_t*		trx	= thr_get_trx(thr);
+	dict_table_t*	table	= index->table;
+
+	ut_ad(dict_index_is_clust(index));
+	ut_ad(trx->bulk_insert);
+
+	*bulk = false;
+
+	trx_mod_tables_t::iterator	i = trx->mod_tables.find(table);
+
+	if (i != trx->mod_tables.end()) {
+		/* Only the first modification of the table in the
+		transaction may start a bulk insert. */
+		*bulk = i->second.is_bulk_insert(
+			trx->last_sql_stat_start.least_undo_no);
+		return(DB_SUCCESS);
+	}
+
+	/* INSERT IGNORE, REPLACE and ON DUPLICATE KEY UPDATE would
+	need to roll back individual rows. Data dictionary operations
+	must not lock the tables exclusively. */
+	if (trx->duplicates || trx->dict_operation_lock_mode
+	    || table->is_temporary() || table->versioned()
+	    || table->is_instant()
+	    || !table->foreign_set.empty()
+	    || !table->referenced_set.empty()
+	    || dict_table_has_fts_index(table)) {
+		return(DB_SUCCESS);
+	}
+
+	for (const dict_index_t* index2 = index; index2 != NULL;
+	     index2 = dict_table_get_next_index(index2)) {
+		if ((index2->type & (DICT_FTS | DICT_SPATIAL))
+		    || !index2->is_committed()
+		    || dict_index_is_online_ddl(index2)) {
+			return(DB_SUCCESS);
+		}
+	}
+
+	if (!row_ins_index_is_empty(index)) {
+		return(DB_SUCCESS);
+	}
+
+	dberr_t	err = lock_table(0, table, LOCK_X, thr);
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
+	/* Another transaction may have inserted rows before we
+	were granted the exclusive lock. */
+	if (!row_ins_index_is_empty(index)) {
+		return(DB_SUCCESS);
+	}
+
+	const undo_no_t	undo_no = trx->undo_no;
+
+	err = trx_undo_report_empty(trx, table);
+
+	if (err == DB_SUCCESS) {
+		trx->mod_tables.insert(
+			trx_mod_tables_t::value_type(table, undo_no))
+			.first->second.start_bulk_insert();
+		*bulk = true;
+	}
+
+	return(err);
+}
+
 /***************************************************************//**
 Inserts an entry into a clustered index. Tries first optimistic,
 then pessimistic descent down the tree. If the entry matches enough
@@ -3217,6 +3339,25 @@ row_ins_clust_index_entry(
 	*/
 	if (index->table->skip_alter_undo) {
 		flags |= BTR_NO_UNDO_LOG_FLAG | BTR_NO_LOCKING_FLAG;
+	} else if (index->table->intrinsic) {
+		/* Changes to intrinsic temporary tables are not
+		undo logged. DB_TRX_ID is retained. */
+		flags |= BTR_NO_UNDO_LOG_FLAG;
+	} else if (thr_get_trx(thr)->bulk_insert && !dup_chk_only) {
+		/* When loading rows into an empty table, skip
+		the undo log and record locking. The table is
+		exclusively locked, and a rollback will empty it. */
+		bool	bulk;
+
+		err = row_ins_clust_index_bulk(index, thr, &bulk);
+
+		if (err != DB_SUCCESS) {
+			DBUG_RETURN(err);
+		}
+
+		if (bulk) {
+			flags |= BTR_NO_UNDO_LOG_FLAG | BTR_NO_LOCKING_FLAG;
+		}
 	}
 
 	/* Try first optimistic descent to the B-tree */
@@ -3273,6 +3414,11 @@ row_ins_sec_index_entry(
 			DBUG_SET("-d,row_ins_sec_index_entry_timeout");
 			return(DB_LOCK_WAIT);});
 
+	DBUG_EXECUTE_IF("row_ins_sec_index_entry_intrinsic_full",
+			if (index->table->intrinsic && !dup_chk_only) {
+				return(DB_OUT_OF_FILE_SPACE);
+			});
+
 	if (!index->table->foreign_set.empty()) {
 		err = row_ins_check_foreign_constraints(index->table, index,
 							entry, thr);
@@ -3301,6 +3447,10 @@ row_ins_sec_index_entry(
 	if (index->table->skip_alter_undo) {
 		trx_id = thr_get_trx(thr)->id;
 		flags |= BTR_NO_UNDO_LOG_FLAG | BTR_NO_LOCKING_FLAG;
+	} else if (row_ins_is_bulk(index->table, thr_get_trx(thr))) {
+		/* The table is exclusively locked (innodb_bulk_insert). */
+		trx_id = thr_get_trx(thr)->id;
+		flags |= BTR_NO_LOCKING_FLAG;
 	}
 
 	err = row_ins_sec_index_entry_low(
@@ -3319,7 +3469,7 @@ row_ins_sec_index_entry(
 
 		err = row_ins_sec_index_entry_low(
 			flags, BTR_MODIFY_TREE, index,
-			offsets_heap, heap, entry, 0, thr,
+			offsets_heap, heap, entry, trx_id, thr,
 			dup_chk_only);
 	}
 
@@ -3494,7 +3644,7 @@ row_ins_index_entry_step(
 	err = row_ins_index_entry_set_vals(node->index, node->entry, node->row);
 
 	if (err != DB_SUCCESS) {
-		DBUG_RETURN(err);
+		goto func_exit;
 	}
 
 	ut_ad(dtuple_check_typed(node->entry));
@@ -3504,9 +3654,114 @@ row_ins_index_entry_step(
 	DEBUG_SYNC_C_IF_THD(thr_get_trx(thr)->mysql_thd,
 			    "after_row_ins_index_entry_step");
 
+func_exit:
+	if (err != DB_SUCCESS && node->table->intrinsic) {
+		row_ins_intrinsic_failed(node->index, err, "INSERT");
+	}
+
 	DBUG_RETURN(err);
 }
 
+/** Flag an intrinsic temporary table corrupted after a change to an
+index failed, unless it is known that no index was modified. The changes
+are not undo logged, so a row could be left in some indexes only.
+@param[in]	index	the index whose modification failed
+@param[in]	err	error code
+@param[in]	ctx	context, for the error message */
+void
+row_ins_intrinsic_failed(
+	const dict_index_t*	index,
+	dberr_t			err,
+	const char*		ctx)
+{
+	ut_ad(index->table->intrinsic);
+	ut_ad(err != DB_SUCCESS);
+
+	if (dict_index_is_clust(index)) {
+		switch (err) {
+		case DB_DUPLICATE_KEY:
+		case DB_TOO_BIG_RECORD:
+			/* The clustered index is modified first,
+			and these errors are reported before the
+			record is inserted or updated. */
+			return;
+		default:
+			/* The record may have been inserted before
+			the off-page columns could be written. */
+			break;
+		}
+	}
+
+	dict_index_t*	clust_index = dict_table_get_first_index(
+		index->table);
+
+	ib::error() << "Flagged corruption of " << clust_index->name
+		<< " in table " << index->table->name << " in " << ctx
+		<< ": " << ut_strerr(err);
+
+	mutex_enter(&dict_sys->mutex);
+	dict_set_corrupted_index_cache_only(clust_index);
+	mutex_exit(&dict_sys->mutex);
+}
+
+/** Check for duplicates in the UNIQUE indexes of an intrinsic temporary
+table before inserting a row into any index. The changes cannot be
+rolled back, so a duplicate in a UNIQUE secondary index must be found
+before the row is inserted into the clustered index.
+@param[in,out]	node	row insert node
+@param[in,out]	thr	query thread
+@return DB_SUCCESS, DB_DUPLICATE_KEY, or some other error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_ins_intrinsic_check_dup(ins_node_t* node, que_thr_t* thr)
+{
+	dict_index_t*	index = dict_table_get_first_index(node->table);
+	dict_index_t*	sec;
+
+	ut_ad(node->table->intrinsic);
+
+	for (sec = dict_table_get_next_index(index); sec != NULL;
+	     sec = dict_table_get_next_index(sec)) {
+		if (dict_index_is_unique(sec)
+		    && !dict_index_is_corrupted(sec)) {
+			break;
+		}
+	}
+
+	if (sec == NULL) {
+		/* Only the clustered index can report a duplicate,
+		before anything has been inserted. */
+		return(DB_SUCCESS);
+	}
+
+	for (dtuple_t* entry = UT_LIST_GET_FIRST(node->entry_list);
+	     index != NULL;
+	     index = dict_table_get_next_index(index),
+	     entry = UT_LIST_GET_NEXT(tuple_list, entry)) {
+		if (!dict_index_is_unique(index)
+		    || dict_index_is_corrupted(index)) {
+			continue;
+		}
+
+		dberr_t	err = row_ins_index_entry_set_vals(
+			index, entry, node->row);
+
+		if (err == DB_SUCCESS) {
+			err = dict_index_is_clust(index)
+				? row_ins_clust_index_entry(
+					index, entry, thr, 0, true)
+				: row_ins_sec_index_entry(
+					index, entry, thr, true);
+		}
+
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
+	}
+
+	return(DB_SUCCESS);
+}
+
 /***********************************************************//**
 Allocates a row id for row and inits the node->index field. */
 UNIV_INLINE
@@ -3639,6 +3894,15 @@ row_ins(
 
 	ut_ad(node->state == INS_NODE_INSERT_ENTRIES);
 
+	if (node->table->intrinsic
+	    && node->index == dict_table_get_first_index(node->table)) {
+		err = row_ins_intrinsic_check_dup(node, thr);
+
+		if (err != DB_SUCCESS) {
+			DBUG_RETURN(err);
+		}
+	}
+
 	while (node->index != NULL) {
 		if (node->index->type != DICT_FTS) {
 			err = row_ins_index_entry_step(node, thr);
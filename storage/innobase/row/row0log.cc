@@ -1502,6 +1502,8 @@ row_log_table_apply_convert_mrec(
 	dict_index_t*		index,		/*!< in: index of mrec */
 	const ulint*		offsets,	/*!< in: offsets of mrec */
 	const row_log_t*	log,		/*!< in: rebuild context */
+	ulonglong		total,		/*!< in: row_log_t::head::total
+						after the record */
 	mem_heap_t*		heap,		/*!< in/out: memory heap */
 	dberr_t*		error)		/*!< out: DB_SUCCESS or
 						DB_MISSING_HISTORY or
@@ -1571,7 +1573,7 @@ row_log_table_apply_convert_mrec(
 				page_no_map::const_iterator p = blobs->find(
 					page_no);
 				if (p != blobs->end()
-				    && p->second.is_freed(log->head.total)) {
+				    && p->second.is_freed(total)) {
 					/* This BLOB has been freed.
 					We must not access the row. */
 					*error = DB_MISSING_HISTORY;
@@ -1649,6 +1651,21 @@ row_log_table_apply_convert_mrec(
 	return(row);
 }
 
+/** Report an erroneous row using the new version of the table.
+The MySQL record buffer is shared by all threads applying the log.
+@param[in,out]	dup	for reporting duplicate key errors
+@param[in]	row	the row in the old table definition */
+static
+void
+row_log_table_report(row_merge_dup_t* dup, const dtuple_t* row)
+{
+	row_log_t*	log = dup->index->online_log;
+
+	mutex_enter(&log->mutex);
+	innobase_row_to_mysql(dup->table, log->table, row);
+	mutex_exit(&log->mutex);
+}
+
 /******************************************************//**
 Replays an insert operation on a table that was rebuilt.
 @return DB_SUCCESS or error code */
@@ -1734,6 +1751,8 @@ row_log_table_apply_insert(
 	que_thr_t*		thr,		/*!< in: query graph */
 	const mrec_t*		mrec,		/*!< in: record to insert */
 	const ulint*		offsets,	/*!< in: offsets of mrec */
+	ulonglong		total,		/*!< in: row_log_t::head::total
+						after the record */
 	mem_heap_t*		offsets_heap,	/*!< in/out: memory heap
 						that can be emptied */
 	mem_heap_t*		heap,		/*!< in/out: memory heap */
@@ -1743,7 +1762,7 @@ row_log_table_apply_insert(
 	const row_log_t*log	= dup->index->online_log;
 	dberr_t		error;
 	const dtuple_t*	row	= row_log_table_apply_convert_mrec(
-		mrec, dup->index, offsets, log, heap, &error);
+		mrec, dup->index, offsets, log, total, heap, &error);
 
 	switch (error) {
 	case DB_MISSING_HISTORY:
@@ -1770,7 +1789,7 @@ row_log_table_apply_insert(
 	if (error != DB_SUCCESS) {
 		/* Report the erroneous row using the new
 		version of the table. */
-		innobase_row_to_mysql(dup->table, log->table, row);
+		row_log_table_report(dup, row);
 	}
 	return(error);
 }
@@ -2014,6 +2033,8 @@ row_log_table_apply_update(
 						clustered index */
 	const mrec_t*		mrec,		/*!< in: new value */
 	const ulint*		offsets,	/*!< in: offsets of mrec */
+	ulonglong		total,		/*!< in: row_log_t::head::total
+						after the record */
 	mem_heap_t*		offsets_heap,	/*!< in/out: memory heap
 						that can be emptied */
 	mem_heap_t*		heap,		/*!< in/out: memory heap */
@@ -2039,7 +2060,7 @@ row_log_table_apply_update(
 	      + (log->same_pk ? 0 : 2));
 
 	row = row_log_table_apply_convert_mrec(
-		mrec, dup->index, offsets, log, heap, &error);
+		mrec, dup->index, offsets, log, total, heap, &error);
 
 	switch (error) {
 	case DB_MISSING_HISTORY:
@@ -2143,7 +2164,7 @@ row_log_table_apply_update(
 		if (error != DB_SUCCESS) {
 			/* Report the erroneous row using the new
 			version of the table. */
-			innobase_row_to_mysql(dup->table, log->table, row);
+			row_log_table_report(dup, row);
 		}
 
 		return(error);
@@ -2365,11 +2386,90 @@ row_log_table_apply_update(
 	goto func_exit;
 }
 
+/** A log record that was handed over to a row_log_table_apply_ops()
+worker thread */
+struct row_log_table_task_t {
+	/** start of the log record */
+	const mrec_t*	mrec;
+	/** row_log_t::head::total before the record */
+	ulonglong	total;
+};
+
+/** A thread that applies a share of each block of the table-rebuild log */
+struct row_log_table_worker_t {
+	/** the log records to apply, in the order they were logged */
+	std::vector<row_log_table_task_t, ut_allocator<row_log_table_task_t> >
+			tasks;
+	/** query graph */
+	que_thr_t*	thr;
+	/** for reporting duplicate key errors */
+	row_merge_dup_t	dup;
+	/** position of DB_TRX_ID in the new clustered index */
+	ulint		new_trx_id_col;
+	/** end of the log block */
+	const mrec_t*	mrec_end;
+	/** memory heap */
+	mem_heap_t*	heap;
+	/** memory heap that can be emptied */
+	mem_heap_t*	offsets_heap;
+	/** work area for parsing the log records */
+	ulint*		offsets;
+	/** nonzero if some worker failed */
+	int32*		aborted;
+	/** signalled when tasks were handed over or the thread should exit;
+	NULL if the thread has not been created */
+	os_event_t	start;
+	/** signalled when the tasks have been applied */
+	os_event_t	done;
+	/** whether the thread should exit */
+	bool		exit;
+	/** the thread handle, if start != NULL */
+	os_thread_t	thread;
+	/** the outcome */
+	dberr_t		error;
+};
+
+/** Hand over a log record to the worker that is determined by the
+PRIMARY KEY value, so that the operations on each row are applied in the
+order in which they were logged.
+@param[in,out]	workers		row_log_table_apply_ops() workers
+@param[in]	n_workers	number of workers
+@param[in]	mrec_start	start of the log record
+@param[in]	total		row_log_t::head::total before the record
+@param[in]	mrec		record whose first fields are the PRIMARY KEY
+@param[in]	offsets		rec_get_offsets(mrec)
+@param[in]	n_uniq		number of PRIMARY KEY fields */
+static
+void
+row_log_table_dispatch(
+	row_log_table_worker_t*	workers,
+	ulint			n_workers,
+	const mrec_t*		mrec_start,
+	ulonglong		total,
+	const mrec_t*		mrec,
+	const ulint*		offsets,
+	ulint			n_uniq)
+{
+	ulint	fold = 0;
+
+	for (ulint i = 0; i < n_uniq; i++) {
+		ulint		len;
+		const byte*	field = rec_get_nth_field(
+			mrec, offsets, i, &len);
+		ut_ad(len != UNIV_SQL_NULL);
+		ut_ad(!rec_offs_nth_extern(offsets, i));
+		fold = ut_fold_ulint_pair(fold, ut_fold_binary(field, len));
+	}
+
+	row_log_table_task_t	task = { mrec_start, total };
+	workers[fold % n_workers].tasks.push_back(task);
+}
+
 /******************************************************//**
 Applies an operation to a table that was rebuilt.
 @return NULL on failure (mrec corruption) or when out of data;
 pointer to next record on success */
-static MY_ATTRIBUTE((nonnull, warn_unused_result))
+static MY_ATTRIBUTE((nonnull(1,3,4,5,6,7,8,9,10), warn_unused_result))
 const mrec_t*
 row_log_table_apply_op(
 /*===================*/
@@ -2385,8 +2485,14 @@ row_log_table_apply_op(
 	mem_heap_t*		heap,		/*!< in/out: memory heap */
 	const mrec_t*		mrec,		/*!< in: merge record */
 	const mrec_t*		mrec_end,	/*!< in: end of buffer */
-	ulint*			offsets)	/*!< in/out: work area
+	ulint*			offsets,	/*!< in/out: work area
 						for parsing mrec */
+	ulonglong*		total,		/*!< in/out: row_log_t::
+						head::total */
+	row_log_table_worker_t*	workers,	/*!< in/out: workers to
+						hand over the record to,
+						or NULL to apply it */
+	ulint			n_workers)	/*!< in: number of workers */
 {
 	row_log_t*	log	= dup->index->online_log;
 	dict_index_t*	new_index = dict_table_get_first_index(log->table);
@@ -2398,7 +2504,8 @@ row_log_table_apply_op(
 
 	ut_ad(dict_index_is_clust(dup->index));
 	ut_ad(dup->index->table != log->table);
-	ut_ad(log->head.total <= log->tail.total);
+	ut_ad(*total <= log->tail.total);
+	ut_ad(!workers || log->same_pk);
 
 	*error = DB_SUCCESS;
 
@@ -2443,10 +2550,12 @@ row_log_table_apply_op(
 
 		if (next_mrec > mrec_end) {
 			return(NULL);
+		} else if (workers) {
+			goto dispatch;
 		} else {
-			log->head.total += next_mrec - mrec_start;
+			*total += next_mrec - mrec_start;
 			*error = row_log_table_apply_insert(
-				thr, mrec, offsets, offsets_heap,
+				thr, mrec, offsets, *total, offsets_heap,
 				heap, dup);
 		}
 		break;
@@ -2475,9 +2584,11 @@ row_log_table_apply_op(
 
 		if (next_mrec > mrec_end) {
 			return(NULL);
+		} else if (workers) {
+			goto dispatch;
 		}
 
-		log->head.total += next_mrec - mrec_start;
+		*total += next_mrec - mrec_start;
 
 		/* If there are external fields, retrieve those logged
 		prefix info and reconstruct the row_ext_t */
@@ -2548,6 +2659,8 @@ row_log_table_apply_op(
 
 			if (next_mrec > mrec_end) {
 				return(NULL);
+			} else if (workers) {
+				goto dispatch;
 			}
 
 			old_pk = dtuple_create(heap, new_index->n_uniq);
@@ -2650,19 +2763,253 @@ row_log_table_apply_op(
 		}
 
 		ut_ad(next_mrec <= mrec_end);
-		log->head.total += next_mrec - mrec_start;
+		*total += next_mrec - mrec_start;
 		dtuple_set_n_fields_cmp(old_pk, new_index->n_uniq);
 
 		*error = row_log_table_apply_update(
 			thr, new_trx_id_col,
-			mrec, offsets, offsets_heap, heap, dup, old_pk);
+			mrec, offsets, *total, offsets_heap, heap, dup, old_pk);
 		break;
 	}
 
-	ut_ad(log->head.total <= log->tail.total);
+	ut_ad(*total <= log->tail.total);
 	mem_heap_empty(offsets_heap);
 	mem_heap_empty(heap);
 	return(next_mrec);
+
+dispatch:
+	/* The PRIMARY KEY is in the first fields of mrec, both in
+	the ROW_T_DELETE format of new_index and in the ROW_T_INSERT
+	and ROW_T_UPDATE format of the old table (same_pk). */
+	row_log_table_dispatch(workers, n_workers, mrec_start, *total,
+			       mrec, offsets, new_index->n_uniq);
+	*total += next_mrec - mrec_start;
+	return(next_mrec);
+}
+
+/** Apply the log records that were handed over to a worker.
+@param[in,out]	worker	row_log_table_apply_ops() worker
+@return DB_SUCCESS, or error code on failure */
+static
+dberr_t
+row_log_table_apply_tasks(row_log_table_worker_t* worker)
+{
+	trx_t*	trx = thr_get_trx(worker->thr);
+	dberr_t	error = DB_SUCCESS;
+
+	for (ulint i = 0; i < worker->tasks.size(); i++) {
+		if (my_atomic_load32_explicit(worker->aborted,
+					      MY_MEMORY_ORDER_RELAXED)) {
+			/* Another worker failed; it will report. */
+			break;
+		}
+
+		if (trx_is_interrupted(trx)) {
+			error = DB_INTERRUPTED;
+			break;
+		}
+
+		/* This read is not protected by log->mutex for
+		performance reasons. We will eventually notice any
+		error that was flagged by a DML thread. */
+		error = worker->dup.index->online_log->error;
+
+		if (error != DB_SUCCESS) {
+			break;
+		}
+
+		log_free_check();
+
+		ulonglong	total = worker->tasks[i].total;
+
+		if (!row_log_table_apply_op(
+			    worker->thr, worker->new_trx_id_col,
+			    &worker->dup, &error, worker->offsets_heap,
+			    worker->heap, worker->tasks[i].mrec,
+			    worker->mrec_end, worker->offsets, &total,
+			    NULL, 0)) {
+			/* The record was parsed successfully
+			by row_log_table_dispatch(). */
+			ut_ad(error != DB_SUCCESS);
+			if (error == DB_SUCCESS) {
+				error = DB_CORRUPTION;
+			}
+		}
+
+		if (error != DB_SUCCESS) {
+			break;
+		}
+	}
+
+	return(error);
+}
+
+/** Thread that applies a share of each block of the table-rebuild log,
+until row_log_table_stop_workers() is called.
+@param[in,out]	arg	row_log_table_worker_t
+@return OS_THREAD_DUMMY_RETURN */
+static
+os_thread_ret_t
+DECLARE_THREAD(row_log_table_apply_thread)(void* arg)
+{
+	row_log_table_worker_t*	worker
+		= static_cast<row_log_table_worker_t*>(arg);
+
+	for (;;) {
+		os_event_wait(worker->start);
+		os_event_reset(worker->start);
+
+		if (worker->exit) {
+			break;
+		}
+
+		worker->error = row_log_table_apply_tasks(worker);
+
+		if (worker->error != DB_SUCCESS) {
+			my_atomic_store32(worker->aborted, 1);
+		}
+
+		os_event_set(worker->done);
+	}
+
+	os_thread_exit(false);
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Apply the log records that were handed over to the workers,
+and wait for all of them to finish. The worker threads are created
+on the first call, and they are reused for the subsequent blocks.
+@param[in,out]	workers		row_log_table_apply_ops() workers
+@param[in]	n_workers	number of workers
+@return DB_SUCCESS, or error code on failure */
+static
+dberr_t
+row_log_table_apply_workers(
+	row_log_table_worker_t*	workers,
+	ulint			n_workers)
+{
+	*workers->aborted = 0;
+
+	for (ulint i = 1; i < n_workers; i++) {
+		row_log_table_worker_t&	worker = workers[i];
+
+		worker.error = DB_SUCCESS;
+
+		if (worker.tasks.empty()) {
+			continue;
+		}
+
+		if (!worker.start) {
+			worker.start = os_event_create(0);
+			worker.done = os_event_create(0);
+			worker.exit = false;
+			worker.thread = os_thread_create(
+				row_log_table_apply_thread, &worker, NULL);
+		}
+
+		os_event_reset(worker.done);
+		os_event_set(worker.start);
+	}
+
+	/* Apply the share of the first worker in this thread. */
+	workers->error = row_log_table_apply_tasks(workers);
+
+	if (workers->error != DB_SUCCESS) {
+		my_atomic_store32(workers->aborted, 1);
+	}
+
+	dberr_t	error = workers->error;
+
+	workers->tasks.clear();
+
+	for (ulint i = 1; i < n_workers; i++) {
+		if (!workers[i].tasks.empty()) {
+			os_event_wait(workers[i].done);
+			workers[i].tasks.clear();
+		}
+
+		if (error == DB_SUCCESS) {
+			error = workers[i].error;
+		}
+	}
+
+	if (error == DB_SUCCESS) {
+		srv_stats.n_rowlog_blocks_parallel.inc();
+	}
+
+	return(error);
+}
+
+/** Stop the threads that were created by row_log_table_apply_workers(),
+and add up the duplicate key counts of all workers.
+@param[in,out]	workers		row_log_table_apply_ops() workers
+@param[in]	n_workers	number of workers
+@param[in,out]	dup		for reporting duplicate key errors */
+static
+void
+row_log_table_stop_workers(
+	row_log_table_worker_t*	workers,
+	ulint			n_workers,
+	row_merge_dup_t*	dup)
+{
+	for (ulint i = 0; i < n_workers; i++) {
+		row_log_table_worker_t&	worker = workers[i];
+
+		dup->n_dup += worker.dup.n_dup;
+
+		if (worker.start) {
+			worker.exit = true;
+			os_event_set(worker.start);
+			os_thread_join(worker.thread);
+			os_event_destroy(worker.start);
+			os_event_destroy(worker.done);
+		}
+	}
+}
+
+/** Determine if the table-rebuild log can be applied by multiple threads.
+Operations on different rows can be applied in any order, unless they
+can conflict on a UNIQUE secondary index of the rebuilt table. The log
+records are partitioned by the binary PRIMARY KEY value, which must be
+unique for each row.
+@param[in]	index	clustered index of the table that is being rebuilt
+@return number of threads to apply full blocks of the log with
+@retval 0 if the log must be applied by a single thread */
+static
+ulint
+row_log_table_apply_n_threads(const dict_index_t* index)
+{
+	const row_log_t*	log = index->online_log;
+	const ulint		n_threads = srv_alter_log_apply_threads;
+
+	if (n_threads <= 1 || !log->same_pk
+	    || log->table->fts || dict_table_get_n_v_cols(log->table)) {
+		return(0);
+	}
+
+	for (const dict_index_t* i = dict_table_get_next_index(
+		     dict_table_get_first_index(log->table));
+	     i != NULL; i = dict_table_get_next_index(i)) {
+		if (dict_index_is_unique(i)) {
+			return(0);
+		}
+	}
+
+	for (ulint i = 0; i < index->n_uniq; i++) {
+		switch (dict_index_get_nth_col(index, i)->mtype) {
+		case DATA_INT:
+		case DATA_SYS:
+		case DATA_FIXBINARY:
+		case DATA_BINARY:
+			continue;
+		}
+
+		/* Values that compare equal could be encoded differently,
+		for example in a case-insensitive collation. */
+		return(0);
+	}
+
+	return(n_threads);
 }
 
 #ifdef HAVE_PSI_STAGE_INTERFACE
@@ -2754,6 +3101,9 @@ row_log_table_apply_ops(
 	const ulint	new_trx_id_col	= dict_col_get_clust_pos(
 		dict_table_get_sys_col(new_table, DATA_TRX_ID), new_index);
 	trx_t*		trx		= thr_get_trx(thr);
+	const ulint	n_workers	= row_log_table_apply_n_threads(index);
+	row_log_table_worker_t*	workers	= NULL;
+	int32		aborted		= 0;
 
 	ut_ad(dict_index_is_clust(index));
 	ut_ad(dict_index_is_online_ddl(index));
@@ -2776,6 +3126,28 @@ row_log_table_apply_ops(
 	offsets_heap = mem_heap_create(UNIV_PAGE_SIZE);
 	has_index_lock = true;
 
+	if (n_workers) {
+		workers = UT_NEW_ARRAY_NOKEY(row_log_table_worker_t,
+					     n_workers);
+
+		for (ulint w = 0; w < n_workers; w++) {
+			row_log_table_worker_t&	worker = workers[w];
+
+			worker.thr = thr;
+			worker.dup = *dup;
+			worker.dup.n_dup = 0;
+			worker.new_trx_id_col = new_trx_id_col;
+			worker.heap = mem_heap_create(UNIV_PAGE_SIZE);
+			worker.offsets_heap = mem_heap_create(UNIV_PAGE_SIZE);
+			worker.offsets = static_cast<ulint*>(
+				ut_malloc_nokey(i * sizeof *offsets));
+			worker.offsets[0] = i;
+			worker.offsets[1] = dict_index_get_n_fields(index);
+			worker.aborted = &aborted;
+			worker.start = NULL;
+		}
+	}
+
 next_block:
 	ut_ad(has_index_lock);
 	ut_ad(rw_lock_own(dict_index_get_lock(index), RW_LOCK_X));
@@ -2924,7 +3296,8 @@ row_log_table_apply_ops(
 			thr, new_trx_id_col,
 			dup, &error, offsets_heap, heap,
 			index->online_log->head.buf,
-			(&index->online_log->head.buf)[1], offsets);
+			(&index->online_log->head.buf)[1], offsets,
+			&index->online_log->head.total, NULL, 0);
 		if (error != DB_SUCCESS) {
 			goto func_exit;
 		} else if (UNIV_UNLIKELY(mrec == NULL)) {
@@ -2979,6 +3352,49 @@ row_log_table_apply_ops(
 
 	mrec_end = next_mrec_end;
 
+	if (workers && !has_index_lock) {
+		/* Hand over the complete records of this block to the
+		workers, and let them apply the records while other
+		threads can concurrently buffer modifications. */
+		ulonglong	total = index->online_log->head.total;
+
+		do {
+			mrec = next_mrec;
+			next_mrec = row_log_table_apply_op(
+				thr, new_trx_id_col,
+				dup, &error, offsets_heap, heap,
+				mrec, mrec_end, offsets,
+				&total, workers, n_workers);
+
+			if (error != DB_SUCCESS) {
+				goto func_exit;
+			}
+		} while (next_mrec != NULL && next_mrec != next_mrec_end);
+
+		for (ulint w = 0; w < n_workers; w++) {
+			workers[w].mrec_end = mrec_end;
+		}
+
+		error = row_log_table_apply_workers(workers, n_workers);
+
+		if (error != DB_SUCCESS) {
+			goto func_exit;
+		}
+
+		index->online_log->head.total = total;
+
+		if (next_mrec == next_mrec_end) {
+			mrec = NULL;
+		} else {
+			memcpy(index->online_log->head.buf, mrec,
+			       mrec_end - mrec);
+			mrec_end += index->online_log->head.buf - mrec;
+			mrec = index->online_log->head.buf;
+		}
+
+		goto process_next_block;
+	}
+
 	while (!trx_is_interrupted(trx)) {
 		mrec = next_mrec;
 		ut_ad(mrec < mrec_end);
@@ -3021,7 +3437,8 @@ row_log_table_apply_ops(
 		next_mrec = row_log_table_apply_op(
 			thr, new_trx_id_col,
 			dup, &error, offsets_heap, heap,
-			mrec, mrec_end, offsets);
+			mrec, mrec_end, offsets,
+			&index->online_log->head.total, NULL, 0);
 
 		if (error != DB_SUCCESS) {
 			goto func_exit;
@@ -3070,6 +3487,18 @@ row_log_table_apply_ops(
 		rw_lock_x_lock(dict_index_get_lock(index));
 	}
 
+	if (workers) {
+		row_log_table_stop_workers(workers, n_workers, dup);
+
+		for (ulint w = 0; w < n_workers; w++) {
+			mem_heap_free(workers[w].offsets_heap);
+			mem_heap_free(workers[w].heap);
+			ut_free(workers[w].offsets);
+		}
+
+		UT_DELETE_ARRAY(workers);
+	}
+
 	mem_heap_free(offsets_heap);
 	mem_heap_free(heap);
 	row_log_block_free(index->online_log->head);
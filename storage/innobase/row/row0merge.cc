@@ -68,213 +68,17 @@ float my_log2f(float n)
 /* Whether to disable file system cache */
 char	srv_disable_sort_file_cache;
 
-/** Class that caches index row tuples made from a single cluster
-index page scan, and then insert into corresponding index tree */
-class index_tuple_info_t {
-public:
-	/** constructor
-	@param[in]	heap	memory heap
-	@param[in]	index	index to be created */
-	index_tuple_info_t(
-		mem_heap_t*	heap,
-		dict_index_t*	index) UNIV_NOTHROW
-	{
-		m_heap = heap;
-		m_index = index;
-		m_dtuple_vec = UT_NEW_NOKEY(idx_tuple_vec());
-	}
-
-	/** destructor */
-	~index_tuple_info_t()
-	{
-		UT_DELETE(m_dtuple_vec);
-	}
-
-	/** Get the index object
-	@return the index object */
-	dict_index_t*   get_index() UNIV_NOTHROW
-	{
-		return(m_index);
-	}
-
-	/** Caches an index row into index tuple vector
-	@param[in]	row	table row
-	@param[in]	ext	externally stored column
-	prefixes, or NULL */
-	void add(
-		const dtuple_t*		row,
-		const row_ext_t*	ext) UNIV_NOTHROW
-	{
-		dtuple_t*	dtuple;
-
-		dtuple = row_build_index_entry(row, ext, m_index, m_heap);
-
-		ut_ad(dtuple);
-
-		m_dtuple_vec->push_back(dtuple);
-	}
-
-	/** Insert spatial index rows cached in vector into spatial index
-	@param[in]	trx_id		transaction id
-	@param[in,out]	row_heap	memory heap
-	@param[in]	pcur		cluster index scanning cursor
-	@param[in,out]	scan_mtr	mini-transaction for pcur
-	@param[out]	mtr_committed	whether scan_mtr got committed
-	@return DB_SUCCESS if successful, else error number */
-	dberr_t insert(
-		trx_id_t		trx_id,
-		mem_heap_t*		row_heap,
-		btr_pcur_t*		pcur,
-		mtr_t*			scan_mtr,
-		bool*			mtr_committed)
-	{
-		big_rec_t*      big_rec;
-		rec_t*          rec;
-		btr_cur_t       ins_cur;
-		mtr_t           mtr;
-		rtr_info_t      rtr_info;
-		ulint*		ins_offsets = NULL;
-		dberr_t		error = DB_SUCCESS;
-		dtuple_t*	dtuple;
-		ulint		count = 0;
-		const ulint	flag = BTR_NO_UNDO_LOG_FLAG
-				       | BTR_NO_LOCKING_FLAG
-				       | BTR_KEEP_SYS_FLAG | BTR_CREATE_FLAG;
-
-		ut_ad(dict_index_is_spatial(m_index));
-
-		DBUG_EXECUTE_IF("row_merge_instrument_log_check_flush",
-			log_sys->check_flush_or_checkpoint = true;
-		);
-
-		for (idx_tuple_vec::iterator it = m_dtuple_vec->begin();
-		     it != m_dtuple_vec->end();
-		     ++it) {
-			dtuple = *it;
-			ut_ad(dtuple);
-
-			if (log_sys->check_flush_or_checkpoint) {
-				if (!(*mtr_committed)) {
-					btr_pcur_move_to_prev_on_page(pcur);
-					btr_pcur_store_position(pcur, scan_mtr);
-					mtr_commit(scan_mtr);
-					*mtr_committed = true;
-				}
-
-				log_free_check();
-			}
-
-			mtr.start();
-			m_index->set_modified(mtr);
-
-			ins_cur.index = m_index;
-			rtr_init_rtr_info(&rtr_info, false, &ins_cur, m_index,
-					  false);
-			rtr_info_update_btr(&ins_cur, &rtr_info);
-
-			btr_cur_search_to_nth_level(m_index, 0, dtuple,
-						    PAGE_CUR_RTREE_INSERT,
-						    BTR_MODIFY_LEAF, &ins_cur,
-						    0, __FILE__, __LINE__,
-						    &mtr);
-
-			/* It need to update MBR in parent entry,
-			so change search mode to BTR_MODIFY_TREE */
-			if (rtr_info.mbr_adj) {
-				mtr_commit(&mtr);
-				rtr_clean_rtr_info(&rtr_info, true);
-				rtr_init_rtr_info(&rtr_info, false, &ins_cur,
-						  m_index, false);
-				rtr_info_update_btr(&ins_cur, &rtr_info);
-				mtr_start(&mtr);
-				m_index->set_modified(mtr);
-				btr_cur_search_to_nth_level(
-					m_index, 0, dtuple,
-					PAGE_CUR_RTREE_INSERT,
-					BTR_MODIFY_TREE, &ins_cur, 0,
-					__FILE__, __LINE__, &mtr);
-			}
-
-			error = btr_cur_optimistic_insert(
-				flag, &ins_cur, &ins_offsets, &row_heap,
-				dtuple, &rec, &big_rec, 0, NULL, &mtr);
-
-			if (error == DB_FAIL) {
-				ut_ad(!big_rec);
-				mtr.commit();
-				mtr.start();
-				m_index->set_modified(mtr);
-
-				rtr_clean_rtr_info(&rtr_info, true);
-				rtr_init_rtr_info(&rtr_info, false,
-						  &ins_cur, m_index, false);
-
-				rtr_info_update_btr(&ins_cur, &rtr_info);
-				btr_cur_search_to_nth_level(
-					m_index, 0, dtuple,
-					PAGE_CUR_RTREE_INSERT,
-					BTR_MODIFY_TREE,
-					&ins_cur, 0,
-					__FILE__, __LINE__, &mtr);
-
-
-				error = btr_cur_pessimistic_insert(
-						flag, &ins_cur, &ins_offsets,
-						&row_heap, dtuple, &rec,
-						&big_rec, 0, NULL, &mtr);
-			}
-
-			DBUG_EXECUTE_IF(
-				"row_merge_ins_spatial_fail",
-				error = DB_FAIL;
-			);
-
-			if (error == DB_SUCCESS) {
-				if (rtr_info.mbr_adj) {
-					error = rtr_ins_enlarge_mbr(
-							&ins_cur, NULL, &mtr);
-				}
-
-				if (error == DB_SUCCESS) {
-					page_update_max_trx_id(
-						btr_cur_get_block(&ins_cur),
-						btr_cur_get_page_zip(&ins_cur),
-						trx_id, &mtr);
-				}
-			}
-
-			mtr_commit(&mtr);
-
-			rtr_clean_rtr_info(&rtr_info, true);
-			count++;
-		}
-
-		m_dtuple_vec->clear();
-
-		return(error);
-	}
-
-private:
-	/** Cache index rows made from a cluster index scan. Usually
-	for rows on single cluster index page */
-	typedef std::vector<dtuple_t*, ut_allocator<dtuple_t*> >
-		idx_tuple_vec;
-
-	/** vector used to cache index rows made from cluster index scan */
-	idx_tuple_vec*		m_dtuple_vec;
-
-	/** the index being built */
-	dict_index_t*		m_index;
-
-	/** memory heap for creating index tuples */
-	mem_heap_t*		m_heap;
-};
+#ifdef UNIV_PFS_THREAD
+mysql_pfs_key_t	row_merge_pscan_thread_key;
+#endif /* UNIV_PFS_THREAD */
 
 /* Maximum pending doc memory limit in bytes for a fts tokenization thread */
 #define FTS_PENDING_DOC_MEMORY_LIMIT	1000000
 
 /** Insert sorted data tuples to the index.
 @param[in]	index		index to be inserted
+@param[in]	rec_index	index of the sorted records; the same as
+index, or the spatial sort index when index is a SPATIAL INDEX
 @param[in]	old_table	old table
 @param[in]	fd		file descriptor
 @param[in,out]	block		file buffer
@@ -289,6 +93,7 @@ static	MY_ATTRIBUTE((warn_unused_result))
 dberr_t
 row_merge_insert_index_tuples(
 	dict_index_t*		index,
+	const dict_index_t*	rec_index,
 	const dict_table_t*	old_table,
 	int			fd,
 	row_merge_block_t*	block,
@@ -851,6 +656,200 @@ row_merge_buf_add(
 	DBUG_RETURN(n_row_added);
 }
 
+/** Size of the Hilbert curve key in the records of a spatial sort index */
+#define ROW_MERGE_HILBERT_KEY_LEN	8
+
+/** Create a temporary index for sorting the entries of a SPATIAL INDEX
+along a Hilbert curve. The first field is the Hilbert curve key of the
+centre of the MBR, followed by the fields of the spatial index. The MBR
+is only compared as a binary string.
+@param[in]	index	spatial index to be created
+@return sort index */
+static
+dict_index_t*
+row_merge_create_spatial_sort_index(
+	const dict_index_t*	index)
+{
+	const ulint	n_fields = dict_index_get_n_fields(index);
+	dict_index_t*	new_index;
+	dict_field_t*	field;
+
+	ut_ad(dict_index_is_spatial(index));
+
+	new_index = dict_mem_index_create(
+		index->table, "tmp_spatial_idx", 0, n_fields + 1);
+
+	new_index->id = index->id;
+	new_index->n_uniq = unsigned(n_fields + 1);
+	new_index->n_def = unsigned(n_fields + 1);
+	new_index->n_nullable = index->n_nullable;
+	new_index->n_core_null_bytes = index->n_core_null_bytes;
+	new_index->cached = TRUE;
+
+	/* The Hilbert curve key */
+	field = dict_index_get_nth_field(new_index, 0);
+	field->name = NULL;
+	field->prefix_len = 0;
+	field->fixed_len = ROW_MERGE_HILBERT_KEY_LEN;
+	field->col = static_cast<dict_col_t*>(
+		mem_heap_zalloc(new_index->heap, sizeof(dict_col_t)));
+	field->col->mtype = DATA_FIXBINARY;
+	field->col->prtype = DATA_NOT_NULL | DATA_BINARY_TYPE;
+	field->col->len = ROW_MERGE_HILBERT_KEY_LEN;
+
+	/* The MBR */
+	field = dict_index_get_nth_field(new_index, 1);
+	*field = *dict_index_get_nth_field(index, 0);
+	field->name = NULL;
+	field->fixed_len = DATA_MBR_LEN;
+	field->col = static_cast<dict_col_t*>(
+		mem_heap_zalloc(new_index->heap, sizeof(dict_col_t)));
+	field->col->mtype = DATA_FIXBINARY;
+	field->col->prtype = DATA_NOT_NULL | DATA_BINARY_TYPE;
+	field->col->len = DATA_MBR_LEN;
+
+	/* The PRIMARY KEY */
+	for (ulint i = 1; i < n_fields; i++) {
+		*++field = *dict_index_get_nth_field(index, i);
+	}
+
+	return(new_index);
+}
+
+/** Map a coordinate to an unsigned integer of the same order.
+@param[in]	d	coordinate
+@return the most significant 32 bits of the order-preserving image */
+static inline
+uint32_t
+row_merge_hilbert_coord(
+	double	d)
+{
+	uint64_t	u;
+
+	memcpy(&u, &d, sizeof u);
+
+	/* Flip all bits of negative numbers, and the sign bit of
+	positive numbers. */
+	u ^= (u >> 63) ? ~uint64_t(0) : uint64_t(1) << 63;
+
+	return(uint32_t(u >> 32));
+}
+
+/** Compute the distance of the centre of an MBR along a Hilbert curve
+that fills the plane of order-preserving coordinate images. Entries that
+are close on the curve are close in space, so that consecutive entries
+fill the R-tree leaf pages with small MBRs.
+@param[in]	mbr	MBR in the format of the spatial index field
+@return Hilbert curve distance */
+static
+uint64_t
+row_merge_hilbert_key(
+	const byte*	mbr)
+{
+	/* The MBR is stored as xmin, xmax, ymin, ymax. */
+	uint32_t	x = row_merge_hilbert_coord(
+		mach_double_read(mbr) / 2
+		+ mach_double_read(mbr + sizeof(double)) / 2);
+	uint32_t	y = row_merge_hilbert_coord(
+		mach_double_read(mbr + 2 * sizeof(double)) / 2
+		+ mach_double_read(mbr + 3 * sizeof(double)) / 2);
+	uint64_t	d = 0;
+
+	for (uint32_t s = 1U << 31; s; s >>= 1) {
+		const uint32_t	rx = (x & s) != 0;
+		const uint32_t	ry = (y & s) != 0;
+
+		d += uint64_t(s) * s * ((3 * rx) ^ ry);
+
+		/* Rotate the quadrant. */
+		if (!ry) {
+			if (rx) {
+				x = ~x;
+				y = ~y;
+			}
+
+			std::swap(x, y);
+		}
+	}
+
+	return(d);
+}
+
+/** Insert an entry of a SPATIAL INDEX into the sort buffer of its
+spatial sort index, prefixed with the Hilbert curve key of the MBR.
+@param[in,out]	buf		sort buffer
+@param[in]	index		spatial index to be created
+@param[in]	row		table row
+@param[in]	ext		cache of externally stored
+				column prefixes, or NULL
+@return number of rows added, 0 if out of space */
+static
+ulint
+row_merge_buf_add_spatial(
+	row_merge_buf_t*	buf,
+	dict_index_t*		index,
+	const dtuple_t*		row,
+	const row_ext_t*	ext)
+{
+	ut_ad(dict_index_is_spatial(index));
+	ut_ad(dict_index_get_n_fields(buf->index)
+	      == dict_index_get_n_fields(index) + 1);
+
+	if (buf->n_tuples >= buf->max_tuples) {
+		return(0);
+	}
+
+	const dtuple_t*	entry = row_build_index_entry(
+		row, ext, index, buf->heap);
+	ut_ad(entry);
+
+	const ulint	n_fields = dtuple_get_n_fields(entry) + 1;
+	dfield_t*	fields = static_cast<dfield_t*>(
+		mem_heap_alloc(buf->heap, n_fields * sizeof *fields));
+	byte*		key = static_cast<byte*>(
+		mem_heap_alloc(buf->heap, ROW_MERGE_HILBERT_KEY_LEN));
+	const dfield_t*	mbr = dtuple_get_nth_field(entry, 0);
+
+	ut_ad(dfield_get_len(mbr) == DATA_MBR_LEN);
+
+	mach_write_to_8(key, row_merge_hilbert_key(
+				static_cast<const byte*>(
+					dfield_get_data(mbr))));
+
+	dfield_set_data(&fields[0], key, ROW_MERGE_HILBERT_KEY_LEN);
+	memcpy(&fields[1], entry->fields, (n_fields - 1) * sizeof *fields);
+
+	for (ulint i = 0; i < 2; i++) {
+		dict_col_copy_type(dict_index_get_nth_col(buf->index, i),
+				   dfield_get_type(&fields[i]));
+	}
+
+	ulint	extra_size;
+	ulint	data_size = rec_get_converted_size_temp(
+		buf->index, fields, n_fields, &extra_size);
+
+	/* Add the encoded length of extra_size, as in
+	row_merge_buf_add(). */
+	data_size += (extra_size + 1) + ((extra_size + 1) >= 0x80);
+
+	ut_ad(data_size < srv_sort_buf_size);
+
+	/* Reserve bytes for the end marker of row_merge_block_t. */
+	if (buf->total_size + data_size >= srv_sort_buf_size) {
+		return(0);
+	}
+
+	/* The key and the MBR were allocated from buf->heap already. */
+	for (ulint i = 2; i < n_fields; i++) {
+		dfield_dup(&fields[i], buf->heap);
+	}
+
+	buf->tuples[buf->n_tuples++].fields = fields;
+	buf->total_size += data_size;
+
+	return(1);
+}
+
 /*************************************************************//**
 Report a duplicate key. */
 void
@@ -859,7 +858,7 @@ row_merge_dup_report(
 	row_merge_dup_t*	dup,	/*!< in/out: for reporting duplicates */
 	const dfield_t*		entry)	/*!< in: duplicate index entry */
 {
-	if (!dup->n_dup++) {
+	if (!dup->n_dup++ && dup->table) {
 		/* Only report the first duplicate record,
 		but count all duplicate records. */
 		innobase_fields_to_mysql(dup->table, dup->index, entry);
@@ -1568,51 +1567,6 @@ row_mtuple_cmp(
 		       n_unique, n_unique, *current_mtuple, *prev_mtuple, dup));
 }
 
-/** Insert cached spatial index rows.
-@param[in]	trx_id		transaction id
-@param[in]	sp_tuples	cached spatial rows
-@param[in]	num_spatial	number of spatial indexes
-@param[in,out]	row_heap	heap for insert
-@param[in,out]	sp_heap		heap for tuples
-@param[in,out]	pcur		cluster index cursor
-@param[in,out]	mtr		mini transaction
-@param[in,out]	mtr_committed	whether scan_mtr got committed
-@return DB_SUCCESS or error number */
-static
-dberr_t
-row_merge_spatial_rows(
-	trx_id_t		trx_id,
-	index_tuple_info_t**	sp_tuples,
-	ulint			num_spatial,
-	mem_heap_t*		row_heap,
-	mem_heap_t*		sp_heap,
-	btr_pcur_t*		pcur,
-	mtr_t*			mtr,
-	bool*			mtr_committed)
-{
-	dberr_t			err = DB_SUCCESS;
-
-	if (sp_tuples == NULL) {
-		return(DB_SUCCESS);
-	}
-
-	ut_ad(sp_heap != NULL);
-
-	for (ulint j = 0; j < num_spatial; j++) {
-		err = sp_tuples[j]->insert(
-			trx_id, row_heap,
-			pcur, mtr, mtr_committed);
-
-		if (err != DB_SUCCESS) {
-			return(err);
-		}
-	}
-
-	mem_heap_empty(sp_heap);
-
-	return(err);
-}
-
 /** Check if the geometry field is valid.
 @param[in]	row		the row
 @param[in]	index		spatial index
@@ -1640,6 +1594,565 @@ row_geo_field_is_valid(
 	return(true);
 }
 
+/** Divide the clustered index into key ranges for a parallel scan.
+The boundaries are node pointer records of the highest non-leaf level
+that has enough records to choose from.
+@param[in]	index	clustered index
+@param[in]	n	maximum number of ranges
+@param[out]	bounds	bounds[1..n-1] will be the smallest keys of
+			the ranges after the first one
+@param[in,out]	heap	memory heap for the bounds
+@return number of ranges, between 1 and n */
+static
+ulint
+row_merge_scan_partition(
+	dict_index_t*		index,
+	ulint			n,
+	const dtuple_t**	bounds,
+	mem_heap_t*		heap)
+{
+	mtr_t		mtr;
+	mem_heap_t*	offsets_heap	= NULL;
+	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*		offsets		= offsets_;
+	ulint		n_ranges	= 1;
+	rec_offs_init(offsets_);
+
+	mtr.start();
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	buf_block_t*	block = btr_root_block_get(index, RW_S_LATCH, &mtr);
+
+	if (block == NULL) {
+		goto func_exit;
+	}
+
+	{
+		const page_size_t	page_size(index->table->space->flags);
+		const ulint		space_id = index->table->space->id;
+		ulint			level = btr_page_get_level(
+			buf_block_get_frame(block));
+		ulint			n_recs = page_get_n_recs(
+			buf_block_get_frame(block));
+
+		if (level == 0) {
+			goto func_exit;
+		}
+
+		/* Descend along the leftmost path until the level holds
+		enough node pointers to pick evenly spaced boundaries.
+		The index lock prevents any changes to the non-leaf
+		levels meanwhile. */
+		while (level > 1 && n_recs < n * 8) {
+			const rec_t*	node_ptr = page_rec_get_next(
+				page_get_infimum_rec(
+					buf_block_get_frame(block)));
+
+			offsets = rec_get_offsets(node_ptr, index, offsets,
+						  false, ULINT_UNDEFINED,
+						  &offsets_heap);
+			block = btr_block_get(
+				page_id_t(space_id,
+					  btr_node_ptr_get_child_page_no(
+						  node_ptr, offsets)),
+				page_size, RW_S_LATCH, index, &mtr);
+			level--;
+			n_recs = 0;
+
+			for (buf_block_t* b = block; b != NULL; ) {
+				n_recs += page_get_n_recs(
+					buf_block_get_frame(b));
+
+				ulint	next = btr_page_get_next(
+					buf_block_get_frame(b), &mtr);
+
+				if (next == FIL_NULL) {
+					break;
+				}
+
+				b = btr_block_get(page_id_t(space_id, next),
+						  page_size, RW_S_LATCH,
+						  index, &mtr);
+			}
+		}
+
+		if (n_recs < 2) {
+			goto func_exit;
+		}
+
+		n_ranges = std::min(n, n_recs);
+
+		/* The first node pointer of the level is skipped, because
+		it carries REC_INFO_MIN_REC_FLAG instead of a usable key. */
+		ulint	r = 0;
+		ulint	j = 1;
+
+		for (buf_block_t* b = block; j < n_ranges; ) {
+			for (const rec_t* rec = page_rec_get_next(
+				     page_get_infimum_rec(
+					     buf_block_get_frame(b)));
+			     !page_rec_is_supremum(rec) && j < n_ranges;
+			     rec = page_rec_get_next_const(rec), r++) {
+				if (r == j * n_recs / n_ranges) {
+					bounds[j++] = dict_index_build_data_tuple(
+						rec, index, false,
+						dict_index_get_n_unique_in_tree(
+							index),
+						heap);
+				}
+			}
+
+			ulint	next = btr_page_get_next(
+				buf_block_get_frame(b), &mtr);
+
+			if (j == n_ranges || next == FIL_NULL) {
+				break;
+			}
+
+			b = btr_block_get(page_id_t(space_id, next),
+					  page_size, RW_S_LATCH, index, &mtr);
+		}
+
+		ut_ad(j == n_ranges);
+	}
+
+func_exit:
+	mtr.commit();
+
+	if (UNIV_LIKELY_NULL(offsets_heap)) {
+		mem_heap_free(offsets_heap);
+	}
+
+	return(n_ranges);
+}
+
+/** Shared state of a parallel clustered index scan */
+struct row_merge_pscan_t {
+	/** ALTER TABLE transaction */
+	trx_t*			trx;
+	/** table whose secondary indexes are being created */
+	const dict_table_t*	table;
+	/** indexes to be created */
+	dict_index_t**		index;
+	/** temporary files for index[] */
+	merge_file_t*		files;
+	/** number of indexes to create */
+	ulint			n_index;
+	/** whether the indexes are being created online */
+	bool			online;
+	/** nonzero if a range scan failed and the others should stop */
+	int32			aborted;
+};
+
+/** A key range of a parallel clustered index scan */
+struct row_merge_pscan_range_t {
+	/** the scan that this range belongs to */
+	row_merge_pscan_t*	pscan;
+	/** smallest key in the range, or NULL for the start of the index */
+	const dtuple_t*		low;
+	/** smallest key after the range, or NULL for the end of the index */
+	const dtuple_t*		high;
+	/** thread handle */
+	os_thread_t		thread;
+	/** outcome of the range scan */
+	dberr_t			err;
+	/** position of the failed index in pscan->index[] */
+	ulint			err_index;
+};
+
+/** Sort a full merge buffer of a parallel scan and append it to the
+temporary file of the index as a sorted run.
+@param[in,out]	pscan		parallel scan
+@param[in]	i		position of the index in pscan->index[]
+@param[in,out]	buf		merge buffer
+@param[in,out]	block		file buffer
+@param[in,out]	crypt_block	encrypted file buffer, or NULL
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_pscan_write(
+	row_merge_pscan_t*	pscan,
+	ulint			i,
+	row_merge_buf_t*	buf,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block)
+{
+	merge_file_t*	file = &pscan->files[i];
+
+	if (dict_index_is_unique(buf->index)) {
+		/* The MySQL table object cannot be shared between the
+		scan threads. The caller will rescan the table serially
+		in order to report the duplicate. */
+		row_merge_dup_t	dup = {buf->index, NULL, NULL, 0};
+
+		row_merge_buf_sort(buf, &dup);
+
+		if (dup.n_dup) {
+			return(DB_DUPLICATE_KEY);
+		}
+	} else {
+		row_merge_buf_sort(buf, NULL);
+	}
+
+	row_merge_buf_write(buf, file, block);
+
+	if (!row_merge_write(file->fd, my_atomic_addlint(&file->offset, 1),
+			     block, crypt_block, pscan->table->space->id)) {
+		return(DB_TEMP_FILE_WRITE_FAIL);
+	}
+
+	my_atomic_addlint(&file->n_rec, buf->n_tuples);
+
+	UNIV_MEM_INVALID(&block[0], srv_sort_buf_size);
+	return(DB_SUCCESS);
+}
+
+/** Scan a key range of the clustered index, and write sorted runs of
+the secondary index entries to the temporary files.
+@param[in,out]	range	key range
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_pscan_range(
+	row_merge_pscan_range_t*	range)
+{
+	row_merge_pscan_t*	pscan		= range->pscan;
+	trx_t*			trx		= pscan->trx;
+	const dict_table_t*	table		= pscan->table;
+	dict_index_t*		clust_index	= dict_table_get_first_index(
+		table);
+	const ulint		n_index		= pscan->n_index;
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	ut_new_pfx_t		block_pfx;
+	ut_new_pfx_t		crypt_pfx;
+	row_merge_block_t*	block;
+	row_merge_block_t*	crypt_block	= NULL;
+	mem_heap_t*		v_heap		= NULL;
+	doc_id_t		doc_id		= 0;
+	btr_pcur_t		pcur;
+	mtr_t			mtr;
+	dberr_t			err		= DB_SUCCESS;
+
+	block = alloc.allocate_large(srv_sort_buf_size, &block_pfx);
+
+	if (block == NULL) {
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	if (log_tmp_is_encrypted()) {
+		crypt_block = alloc.allocate_large(srv_sort_buf_size,
+						   &crypt_pfx);
+
+		if (crypt_block == NULL) {
+			alloc.deallocate_large(block, &block_pfx,
+					       srv_sort_buf_size);
+			return(DB_OUT_OF_MEMORY);
+		}
+	}
+
+	row_merge_buf_t**	merge_buf = static_cast<row_merge_buf_t**>(
+		ut_malloc_nokey(n_index * sizeof *merge_buf));
+
+	for (ulint i = 0; i < n_index; i++) {
+		merge_buf[i] = row_merge_buf_create(pscan->index[i]);
+	}
+
+	mem_heap_t*	row_heap = mem_heap_create(sizeof(mrec_buf_t));
+
+	mtr.start();
+
+	if (range->low == NULL) {
+		btr_pcur_open_at_index_side(
+			true, clust_index, BTR_SEARCH_LEAF, &pcur, true, 0,
+			&mtr);
+	} else {
+		/* Position the cursor before the first record of the
+		range. */
+		btr_pcur_open(clust_index, range->low, PAGE_CUR_L,
+			      BTR_SEARCH_LEAF, &pcur, &mtr);
+	}
+
+	while (!my_atomic_load32_explicit(&pscan->aborted,
+					  MY_MEMORY_ORDER_RELAXED)) {
+		if (btr_pcur_is_on_user_rec(&pcur)
+		    && page_rec_is_supremum(page_rec_get_next(
+						    btr_pcur_get_rec(&pcur)))) {
+			/* We are about to move to the next page. */
+			if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
+				err = DB_INTERRUPTED;
+				break;
+			}
+
+			if (my_atomic_load32_explicit(
+				    &clust_index->lock.waiters,
+				    MY_MEMORY_ORDER_RELAXED)) {
+				/* Let the waiters on the clustered index
+				tree lock proceed, like the serial scan in
+				row_merge_read_clustered_index() does. */
+				btr_pcur_store_position(&pcur, &mtr);
+				mtr.commit();
+				os_thread_yield();
+				mtr.start();
+				/* The restored position is on the last
+				record that we processed or, if it was
+				purged meanwhile, on its predecessor. */
+				btr_pcur_restore_position(
+					BTR_SEARCH_LEAF, &pcur, &mtr);
+			}
+		}
+
+		if (!btr_pcur_move_to_next_user_rec(&pcur, &mtr)) {
+			break;
+		}
+
+		const rec_t*	rec = btr_pcur_get_rec(&pcur);
+
+		if (rec_is_default_row(rec, clust_index)) {
+			ut_ad(range->low == NULL);
+			continue;
+		}
+
+		mem_heap_empty(row_heap);
+
+		ulint*	offsets = rec_get_offsets(
+			rec, clust_index, NULL, true, ULINT_UNDEFINED,
+			&row_heap);
+
+		if (range->high != NULL
+		    && cmp_dtuple_rec(range->high, rec, offsets) <= 0) {
+			break;
+		}
+
+		/* See the comments in row_merge_read_clustered_index()
+		on the visibility of the records. */
+		if (pscan->online) {
+			if (!trx->read_view.changes_visible(
+				    row_get_rec_trx_id(rec, clust_index,
+						       offsets),
+				    table->name)) {
+				rec_t*	old_vers;
+
+				row_vers_build_for_consistent_read(
+					rec, &mtr, clust_index, &offsets,
+					&trx->read_view, &row_heap,
+					row_heap, &old_vers, NULL);
+
+				if (!old_vers) {
+					continue;
+				}
+
+				rec = old_vers;
+			}
+		}
+
+		if (rec_get_deleted_flag(rec, dict_table_is_comp(table))) {
+			continue;
+		}
+
+		row_ext_t*	ext;
+		const dtuple_t*	row = row_build(
+			ROW_COPY_POINTERS, clust_index, rec, offsets,
+			table, NULL, NULL, &ext, row_heap);
+
+		for (ulint i = 0; i < n_index; i++) {
+			row_merge_buf_t*	buf = merge_buf[i];
+
+			if (!row_merge_buf_add(buf, NULL, table, table, NULL,
+					       row, ext, &doc_id, NULL, &err,
+					       &v_heap, NULL, trx)
+			    && err == DB_SUCCESS) {
+				/* The buffer is full. Write it out and
+				try again. */
+				err = row_merge_pscan_write(
+					pscan, i, buf, block, crypt_block);
+
+				if (err == DB_SUCCESS
+				    && !row_merge_buf_add(
+					    merge_buf[i]
+					    = row_merge_buf_empty(buf),
+					    NULL, table, table, NULL,
+					    row, ext, &doc_id, NULL,
+					    &err, &v_heap, NULL, trx)) {
+					/* An empty buffer should have
+					enough room for at least one
+					record. */
+					ut_error;
+				}
+			}
+
+			if (err != DB_SUCCESS) {
+				range->err_index = i;
+				goto func_exit;
+			}
+		}
+	}
+
+	for (ulint i = 0; i < n_index && err == DB_SUCCESS; i++) {
+		if (merge_buf[i]->n_tuples) {
+			err = row_merge_pscan_write(pscan, i, merge_buf[i],
+						    block, crypt_block);
+			range->err_index = i;
+		}
+	}
+
+func_exit:
+	mtr.commit();
+	btr_pcur_close(&pcur);
+	mem_heap_free(row_heap);
+
+	if (v_heap) {
+		mem_heap_free(v_heap);
+	}
+
+	for (ulint i = 0; i < n_index; i++) {
+		row_merge_buf_free(merge_buf[i]);
+	}
+
+	ut_free(merge_buf);
+
+	alloc.deallocate_large(block, &block_pfx, srv_sort_buf_size);
+
+	if (crypt_block != NULL) {
+		alloc.deallocate_large(crypt_block, &crypt_pfx,
+				       srv_sort_buf_size);
+	}
+
+	return(err);
+}
+
+/** Thread for scanning a key range of the clustered index.
+@param[in,out]	arg	row_merge_pscan_range_t
+@return OS_THREAD_DUMMY_RETURN */
+static
+os_thread_ret_t
+DECLARE_THREAD(row_merge_pscan_thread)(
+	void*	arg)
+{
+	row_merge_pscan_range_t*	range
+		= static_cast<row_merge_pscan_range_t*>(arg);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(row_merge_pscan_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	range->err = row_merge_pscan_range(range);
+
+	if (range->err != DB_SUCCESS) {
+		my_atomic_store32(&range->pscan->aborted, 1);
+	}
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Scan the clustered index in key ranges using multiple threads, and
+write sorted runs of the entries of the secondary indexes to be created
+to the temporary files. This is only used when no table rebuild,
+full-text, spatial or virtual column index is involved, so that all
+the work per record can be done without the MySQL table object.
+@param[in]	trx		transaction
+@param[in]	table		table whose secondary indexes are created
+@param[in]	online		true if creating indexes online
+@param[in]	index		indexes to be created
+@param[in,out]	files		temporary files
+@param[in]	key_numbers	MySQL key numbers to create
+@param[in]	n_index		number of indexes to create
+@param[in]	n_ranges	number of key ranges
+@param[in]	bounds		key range boundaries, from
+row_merge_scan_partition()
+@param[in,out]	tmpfd		temporary file handle
+@return DB_SUCCESS or error code
+@retval DB_DUPLICATE_KEY if a duplicate was found within a run; the
+table must be rescanned serially in order to report it */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_pscan(
+	trx_t*			trx,
+	const dict_table_t*	table,
+	bool			online,
+	dict_index_t**		index,
+	merge_file_t*		files,
+	const ulint*		key_numbers,
+	ulint			n_index,
+	ulint			n_ranges,
+	const dtuple_t**	bounds,
+	int*			tmpfd)
+{
+	const char*	path	= thd_innodb_tmpdir(trx->mysql_thd);
+	dberr_t		err	= DB_SUCCESS;
+
+	for (ulint i = 0; i < n_index; i++) {
+		if (row_merge_file_create_if_needed(
+			    &files[i], tmpfd, 0, path) < 0) {
+			trx->error_key_num = i;
+			return(DB_OUT_OF_MEMORY);
+		}
+	}
+
+	row_merge_pscan_t	pscan = {
+		trx, table, index, files, n_index, online, 0};
+
+	row_merge_pscan_range_t*	ranges
+		= static_cast<row_merge_pscan_range_t*>(
+			ut_malloc_nokey(n_ranges * sizeof *ranges));
+
+	for (ulint r = 0; r < n_ranges; r++) {
+		ranges[r].pscan = &pscan;
+		ranges[r].low = bounds[r];
+		ranges[r].high = r + 1 < n_ranges ? bounds[r + 1] : NULL;
+		ranges[r].err = DB_SUCCESS;
+		ranges[r].err_index = 0;
+		ranges[r].thread = os_thread_create(
+			row_merge_pscan_thread, &ranges[r], NULL);
+	}
+
+	for (ulint r = 0; r < n_ranges; r++) {
+		os_thread_join(ranges[r].thread);
+
+		if (err == DB_SUCCESS && ranges[r].err != DB_SUCCESS) {
+			err = ranges[r].err;
+			trx->error_key_num = err == DB_DUPLICATE_KEY
+				? key_numbers[ranges[r].err_index]
+				: ranges[r].err_index;
+		}
+	}
+
+	ut_free(ranges);
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
+	for (ulint i = 0; i < n_index; i++) {
+		if (online) {
+			/* Note the newest transaction that modified this
+			index when the scan was completed. We prevent
+			older readers from accessing this index, to ensure
+			read consistency. */
+			rw_lock_x_lock(dict_index_get_lock(index[i]));
+			ut_a(dict_index_get_online_status(index[i])
+			     == ONLINE_INDEX_CREATION);
+
+			trx_id_t	max_trx_id = row_log_get_max_trx(
+				index[i]);
+
+			if (max_trx_id > index[i]->trx_id) {
+				index[i]->trx_id = max_trx_id;
+			}
+
+			rw_lock_x_unlock(dict_index_get_lock(index[i]));
+		}
+
+		if (!files[i].offset) {
+			/* No records were found. Skip the merge sort. */
+			row_merge_file_destroy(&files[i]);
+		}
+	}
+
+	return(DB_SUCCESS);
+}
+
 /** Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
 @param[in]	trx		transaction
@@ -1653,6 +2166,8 @@ containing the index entries for the indexes to be built.
 @param[in]	fts_sort_idx	full-text index to be created, or NULL
 @param[in]	psort_info	parallel sort info for fts_sort_idx creation,
 				or NULL
+@param[in]	sp_sort_idx	spatial sort indexes for the SPATIAL
+				INDEX in index[], or NULL if there are none
 @param[in]	files		temporary files
 @param[in]	key_numbers	MySQL key numbers to create
 @param[in]	n_index		number of indexes to create
@@ -1686,6 +2201,7 @@ row_merge_read_clustered_index(
 	dict_index_t**		index,
 	dict_index_t*		fts_sort_idx,
 	fts_psort_t*		psort_info,
+	dict_index_t**		sp_sort_idx,
 	merge_file_t*		files,
 	const ulint*		key_numbers,
 	ulint			n_index,
@@ -1723,9 +2239,6 @@ row_merge_read_clustered_index(
 	os_event_t		fts_parallel_sort_event = NULL;
 	ibool			fts_pll_sort = FALSE;
 	int64_t			sig_count = 0;
-	index_tuple_info_t**	sp_tuples = NULL;
-	mem_heap_t*		sp_heap = NULL;
-	ulint			num_spatial = 0;
 	BtrBulk*		clust_btr_bulk = NULL;
 	bool			clust_temp_file = false;
 	mem_heap_t*		mtuple_heap = NULL;
@@ -1755,6 +2268,57 @@ row_merge_read_clustered_index(
 
 	trx->op_info = "reading clustered index";
 
+	if (srv_alter_scan_threads > 1 && old_table == new_table
+	    && !fts_sort_idx && !drop_historical) {
+		const ulint	n_threads = srv_alter_scan_threads;
+		bool		parallel = true;
+
+		/* Only plain secondary indexes can be built without
+		accessing the MySQL table object. */
+		for (ulint i = 0; parallel && i < n_index; i++) {
+			parallel = !(index[i]->type & (DICT_FTS | DICT_SPATIAL))
+				&& !dict_index_has_virtual(index[i]);
+		}
+
+		if (parallel) {
+			mem_heap_t*		heap = mem_heap_create(1024);
+			const dtuple_t**	bounds
+				= static_cast<const dtuple_t**>(
+					mem_heap_zalloc(
+						heap,
+						n_threads * sizeof *bounds));
+			const ulint		n_ranges
+				= row_merge_scan_partition(
+					dict_table_get_first_index(old_table),
+					n_threads, bounds, heap);
+
+			if (n_ranges > 1) {
+				err = row_merge_pscan(
+					trx, old_table, online, index, files,
+					key_numbers, n_index, n_ranges, bounds,
+					tmpfd);
+			}
+
+			mem_heap_free(heap);
+
+			if (n_ranges > 1 && err != DB_DUPLICATE_KEY) {
+				onlineddl_pct_progress = ulint(pct_cost * 100);
+				trx->op_info = "";
+				DBUG_RETURN(err);
+			}
+
+			/* Fall back to the serial scan, either because the
+			table is too small to be partitioned, or in order to
+			report a duplicate key. */
+			for (ulint i = 0; i < n_index; i++) {
+				files[i].offset = 0;
+				files[i].n_rec = 0;
+			}
+
+			err = DB_SUCCESS;
+		}
+	}
+
 #ifdef FTS_INTERNAL_DIAG_PRINT
 	DEBUG_FTS_SORT_PRINT("FTS_SORT: Start Create Index\n");
 #endif
@@ -1803,38 +2367,18 @@ row_merge_read_clustered_index(
 			row_fts_start_psort(psort_info);
 			fts_parallel_sort_event =
 				 psort_info[0].psort_common->sort_event;
-		} else {
-			if (dict_index_is_spatial(index[i])) {
-				num_spatial++;
-			}
+		} else if (dict_index_is_spatial(index[i])) {
+			/* The entries of a SPATIAL INDEX are sorted
+			along a Hilbert curve and bulk loaded. */
+			ut_a(sp_sort_idx);
+			ut_a(sp_sort_idx[i]);
 
+			merge_buf[i] = row_merge_buf_create(sp_sort_idx[i]);
+		} else {
 			merge_buf[i] = row_merge_buf_create(index[i]);
 		}
 	}
 
-	if (num_spatial > 0) {
-		ulint	count = 0;
-
-		sp_heap = mem_heap_create(512);
-
-		sp_tuples = static_cast<index_tuple_info_t**>(
-			ut_malloc_nokey(num_spatial
-					* sizeof(*sp_tuples)));
-
-		for (ulint i = 0; i < n_index; i++) {
-			if (dict_index_is_spatial(index[i])) {
-				sp_tuples[count]
-					= UT_NEW_NOKEY(
-						index_tuple_info_t(
-							sp_heap,
-							index[i]));
-				count++;
-			}
-		}
-
-		ut_ad(count == num_spatial);
-	}
-
 	mtr_start(&mtr);
 
 	/* Find the clustered index and create a persistent cursor
@@ -1968,22 +2512,6 @@ row_merge_read_clustered_index(
 				"ib_purge_on_create_index_page_switch",
 				dbug_run_purge = true;);
 
-			/* Insert the cached spatial index rows. */
-			bool	mtr_committed = false;
-
-			err = row_merge_spatial_rows(
-				trx->id, sp_tuples, num_spatial,
-				row_heap, sp_heap, &pcur,
-				&mtr, &mtr_committed);
-
-			if (err != DB_SUCCESS) {
-				goto func_exit;
-			}
-
-			if (mtr_committed) {
-				goto scan_next;
-			}
-
 			if (dbug_run_purge
 			    || my_atomic_load32_explicit(&clust_index->lock.waiters,
 							 MY_MEMORY_ORDER_RELAXED)) {
@@ -2021,7 +2549,6 @@ row_merge_read_clustered_index(
 
 				/* Give the waiters a chance to proceed. */
 				os_thread_yield();
-scan_next:
 				mtr_start(&mtr);
 				/* Restore position on the record, or its
 				predecessor if the record was purged
@@ -2331,7 +2858,6 @@ row_merge_read_clustered_index(
 		/* Build all entries for all the indexes to be created
 		in a single scan of the clustered index. */
 
-		ulint	s_idx_cnt = 0;
 		bool	skip_sort = skip_pk_sort
 			&& dict_index_is_clust(merge_buf[0]->index);
 
@@ -2340,25 +2866,11 @@ row_merge_read_clustered_index(
 			merge_file_t*		file	= &files[i];
 			ulint			rows_added = 0;
 
-			if (dict_index_is_spatial(buf->index)) {
-				if (!row) {
-					continue;
-				}
-
-				ut_ad(sp_tuples[s_idx_cnt]->get_index()
-				      == buf->index);
-
-				/* If the geometry field is invalid, report
-				error. */
-				if (!row_geo_field_is_valid(row, buf->index)) {
-					err = DB_CANT_CREATE_GEOMETRY_OBJECT;
-					break;
-				}
-
-				sp_tuples[s_idx_cnt]->add(row, ext);
-				s_idx_cnt++;
-
-				continue;
+			/* If the geometry field is invalid, report error. */
+			if (row && dict_index_is_spatial(index[i])
+			    && !row_geo_field_is_valid(row, index[i])) {
+				err = DB_CANT_CREATE_GEOMETRY_OBJECT;
+				break;
 			}
 
 			ut_ad(!row
@@ -2367,11 +2879,14 @@ row_merge_read_clustered_index(
 					      trx->id));
 
 			if (UNIV_LIKELY
-			    (row && (rows_added = row_merge_buf_add(
-					buf, fts_index, old_table, new_table,
-					psort_info, row, ext, &doc_id,
-					conv_heap, &err,
-					&v_heap, eval_table, trx)))) {
+			    (row && (rows_added = dict_index_is_spatial(index[i])
+				     ? row_merge_buf_add_spatial(
+					     buf, index[i], row, ext)
+				     : row_merge_buf_add(
+					     buf, fts_index, old_table,
+					     new_table, psort_info, row, ext,
+					     &doc_id, conv_heap, &err,
+					     &v_heap, eval_table, trx)))) {
 
 				/* If we are creating FTS index,
 				a single row can generate more
@@ -2465,25 +2980,6 @@ row_merge_read_clustered_index(
 					/* Temporary File is not used.
 					so insert sorted block to the index */
 					if (row != NULL) {
-						bool	mtr_committed = false;
-
-						/* We have to do insert the
-						cached spatial index rows, since
-						after the mtr_commit, the cluster
-						index page could be updated, then
-						the data in cached rows become
-						invalid. */
-						err = row_merge_spatial_rows(
-							trx->id, sp_tuples,
-							num_spatial,
-							row_heap, sp_heap,
-							&pcur, &mtr,
-							&mtr_committed);
-
-						if (err != DB_SUCCESS) {
-							goto func_exit;
-						}
-
 						/* We are not at the end of
 						the scan yet. We must
 						mtr_commit() in order to be
@@ -2493,14 +2989,12 @@ row_merge_read_clustered_index(
 						current row will be invalid, and
 						we must reread it on the next
 						loop iteration. */
-						if (!mtr_committed) {
-							btr_pcur_move_to_prev_on_page(
-								&pcur);
-							btr_pcur_store_position(
-								&pcur, &mtr);
+						btr_pcur_move_to_prev_on_page(
+							&pcur);
+						btr_pcur_store_position(
+							&pcur, &mtr);
 
-							mtr_commit(&mtr);
-						}
+						mtr_commit(&mtr);
 					}
 
 					mem_heap_empty(mtuple_heap);
@@ -2523,7 +3017,7 @@ row_merge_read_clustered_index(
 					}
 
 					err = row_merge_insert_index_tuples(
-						index[i], old_table,
+						index[i], buf->index, old_table,
 						-1, NULL, buf, clust_btr_bulk,
 						table_total_rows,
 						curr_progress,
@@ -2537,9 +3031,8 @@ row_merge_read_clustered_index(
 						UT_DELETE(clust_btr_bulk);
 						clust_btr_bulk = NULL;
 					} else {
-						/* Release latches for possible
-						log_free_chck in spatial index
-						build. */
+						/* Release latches while the
+						clustered index scan resumes. */
 						clust_btr_bulk->release();
 					}
 
@@ -2634,7 +3127,8 @@ row_merge_read_clustered_index(
 					btr_bulk.init();
 
 					err = row_merge_insert_index_tuples(
-						index[i], old_table,
+						index[i], buf->index,
+						old_table,
 						-1, NULL, buf, &btr_bulk,
 						table_total_rows,
 						curr_progress,
@@ -2692,11 +3186,15 @@ row_merge_read_clustered_index(
 				and emptied. */
 
 				if (UNIV_UNLIKELY
-				    (!(rows_added = row_merge_buf_add(
-						buf, fts_index, old_table,
-						new_table, psort_info, row, ext,
-						&doc_id, conv_heap,
-						&err, &v_heap, table, trx)))) {
+				    (!(rows_added = dict_index_is_spatial(
+						index[i])
+				       ? row_merge_buf_add_spatial(
+					       buf, index[i], row, ext)
+				       : row_merge_buf_add(
+					       buf, fts_index, old_table,
+					       new_table, psort_info, row, ext,
+					       &doc_id, conv_heap,
+					       &err, &v_heap, table, trx)))) {
 					/* An empty buffer should have enough
 					room for at least one record. */
 					ut_error;
@@ -2735,8 +3233,7 @@ row_merge_read_clustered_index(
 	}
 
 func_exit:
-	/* row_merge_spatial_rows may have committed
-	the mtr	before an error occurs. */
+	/* The mtr may have been committed before an error occurs. */
 	if (mtr.is_active()) {
 		mtr_commit(&mtr);
 	}
@@ -2842,17 +3339,6 @@ row_merge_read_clustered_index(
 
 	btr_pcur_close(&pcur);
 
-	if (sp_tuples != NULL) {
-		for (ulint i = 0; i < num_spatial; i++) {
-			UT_DELETE(sp_tuples[i]);
-		}
-		ut_free(sp_tuples);
-
-		if (sp_heap) {
-			mem_heap_free(sp_heap);
-		}
-	}
-
 	/* Update the next Doc ID we used. Table should be locked, so
 	no concurrent DML */
 	if (max_doc_id && err == DB_SUCCESS) {
@@ -3498,8 +3984,29 @@ row_merge_mtuple_to_dtuple(
 	       dtuple->n_fields * sizeof *mtuple->fields);
 }
 
+/** Convert a record of the spatial sort index to an entry of the
+SPATIAL INDEX, by omitting the Hilbert curve key.
+@param[in]	index		spatial index
+@param[out]	dtuple		spatial index entry
+@param[in]	fields		fields of the spatial sort index record */
+static
+void
+row_merge_spatial_to_dtuple(
+	const dict_index_t*	index,
+	dtuple_t*		dtuple,
+	const dfield_t*		fields)
+{
+	ut_ad(dict_index_is_spatial(index));
+
+	memcpy(dtuple->fields, fields + 1,
+	       dtuple->n_fields * sizeof *fields);
+	dict_index_copy_types(dtuple, index, dtuple->n_fields);
+}
+
 /** Insert sorted data tuples to the index.
 @param[in]	index		index to be inserted
+@param[in]	rec_index	index of the sorted records; the same as
+index, or the spatial sort index when index is a SPATIAL INDEX
 @param[in]	old_table	old table
 @param[in]	fd		file descriptor
 @param[in,out]	block		file buffer
@@ -3514,6 +4021,7 @@ static	MY_ATTRIBUTE((warn_unused_result))
 dberr_t
 row_merge_insert_index_tuples(
 	dict_index_t*		index,
+	const dict_index_t*	rec_index,
 	const dict_table_t*	old_table,
 	int			fd,
 	row_merge_block_t*	block,
@@ -3537,6 +4045,7 @@ row_merge_insert_index_tuples(
 	mrec_buf_t*		buf;
 	ulint			n_rows = 0;
 	dtuple_t*		dtuple;
+	dtuple_t*		sp_dtuple = NULL;
 	ib_uint64_t		inserted_rows = 0;
 	double			curr_progress = 0;
 	dict_index_t*		old_index = NULL;
@@ -3549,7 +4058,7 @@ row_merge_insert_index_tuples(
 
 	ut_ad(!srv_read_only_mode);
 	ut_ad(!(index->type & DICT_FTS));
-	ut_ad(!dict_index_is_spatial(index));
+	ut_ad(!dict_index_is_spatial(index) == (rec_index == index));
 
 	if (stage != NULL) {
 		stage->begin_phase_insert();
@@ -3559,12 +4068,19 @@ row_merge_insert_index_tuples(
 
 	{
 		ulint i	= 1 + REC_OFFS_HEADER_SIZE
-			+ dict_index_get_n_fields(index);
+			+ dict_index_get_n_fields(rec_index);
 		heap = mem_heap_create(sizeof *buf + i * sizeof *offsets);
 		offsets = static_cast<ulint*>(
 			mem_heap_alloc(heap, i * sizeof *offsets));
 		offsets[0] = i;
-		offsets[1] = dict_index_get_n_fields(index);
+		offsets[1] = dict_index_get_n_fields(rec_index);
+	}
+
+	if (rec_index != index) {
+		sp_dtuple = dtuple_create(
+			heap, dict_index_get_n_fields(index));
+		dtuple_set_n_fields_cmp(
+			sp_dtuple, dict_index_get_n_unique_in_tree(index));
 	}
 
 	if (row_buf != NULL) {
@@ -3605,15 +4121,23 @@ row_merge_insert_index_tuples(
 
 			/* Convert merge tuple record from
 			row buffer to data tuple record */
-			row_merge_mtuple_to_dtuple(
-				index, dtuple, &row_buf->tuples[n_rows]);
+			if (sp_dtuple) {
+				row_merge_spatial_to_dtuple(
+					index, sp_dtuple,
+					row_buf->tuples[n_rows].fields);
+				dtuple = sp_dtuple;
+			} else {
+				row_merge_mtuple_to_dtuple(
+					index, dtuple,
+					&row_buf->tuples[n_rows]);
+			}
 
 			n_ext = dtuple_get_n_ext(dtuple);
 			n_rows++;
 			/* BLOB pointers must be copied from dtuple */
 			mrec = NULL;
 		} else {
-			b = row_merge_read_rec(block, buf, b, index,
+			b = row_merge_read_rec(block, buf, b, rec_index,
 					       fd, &foffs, &mrec, offsets,
 					       crypt_block,
 					       space);
@@ -3627,7 +4151,13 @@ row_merge_insert_index_tuples(
 			}
 
 			dtuple = row_rec_to_index_entry_low(
-				mrec, index, offsets, &n_ext, tuple_heap);
+				mrec, rec_index, offsets, &n_ext, tuple_heap);
+
+			if (sp_dtuple) {
+				row_merge_spatial_to_dtuple(
+					index, sp_dtuple, dtuple->fields);
+				dtuple = sp_dtuple;
+			}
 		}
 
 		old_index	= dict_table_get_first_index(old_table);
@@ -3679,8 +4209,18 @@ row_merge_insert_index_tuples(
 		ut_ad(dtuple_validate(dtuple));
 		ut_ad(!sync_check_iterate(sync_allowed_latches(latches,
 							       latches + 2)));
+		DBUG_EXECUTE_IF("row_merge_instrument_log_check_flush",
+			log_sys->check_flush_or_checkpoint = true;
+		);
+
 		error = btr_bulk->insert(dtuple);
 
+		DBUG_EXECUTE_IF("row_merge_ins_spatial_fail",
+			if (sp_dtuple) {
+				error = DB_FAIL;
+			}
+		);
+
 		if (error != DB_SUCCESS) {
 			goto err_exit;
 		}
@@ -4614,6 +5154,7 @@ row_merge_build_indexes(
 	dberr_t			error;
 	int			tmpfd = -1;
 	dict_index_t*		fts_sort_idx = NULL;
+	dict_index_t**		sp_sort_idx = NULL;
 	fts_psort_t*		psort_info = NULL;
 	fts_psort_t*		merge_info = NULL;
 	int64_t			sig_count = 0;
@@ -4663,31 +5204,19 @@ row_merge_build_indexes(
 
 	trx_start_if_not_started_xa(trx, true);
 
-	/* Check if we need a flush observer to flush dirty pages.
+	/* Create a flush observer to flush dirty pages.
 	Since we disable redo logging in bulk load, so we should flush
 	dirty pages before online log apply, because online log apply enables
 	redo logging(we can do further optimization here).
 	1. online add index: flush dirty pages right before row_log_apply().
 	2. table rebuild: flush dirty pages before row_log_table_apply().
 
-	we use bulk load to create all types of indexes except spatial index,
-	for which redo logging is enabled. If we create only spatial indexes,
-	we don't need to flush dirty pages at all. */
-	bool	need_flush_observer = (old_table != new_table);
+	We use bulk load to create all types of indexes, including
+	spatial indexes. */
+	FlushObserver*	flush_observer = UT_NEW_NOKEY(
+		FlushObserver(new_table->space, trx, stage));
 
-	for (i = 0; i < n_indexes; i++) {
-		if (!dict_index_is_spatial(indexes[i])) {
-			need_flush_observer = true;
-		}
-	}
-
-	FlushObserver*	flush_observer = NULL;
-	if (need_flush_observer) {
-		flush_observer = UT_NEW_NOKEY(
-			FlushObserver(new_table->space, trx, stage));
-
-		trx_set_flush_observer(trx, flush_observer);
-	}
+	trx_set_flush_observer(trx, flush_observer);
 
 	merge_files = static_cast<merge_file_t*>(
 		ut_malloc_nokey(n_indexes * sizeof *merge_files));
@@ -4734,6 +5263,18 @@ row_merge_build_indexes(
 			/* We need to ensure that we free the resources
 			allocated */
 			fts_psort_initiated = true;
+		} else if (dict_index_is_spatial(indexes[i])) {
+			/* A SPATIAL INDEX is sorted along a Hilbert
+			curve, by a "spatial sort index" whose first
+			field is the Hilbert curve key */
+			if (!sp_sort_idx) {
+				sp_sort_idx = static_cast<dict_index_t**>(
+					ut_zalloc_nokey(n_indexes
+							* sizeof *sp_sort_idx));
+			}
+
+			sp_sort_idx[i] = row_merge_create_spatial_sort_index(
+				indexes[i]);
 		}
 	}
 
@@ -4762,7 +5303,7 @@ row_merge_build_indexes(
 	secondary index entries for merge sort */
 	error = row_merge_read_clustered_index(
 		trx, table, old_table, new_table, online, indexes,
-		fts_sort_idx, psort_info, merge_files, key_numbers,
+		fts_sort_idx, psort_info, sp_sort_idx, merge_files, key_numbers,
 		n_indexes, add_cols, add_v, col_map, add_autoinc,
 		sequence, block, skip_pk_sort, &tmpfd, stage,
 		pct_cost, crypt_block, eval_table, drop_historical);
@@ -4794,7 +5335,7 @@ row_merge_build_indexes(
 		dict_index_t*	sort_idx = indexes[i];
 
 		if (dict_index_is_spatial(sort_idx)) {
-			continue;
+			sort_idx = sp_sort_idx[i];
 		}
 
 		if (indexes[i]->type & DICT_FTS) {
@@ -4921,7 +5462,7 @@ row_merge_build_indexes(
 				os_thread_sleep(20000000););  /* 20 sec */
 
 			if (error == DB_SUCCESS) {
-				BtrBulk	btr_bulk(sort_idx, trx->id,
+				BtrBulk	btr_bulk(indexes[i], trx->id,
 						 flush_observer);
 				btr_bulk.init();
 
@@ -4942,7 +5483,7 @@ row_merge_build_indexes(
 				}
 
 				error = row_merge_insert_index_tuples(
-					sort_idx, old_table,
+					indexes[i], sort_idx, old_table,
 					merge_files[i].fd, block, NULL,
 					&btr_bulk,
 					merge_files[i].n_rec, pct_progress, pct_cost,
@@ -4976,7 +5517,6 @@ row_merge_build_indexes(
 			ut_ad(sort_idx->online_status
 			      == ONLINE_INDEX_COMPLETE);
 		} else {
-			ut_ad(need_flush_observer);
 			if (global_system_variables.log_warnings > 2) {
 				sql_print_information(
 					"InnoDB: Online DDL : Applying"
@@ -5024,6 +5564,16 @@ row_merge_build_indexes(
 		dict_mem_index_free(fts_sort_idx);
 	}
 
+	if (sp_sort_idx) {
+		for (i = 0; i < n_indexes; i++) {
+			if (sp_sort_idx[i]) {
+				dict_mem_index_free(sp_sort_idx[i]);
+			}
+		}
+
+		ut_free(sp_sort_idx);
+	}
+
 	ut_free(merge_files);
 
 	alloc.deallocate_large(block, &block_pfx, block_size);
@@ -5074,8 +5624,6 @@ row_merge_build_indexes(
 	DBUG_EXECUTE_IF("ib_index_crash_after_bulk_load", DBUG_SUICIDE(););
 
 	if (flush_observer != NULL) {
-		ut_ad(need_flush_observer);
-
 		DBUG_EXECUTE_IF("ib_index_build_fail_before_flush",
 			error = DB_INTERRUPTED;
 		);
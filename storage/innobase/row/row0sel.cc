@@ -3243,6 +3243,81 @@ row_sel_build_prev_vers_for_mysql(
 	return(err);
 }
 
+/** Read ahead the clustered index leaf pages of the secondary index records
+that a range scan is about to visit, starting from the current record and
+not going beyond the current secondary index page. The leaf page numbers
+are looked up in the node pointers of the clustered index, and the pages
+that are not in the buffer pool are read asynchronously in ascending page
+number order.
+@param[in]	sec_index	secondary index
+@param[in]	rec		current user record in sec_index
+@param[in]	moves_up	whether the scan is ascending
+@param[in]	n_recs		maximum number of records to cover
+@return number of secondary index records that were covered, at least 1 */
+static
+ulint
+row_sel_clust_read_ahead(
+	dict_index_t*	sec_index,
+	const rec_t*	rec,
+	bool		moves_up,
+	ulint		n_recs)
+{
+	dict_index_t*	clust_index = dict_table_get_first_index(
+		sec_index->table);
+	const ulint	n_uniq = dict_index_get_n_unique(clust_index);
+	mem_heap_t*	heap = mem_heap_create(
+		n_recs * sizeof(ulint) + 1024);
+	ulint*		page_nos = static_cast<ulint*>(
+		mem_heap_alloc(heap, n_recs * sizeof *page_nos));
+	dtuple_t*	ref = dtuple_create(heap, n_uniq);
+	ulint*		offsets = NULL;
+	ulint		n_pages = 0;
+	ulint		n;
+
+	ut_ad(!dict_index_is_clust(sec_index));
+	ut_ad(page_rec_is_user_rec(rec));
+	ut_ad(n_recs > 0);
+
+	dict_index_copy_types(ref, clust_index, n_uniq);
+
+	for (n = 0; n < n_recs && page_rec_is_user_rec(rec); n++) {
+		mtr_t	mtr;
+
+		offsets = rec_get_offsets(rec, sec_index, offsets, true,
+					  ULINT_UNDEFINED, &heap);
+		row_build_row_ref_in_tuple(ref, rec, sec_index, offsets, NULL);
+
+		mtr.start();
+		const ulint	page_no = btr_cur_get_leaf_page_no(
+			clust_index, ref, &mtr);
+		mtr.commit();
+
+		if (page_no == FIL_NULL) {
+			/* The clustered index consists of the root page
+			only, and every lookup will access that page. */
+			n = n_recs;
+			break;
+		}
+
+		page_nos[n_pages++] = page_no;
+
+		rec = moves_up
+			? page_rec_get_next_const(rec)
+			: page_rec_get_prev_const(rec);
+	}
+
+	std::sort(page_nos, page_nos + n_pages);
+	n_pages = ulint(std::unique(page_nos, page_nos + n_pages) - page_nos);
+
+	buf_read_ahead_pages(clust_index->table->space->id,
+			     dict_table_page_size(clust_index->table),
+			     page_nos, n_pages);
+
+	mem_heap_free(heap);
+
+	return(n);
+}
+
 /*********************************************************************//**
 Retrieves the clustered index record corresponding to a record in a
 non-clustered index. Does the necessary locking. Used in the MySQL
@@ -3814,8 +3889,9 @@ row_sel_enqueue_cache_row_for_mysql(
 /*********************************************************************//**
 Tries to do a shortcut to fetch a clustered index record with a unique key,
 using the hash index if possible (not always). We assume that the search
-mode is PAGE_CUR_GE, it is a consistent read, there is a read view in trx,
-btr search latch has been locked in S-mode if AHI is enabled.
+mode is PAGE_CUR_GE, it is a consistent read, and there is a read view in trx.
+The adaptive hash index is probed without holding its latch, and the record
+will be protected by a page latch in mtr.
 @return SEL_FOUND, SEL_EXHAUSTED, SEL_RETRY */
 static
 ulint
@@ -3836,15 +3912,12 @@ row_sel_try_search_shortcut_for_mysql(
 	ut_ad(dict_index_is_clust(index));
 	ut_ad(!prebuilt->templ_contains_blob);
 
-	rw_lock_t* ahi_latch = btr_get_search_latch(index);
-	rw_lock_s_lock(ahi_latch);
 	btr_pcur_open_with_no_init(index, search_tuple, PAGE_CUR_GE,
-				   BTR_SEARCH_LEAF, pcur, ahi_latch, mtr);
+				   BTR_SEARCH_LEAF, pcur, NULL, mtr);
 	rec = btr_pcur_get_rec(pcur);
 
 	if (!page_rec_is_user_rec(rec) || rec_is_default_row(rec, index)) {
 retry:
-		rw_lock_s_unlock(ahi_latch);
 		return(SEL_RETRY);
 	}
 
@@ -3854,7 +3927,6 @@ row_sel_try_search_shortcut_for_mysql(
 
 	if (btr_pcur_get_up_match(pcur) < dtuple_get_n_fields(search_tuple)) {
 exhausted:
-		rw_lock_s_unlock(ahi_latch);
 		return(SEL_EXHAUSTED);
 	}
 
@@ -3878,7 +3950,6 @@ row_sel_try_search_shortcut_for_mysql(
 
 	*out_rec = rec;
 
-	rw_lock_s_unlock(ahi_latch);
 	return(SEL_FOUND);
 }
 #endif /* BTR_CUR_HASH_ADAPT */
@@ -4256,6 +4327,7 @@ row_search_mvcc(
 		prebuilt->n_rows_fetched = 0;
 		prebuilt->n_fetch_cached = 0;
 		prebuilt->fetch_cache_first = 0;
+		prebuilt->n_clust_read_ahead = 0;
 
 		if (prebuilt->sel_graph == NULL) {
 			/* Build a dummy select query graph */
@@ -4280,6 +4352,7 @@ row_search_mvcc(
 			prebuilt->n_rows_fetched = 0;
 			prebuilt->n_fetch_cached = 0;
 			prebuilt->fetch_cache_first = 0;
+			prebuilt->n_clust_read_ahead = 0;
 
 		} else if (UNIV_LIKELY(prebuilt->n_fetch_cached > 0)) {
 			row_sel_dequeue_cached_row_for_mysql(buf, prebuilt);
@@ -5272,6 +5345,23 @@ row_search_mvcc(
 
 		mtr_has_extra_clust_latch = TRUE;
 
+		/* In a range scan, read ahead the clustered index leaf
+		pages of the following records on this page, so that
+		their lookups will not each wait for a synchronous read. */
+		if (prebuilt->n_clust_read_ahead > 0) {
+			prebuilt->n_clust_read_ahead--;
+		} else if (ulint n_recs = srv_clustered_read_ahead) {
+			if (prebuilt->n_rows_fetched
+			    >= MYSQL_FETCH_CACHE_THRESHOLD
+			    && !dict_index_is_spatial(index)
+			    && !index->table->is_temporary()) {
+				prebuilt->n_clust_read_ahead
+					= row_sel_clust_read_ahead(
+						index, rec, moves_up, n_recs)
+					- 1;
+			}
+		}
+
 		ut_ad(!vrow);
 		/* The following call returns 'offsets' associated with
 		'clust_rec'. Note that 'clust_rec' can be an old version
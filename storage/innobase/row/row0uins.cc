@@ -427,6 +427,12 @@ row_undo_ins_parse_undo_rec(
 	case TRX_UNDO_INSERT_DEFAULT:
 	case TRX_UNDO_INSERT_REC:
 		break;
+	case TRX_UNDO_EMPTY:
+		ut_ad(!node->table->is_temporary());
+		if (UNIV_LIKELY(fil_table_accessible(node->table))) {
+			return;
+		}
+		goto close_table;
 	case TRX_UNDO_RENAME_TABLE:
 		dict_table_t* table = node->table;
 		ut_ad(!table->is_temporary());
@@ -548,6 +554,89 @@ row_undo_ins_remove_sec_rec(
 	return(err);
 }
 
+/** Remove all records from an index tree, on the rollback of a
+TRX_UNDO_EMPTY record. The rows were inserted into an empty table
+without undo log records, while the table was exclusively locked.
+@param[in,out]	index	index tree
+@return DB_SUCCESS or DB_OUT_OF_FILE_SPACE */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_undo_ins_empty_index(dict_index_t* index)
+{
+	dberr_t		err	= DB_SUCCESS;
+	btr_pcur_t	pcur;
+	mtr_t		mtr;
+
+	ut_ad(!index->is_instant());
+	ut_ad(!(index->type & (DICT_FTS | DICT_SPATIAL)));
+
+	do {
+		log_free_check();
+		mtr.start();
+		index->set_modified(mtr);
+
+		btr_pcur_open_at_index_side(
+			true, index, BTR_MODIFY_LEAF, &pcur, true, 0, &mtr);
+		btr_pcur_move_to_next_user_rec(&pcur, &mtr);
+
+		if (!btr_pcur_is_on_user_rec(&pcur)) {
+			btr_pcur_close(&pcur);
+			mtr.commit();
+			break;
+		}
+
+		if (!btr_cur_optimistic_delete(
+			    btr_pcur_get_btr_cur(&pcur), 0, &mtr)) {
+			btr_pcur_store_position(&pcur, &mtr);
+			mtr.commit();
+
+			mtr.start();
+			index->set_modified(mtr);
+
+			/* The record cannot have been removed, because
+			the table is exclusively locked. */
+			ut_a(btr_pcur_restore_position(
+				     BTR_MODIFY_TREE, &pcur, &mtr));
+
+			btr_cur_pessimistic_delete(
+				&err, FALSE, btr_pcur_get_btr_cur(&pcur),
+				0, true, &mtr);
+		}
+
+		btr_pcur_close(&pcur);
+		mtr.commit();
+	} while (err == DB_SUCCESS);
+
+	return(err);
+}
+
+/** Empty a table, on the rollback of a TRX_UNDO_EMPTY record.
+@param[in,out]	table	table that was empty before the transaction
+@return DB_SUCCESS or DB_OUT_OF_FILE_SPACE */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_undo_ins_empty(dict_table_t* table)
+{
+	for (dict_index_t* index = dict_table_get_first_index(table);
+	     index != NULL; index = dict_table_get_next_index(index)) {
+		if (index->type & DICT_FTS) {
+			continue;
+		}
+
+		dberr_t	err = row_undo_ins_empty_index(index);
+
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
+	}
+
+	if (table->stat_initialized) {
+		table->stat_n_rows = 0;
+	}
+
+	return(DB_SUCCESS);
+}
+
 /***********************************************************//**
 Undoes a fresh insert of a row to a table. A fresh insert means that
 the same clustered index unique key did not have any record, even delete
@@ -582,6 +671,9 @@ row_undo_ins(
 	ut_ad(dict_index_is_clust(node->index));
 
 	switch (node->rec_type) {
+	case TRX_UNDO_EMPTY:
+		err = row_undo_ins_empty(node->table);
+		break;
 	default:
 		ut_ad(!"wrong undo record type");
 	case TRX_UNDO_INSERT_REC:
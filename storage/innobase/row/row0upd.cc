@@ -2260,6 +2260,166 @@ row_upd_store_row(
 	}
 }
 
+/** Remove a record of an intrinsic temporary table. Purge would never
+remove a delete-marked record, because the changes are not undo logged.
+@param[in,out]	pcur	persistent cursor on the record
+@param[in,out]	mtr	mini-transaction holding a leaf page latch;
+			will be committed
+@return DB_SUCCESS or DB_OUT_OF_FILE_SPACE */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_upd_remove_rec(btr_pcur_t* pcur, mtr_t* mtr)
+{
+	btr_cur_t*	btr_cur	= btr_pcur_get_btr_cur(pcur);
+	dberr_t		err	= DB_SUCCESS;
+
+	ut_ad(btr_cur_get_index(btr_cur)->table->intrinsic);
+
+	if (!btr_cur_optimistic_delete(btr_cur, 0, mtr)) {
+		/* The page would become too empty, or the record
+		contains off-page columns that must be freed. */
+		btr_pcur_store_position(pcur, mtr);
+		mtr->commit();
+
+		mtr->start();
+		mtr->set_log_mode(MTR_LOG_NO_REDO);
+
+		/* The table is private to this connection. */
+		ut_a(btr_pcur_restore_position(BTR_MODIFY_TREE, pcur, mtr));
+
+		btr_cur_pessimistic_delete(&err, FALSE, btr_cur, 0, false, mtr);
+	}
+
+	mtr->commit();
+
+	return(err);
+}
+
+/** Remove a secondary index record of an intrinsic temporary table.
+@param[in,out]	index	secondary index
+@param[in]	entry	index entry of the record
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_upd_remove_sec_rec(dict_index_t* index, const dtuple_t* entry)
+{
+	btr_pcur_t	pcur;
+	mtr_t		mtr;
+	dberr_t		err	= DB_SUCCESS;
+
+	ut_ad(!dict_index_is_clust(index));
+	ut_ad(!dict_index_is_spatial(index));
+
+	mtr.start();
+	mtr.set_log_mode(MTR_LOG_NO_REDO);
+
+	switch (row_search_index_entry(index, entry, BTR_MODIFY_LEAF,
+				       &pcur, &mtr)) {
+	case ROW_FOUND:
+		err = row_upd_remove_rec(&pcur, &mtr);
+		break;
+	default:
+		ib::error()
+			<< "Record in index " << index->name
+			<< " of table " << index->table->name
+			<< " was not found on update: " << *entry;
+		ut_ad(0);
+		mtr.commit();
+	}
+
+	btr_pcur_close(&pcur);
+
+	return(err);
+}
+
+/** Check for duplicates in the UNIQUE secondary indexes of an intrinsic
+temporary table before the clustered index record is updated. The changes
+cannot be rolled back, so a duplicate must be found before any index
+is modified.
+@param[in]	node	row update node, after row_upd_store_row()
+@param[in,out]	thr	query thread
+@param[in,out]	mtr	mini-transaction holding node->pcur; if a UNIQUE
+			index is checked, it will be committed, and on
+			success restarted with node->pcur restored
+@return DB_SUCCESS, DB_DUPLICATE_KEY, or some other error code;
+on error, mtr will have been committed */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_upd_intrinsic_check_dup(const upd_node_t* node, que_thr_t* thr,
+			    mtr_t* mtr)
+{
+	dberr_t		err	= DB_SUCCESS;
+	mem_heap_t*	heap	= NULL;
+
+	ut_ad(node->table->intrinsic);
+
+	for (dict_index_t* index = dict_table_get_next_index(
+		     dict_table_get_first_index(node->table));
+	     index != NULL;
+	     index = dict_table_get_next_index(index)) {
+		if (!dict_index_is_unique(index)
+		    || dict_index_is_corrupted(index)
+		    || !row_upd_changes_ord_field_binary(
+			    index, node->update, thr,
+			    node->row, node->ext)) {
+			continue;
+		}
+
+		if (heap == NULL) {
+			heap = mem_heap_create(1024);
+		} else {
+			mem_heap_empty(heap);
+		}
+
+		const dtuple_t*	old_entry = row_build_index_entry(
+			node->row, node->ext, index, heap);
+		dtuple_t*	entry = row_build_index_entry(
+			node->upd_row, node->upd_ext, index, heap);
+		const ulint	n_uniq = dict_index_get_n_unique(index);
+		ulint		i;
+
+		/* If only the PRIMARY KEY columns changed, the old
+		record would be reported as a duplicate. */
+		for (i = 0; i < n_uniq; i++) {
+			if (cmp_dfield_dfield(
+				    dtuple_get_nth_field(old_entry, i),
+				    dtuple_get_nth_field(entry, i))) {
+				break;
+			}
+		}
+
+		if (i == n_uniq) {
+			continue;
+		}
+
+		if (mtr->is_active()) {
+			/* Release the clustered index leaf page
+			before latching the secondary index. */
+			mtr->commit();
+		}
+
+		err = row_ins_sec_index_entry(index, entry, thr, true);
+
+		if (err != DB_SUCCESS) {
+			break;
+		}
+	}
+
+	if (heap != NULL) {
+		mem_heap_free(heap);
+	}
+
+	if (err == DB_SUCCESS && !mtr->is_active()) {
+		mtr->start();
+		mtr->set_log_mode(MTR_LOG_NO_REDO);
+		/* The table is private to this connection. */
+		ut_a(btr_pcur_restore_position(BTR_MODIFY_LEAF,
+					       node->pcur, mtr));
+	}
+
+	return(err);
+}
+
 /***********************************************************//**
 Updates a secondary index entry of a row.
 @return DB_SUCCESS if operation successfully completed, else error
@@ -2302,6 +2462,12 @@ row_upd_sec_index_entry(
 
 	log_free_check();
 
+	if (index->table->intrinsic) {
+		/* Remove the old entry instead of delete-marking it. */
+		err = row_upd_remove_sec_rec(index, entry);
+		goto removed;
+	}
+
 	DEBUG_SYNC_C_IF_THD(trx->mysql_thd,
 			    "before_row_upd_sec_index_entry");
 
@@ -2499,7 +2665,7 @@ row_upd_sec_index_entry(
 
 	btr_pcur_close(&pcur);
 	mtr_commit(&mtr);
-
+removed:
 	if (node->is_delete == PLAIN_DELETE || err != DB_SUCCESS) {
 
 		goto func_exit;
@@ -2637,6 +2803,61 @@ row_upd_clust_rec_by_insert_inherit_func(
 	return(inherit);
 }
 
+/** Update the PRIMARY KEY of a row in an intrinsic temporary table.
+Unlike in row_upd_clust_rec_by_insert(), the updated record is inserted
+before the old record is removed, because a duplicate key error cannot
+be rolled back.
+@param[in,out]	node	row update node
+@param[in,out]	index	clustered index
+@param[in,out]	entry	updated clustered index record
+@param[in,out]	thr	query thread
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_upd_clust_rec_by_insert_intrinsic(
+	upd_node_t*	node,
+	dict_index_t*	index,
+	dtuple_t*	entry,
+	que_thr_t*	thr)
+{
+	mtr_t		mtr;
+	btr_pcur_t*	pcur	= node->pcur;
+
+	ut_ad(index->table->intrinsic);
+
+	/* The updated record inherits the off-page columns
+	that were not updated. */
+	const bool	inherit = row_upd_clust_rec_by_insert_inherit(
+		NULL, NULL, entry, node->update);
+
+	dberr_t	err = row_ins_clust_index_entry(
+		index, entry, thr,
+		node->upd_ext ? node->upd_ext->n_ext : 0, false);
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
+	mtr.start();
+	mtr.set_log_mode(MTR_LOG_NO_REDO);
+
+	ut_a(btr_pcur_restore_position(BTR_MODIFY_LEAF, pcur, &mtr));
+
+	if (inherit) {
+		rec_t*		rec	= btr_pcur_get_rec(pcur);
+		mem_heap_t*	heap	= NULL;
+		ulint*		offsets	= rec_get_offsets(
+			rec, index, NULL, true, ULINT_UNDEFINED, &heap);
+
+		btr_cur_disown_inherited_fields(
+			buf_block_get_page_zip(btr_pcur_get_block(pcur)),
+			rec, index, offsets, node->update, &mtr);
+		mem_heap_free(heap);
+	}
+
+	return(row_upd_remove_rec(pcur, &mtr));
+}
+
 /***********************************************************//**
 Marks the clustered index record deleted and inserts the updated version
 of the record to the index. This function should be used when the ordering
@@ -2695,6 +2916,14 @@ row_upd_clust_rec_by_insert(
 			NULL, NULL, entry, node->update);
 		break;
 	case UPD_NODE_UPDATE_CLUSTERED:
+		if (table->intrinsic) {
+			mtr_commit(mtr);
+			err = row_upd_clust_rec_by_insert_intrinsic(
+				node, index, entry, thr);
+			mem_heap_free(heap);
+			return(err);
+		}
+
 		/* This is the first invocation of the function where
 		we update the primary key.  Delete-mark the old record
 		in the clustered index and prepare to insert a new entry. */
@@ -2969,6 +3198,13 @@ row_upd_del_mark_clust_rec(
 			  thr->prebuilt  && thr->prebuilt->table == node->table
 			  ? thr->prebuilt->m_mysql_table : NULL);
 
+	if (index->table->intrinsic) {
+		/* Temporary tables cannot be referenced by
+		FOREIGN KEY constraints. */
+		ut_ad(!referenced);
+		return(row_upd_remove_rec(pcur, mtr));
+	}
+
 	/* Mark the clustered index record deleted; we do not have to check
 	locks, because we assume that we have an x-lock on the record */
 
@@ -3059,7 +3295,7 @@ row_upd_clust_step(
 	if (dict_table_is_temporary(node->table)) {
 		/* Disable locking, because temporary tables are
 		private to the connection (no concurrent access). */
-		flags = node->table->no_rollback()
+		flags = node->table->no_rollback() || node->table->intrinsic
 			? BTR_NO_ROLLBACK
 			: BTR_NO_LOCKING_FLAG;
 		/* Redo logging only matters for persistent tables. */
@@ -3189,6 +3425,18 @@ row_upd_clust_step(
 	row_upd_store_row(node, trx->mysql_thd,
 			  thr->prebuilt ? thr->prebuilt->m_mysql_table : NULL);
 
+	if (node->table->intrinsic) {
+		err = row_upd_intrinsic_check_dup(node, thr, &mtr);
+
+		if (err != DB_SUCCESS) {
+			goto exit_func;
+		}
+
+		rec = btr_pcur_get_rec(pcur);
+		offsets = rec_get_offsets(rec, index, offsets_, true,
+					  ULINT_UNDEFINED, &heap);
+	}
+
 	if (row_upd_changes_ord_field_binary(index, node->update, thr,
 					     node->row, node->ext)) {
 
@@ -3282,6 +3530,15 @@ row_upd(
 		err = row_upd_clust_step(node, thr);
 
 		if (err != DB_SUCCESS) {
+			if (node->table->intrinsic) {
+				/* A DB_DUPLICATE_KEY from
+				row_upd_intrinsic_check_dup() is
+				reported before any index is modified. */
+				row_ins_intrinsic_failed(
+					dict_table_get_first_index(
+						node->table),
+					err, "UPDATE");
+			}
 
 			DBUG_RETURN(err);
 		}
@@ -3311,6 +3568,12 @@ row_upd(
 			err = row_upd_sec_step(node, thr);
 
 			if (err != DB_SUCCESS) {
+				if (node->table->intrinsic) {
+					/* The clustered index was
+					already modified. */
+					row_ins_intrinsic_failed(
+						node->index, err, "UPDATE");
+				}
 
 				DBUG_RETURN(err);
 			}
@@ -33,6 +33,7 @@ Created 12/9/2009 Jimmy Yang
 #include "os0file.h"
 #include "srv0mon.h"
 #include "srv0srv.h"
+#include "trx0purge.h"
 #include "trx0rseg.h"
 #include "trx0sys.h"
 
@@ -874,6 +875,13 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_DISPLAY_CURRENT,
 	 MONITOR_DEFAULT_START, MONITOR_PURGE_RESUME_COUNT},
 
+	{"purge_trx_no_lag", "purge",
+	 "Number of transaction numbers allocated since the commit of"
+	 " the oldest transaction whose undo log has not been purged",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DISPLAY_CURRENT | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_TRX_NO_LAG},
+
 	/* ========== Counters for Recovery Module ========== */
 	{"module_log", "recovery", "Recovery Module",
 	 MONITOR_MODULE,
@@ -1959,6 +1967,19 @@ srv_mon_process_existing_counter(
 		value = srv_mon_get_rseg_size();
 		break;
 
+	case MONITOR_PURGE_TRX_NO_LAG:
+		/* Dirty read of purge_sys.tail, which is only updated by
+		the purge coordinator thread. Until purge has parsed its
+		first undo log, purge_sys.tail.trx_no() is 0. */
+		if (trx_id_t tail = purge_sys.tail.trx_no()) {
+			value = trx_sys.history_size()
+				? trx_sys.get_max_trx_id() - tail
+				: 0;
+		} else {
+			value = 0;
+		}
+		break;
+
 	case MONITOR_OVLD_N_FILE_OPENED:
 		value = fil_n_file_opened;
 		break;
@@ -155,6 +155,10 @@ on duplicate key checking and foreign key checking */
 ibool	srv_locks_unsafe_for_binlog;
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size;
+/** Number of threads that scan the clustered index in index creation */
+ulong	srv_alter_scan_threads;
+/** Number of threads that apply the log of online table rebuild */
+ulong	srv_alter_log_apply_threads;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -163,6 +167,8 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
+/** innodb_use_io_uring */
+my_bool	srv_use_io_uring;
 my_bool	srv_numa_interleave;
 /** copy of innodb_use_atomic_writes; @see innobase_init() */
 my_bool	srv_use_atomic_writes;
@@ -195,6 +201,10 @@ ulong		srv_page_size;
 ulong		srv_page_size_shift;
 /** innodb_log_write_ahead_size */
 ulong		srv_log_write_ahead_size;
+/** innodb_log_writer_threads */
+my_bool		srv_log_writer_threads;
+/** innodb_recovery_threads */
+ulong		srv_n_recovery_threads;
 
 page_size_t	univ_page_size(0, 0, false);
 
@@ -236,6 +246,9 @@ number of locks to protect buf_pool->page_hash */
 ulong	srv_n_page_hash_locks = 16;
 /** innodb_lru_scan_depth; number of blocks scanned in LRU flush batch */
 ulong	srv_LRU_scan_depth;
+/** innodb_lru_manager; whether each buffer pool instance has its own
+thread for keeping the free list populated */
+my_bool	srv_lru_manager;
 /** innodb_flush_neighbors; whether or not to flush neighbors of a block */
 ulong	srv_flush_neighbors;
 /** Previously requested size */
@@ -246,6 +259,8 @@ ulint	srv_buf_pool_base_size;
 ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 ulong	srv_buf_pool_dump_pct;
+/** Number of threads that read pages during BP load */
+ulong	srv_buf_pool_load_threads;
 /** Abort load after this amount of pages */
 #ifdef UNIV_DEBUG
 ulong srv_buf_pool_load_pages_abort = LONG_MAX;
@@ -267,6 +282,10 @@ my_bool	srv_random_read_ahead;
 in the buffer cache and accessed sequentially for InnoDB to trigger a
 readahead request. */
 ulong	srv_read_ahead_threshold;
+/** innodb_clustered_read_ahead; the number of secondary index records
+ahead of a range scan whose clustered index leaf pages are read ahead,
+or 0 to disable */
+ulong	srv_clustered_read_ahead;
 
 /** innodb_change_buffer_max_size; maximum on-disk size of change
 buffer in terms of percentage of the buffer pool. */
@@ -366,6 +385,8 @@ my_bool		srv_stats_include_delete_marked;
 unsigned long long	srv_stats_persistent_sample_pages;
 /** innodb_stats_auto_recalc */
 my_bool		srv_stats_auto_recalc;
+/** innodb_stats_incremental */
+my_bool		srv_stats_incremental;
 
 /** innodb_stats_modified_counter; The number of rows modified before
 we calculate new statistics (default 0 = current limits) */
@@ -383,6 +404,10 @@ number of pages to use in LRU and flush_list batch flushing.
 The rest of the doublewrite buffer is used for single-page flushing. */
 ulong	srv_doublewrite_batch_size = 120;
 
+/** innodb_doublewrite_files: number of files for the doublewrite buffer
+of LRU and flush_list batches, or 0 to use the system tablespace */
+ulong	srv_doublewrite_files;
+
 /** innodb_replication_delay */
 ulong	srv_replication_delay;
 
@@ -1627,6 +1652,10 @@ srv_export_innodb_status(void)
 	export_vars.innodb_onlineddl_rowlog_rows = onlineddl_rowlog_rows;
 	export_vars.innodb_onlineddl_rowlog_pct_used = onlineddl_rowlog_pct_used;
 	export_vars.innodb_onlineddl_pct_progress = onlineddl_pct_progress;
+	export_vars.innodb_onlineddl_rowlog_blocks_parallel
+		= srv_stats.n_rowlog_blocks_parallel;
+	export_vars.innodb_onlineddl_rowlog_background_applies
+		= srv_stats.n_rowlog_background_applies;
 
 	export_vars.innodb_sec_rec_cluster_reads =
 		srv_stats.n_sec_rec_cluster_reads;
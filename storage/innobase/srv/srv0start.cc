@@ -60,6 +60,7 @@ Created 2/16/1996 Heikki Tuuri
 #include "os0thread.h"
 #include "fil0fil.h"
 #include "fil0crypt.h"
+#include "fil0pagecompress.h"
 #include "fsp0fsp.h"
 #include "rem0rec.h"
 #include "mtr0mtr.h"
@@ -217,6 +218,7 @@ mysql_pfs_key_t	io_read_thread_key;
 mysql_pfs_key_t	io_write_thread_key;
 mysql_pfs_key_t	srv_error_monitor_thread_key;
 mysql_pfs_key_t	srv_lock_timeout_thread_key;
+mysql_pfs_key_t	srv_lock_deadlock_thread_key;
 mysql_pfs_key_t	srv_master_thread_key;
 mysql_pfs_key_t	srv_monitor_thread_key;
 mysql_pfs_key_t	srv_purge_thread_key;
@@ -1240,8 +1242,10 @@ srv_shutdown_all_bg_threads()
 		HERE OR EARLIER */
 
 		if (srv_start_state_is_set(SRV_START_STATE_LOCK_SYS)) {
-			/* a. Let the lock timeout thread exit */
+			/* a. Let the lock timeout thread and the
+			deadlock detector thread exit */
 			os_event_set(lock_sys.timeout_event);
+			os_event_set(lock_sys.deadlock_event);
 		}
 
 		if (!srv_read_only_mode) {
@@ -1266,6 +1270,18 @@ srv_shutdown_all_bg_threads()
 			if (log_scrub_thread_active) {
 				os_event_set(log_scrub_event);
 			}
+
+			if (log_writer_thread_active) {
+				os_event_set(log_sys->writer_event);
+			}
+
+			if (log_flusher_thread_active) {
+				os_event_set(log_sys->flusher_event);
+			}
+
+			if (buf_lru_manager_n_active) {
+				buf_lru_manager_wake_all();
+			}
 		}
 
 		if (srv_start_state_is_set(SRV_START_STATE_IO)) {
@@ -1621,6 +1637,7 @@ innobase_start_or_create_for_mysql()
 	srv_max_n_threads = 1   /* io_ibuf_thread */
 			    + 1 /* io_log_thread */
 			    + 1 /* lock_wait_timeout_thread */
+			    + 1 /* lock_deadlock_detect_thread */
 			    + 1 /* srv_error_monitor_thread */
 			    + 1 /* srv_monitor_thread */
 			    + 1 /* srv_master_thread */
@@ -2566,6 +2583,13 @@ innobase_start_or_create_for_mysql()
 		thread_started[2 + SRV_MAX_N_IO_THREADS] = true;
 		lock_sys.timeout_thread_active = true;
 
+		/* Create the thread which resolves deadlocks, if
+		innodb_deadlock_detect_background=ON. Otherwise, it will
+		be created when the parameter is set. */
+		if (innobase_deadlock_detect_background) {
+			lock_deadlock_detect_start();
+		}
+
 		/* Create the thread which warns of long semaphore waits */
 		srv_error_monitor_active = true;
 		thread_handles[3 + SRV_MAX_N_IO_THREADS] = os_thread_create(
@@ -2635,6 +2659,14 @@ innobase_start_or_create_for_mysql()
 			NULL, thread_ids + (1 + SRV_MAX_N_IO_THREADS));
 		thread_started[1 + SRV_MAX_N_IO_THREADS] = true;
 		srv_start_state_set(SRV_START_STATE_MASTER);
+
+		if (srv_log_writer_threads) {
+			log_writer_threads_start();
+		}
+
+		if (srv_lru_manager) {
+			buf_lru_manager_start();
+		}
 	}
 
 	if (!srv_read_only_mode && srv_operation == SRV_OPERATION_NORMAL
@@ -2903,6 +2935,7 @@ innodb_shutdown()
 	row_mysql_close();
 	srv_free();
 	fil_system.close();
+	fil_pagecompress_close();
 
 	/* 4. Free all allocated memory */
 
@@ -456,6 +456,7 @@ LatchDebug::LatchDebug()
 	LEVEL_MAP_INSERT(RW_LOCK_X);
 	LEVEL_MAP_INSERT(RW_LOCK_NOT_LOCKED);
 	LEVEL_MAP_INSERT(SYNC_MONITOR_MUTEX);
+	LEVEL_MAP_INSERT(SYNC_BUF_INDEX_STATS);
 	LEVEL_MAP_INSERT(SYNC_ANY_LATCH);
 	LEVEL_MAP_INSERT(SYNC_DOUBLEWRITE);
 	LEVEL_MAP_INSERT(SYNC_BUF_FLUSH_LIST);
@@ -482,6 +483,8 @@ LatchDebug::LatchDebug()
 	LEVEL_MAP_INSERT(SYNC_TRX);
 	LEVEL_MAP_INSERT(SYNC_RW_TRX_HASH_ELEMENT);
 	LEVEL_MAP_INSERT(SYNC_TRX_SYS);
+	LEVEL_MAP_INSERT(SYNC_LOCK_SYS_SHARD);
+	LEVEL_MAP_INSERT(SYNC_LOCK_SYS_SHARDS);
 	LEVEL_MAP_INSERT(SYNC_LOCK_SYS);
 	LEVEL_MAP_INSERT(SYNC_LOCK_WAIT_SYS);
 	LEVEL_MAP_INSERT(SYNC_INDEX_ONLINE_LOG);
@@ -761,6 +764,8 @@ LatchDebug::check_order(
 	case SYNC_SEARCH_SYS:
 	case SYNC_THREADS:
 	case SYNC_LOCK_SYS:
+	case SYNC_LOCK_SYS_SHARDS:
+	case SYNC_LOCK_SYS_SHARD:
 	case SYNC_LOCK_WAIT_SYS:
 	case SYNC_RW_TRX_HASH_ELEMENT:
 	case SYNC_TRX_SYS:
@@ -781,6 +786,7 @@ LatchDebug::check_order(
 	case SYNC_POOL:
 	case SYNC_POOL_MANAGER:
 	case SYNC_RECV_WRITER:
+	case SYNC_BUF_INDEX_STATS:
 
 		basic_check(latches, level, level);
 		break;
@@ -1304,6 +1310,9 @@ sync_latch_meta_init()
 
 	LATCH_ADD_MUTEX(BUF_POOL_ZIP, SYNC_BUF_BLOCK, buf_pool_zip_mutex_key);
 
+	LATCH_ADD_MUTEX(BUF_INDEX_STATS, SYNC_BUF_INDEX_STATS,
+			buf_index_stats_mutex_key);
+
 	LATCH_ADD_MUTEX(CACHE_LAST_READ, SYNC_TRX_I_S_LAST_READ,
 			cache_last_read_mutex_key);
 
@@ -1414,6 +1423,9 @@ sync_latch_meta_init()
 	LATCH_ADD_MUTEX(LOCK_SYS_WAIT, SYNC_LOCK_WAIT_SYS,
 			lock_wait_mutex_key);
 
+	LATCH_ADD_MUTEX(LOCK_SYS_SHARD, SYNC_LOCK_SYS_SHARD,
+			lock_shard_mutex_key);
+
 	LATCH_ADD_MUTEX(TRX_SYS, SYNC_TRX_SYS, trx_sys_mutex_key);
 
 	LATCH_ADD_MUTEX(SRV_SYS, SYNC_THREADS, srv_sys_mutex_key);
@@ -1500,6 +1512,9 @@ sync_latch_meta_init()
 	LATCH_ADD_RWLOCK(HASH_TABLE_RW_LOCK, SYNC_BUF_PAGE_HASH,
 		  hash_table_locks_key);
 
+	LATCH_ADD_RWLOCK(LOCK_SYS_SHARDS, SYNC_LOCK_SYS_SHARDS,
+			 lock_shards_latch_key);
+
 	LATCH_ADD_MUTEX(SYNC_DEBUG_MUTEX, SYNC_NO_ORDER_CHECK,
 			PFS_NOT_INSTRUMENTED);
 
@@ -178,6 +178,7 @@ void purge_sys_t::create()
   rw_lock_create(trx_purge_latch_key, &latch, SYNC_PURGE_LATCH);
   mutex_create(LATCH_ID_PURGE_SYS_PQ, &pq_mutex);
   undo_trunc.create();
+  heap= mem_heap_create(1024);
   m_initialised = true;
 }
 
@@ -200,6 +201,7 @@ void purge_sys_t::close()
 	ut_ad(latch.magic_n == 0);
 	ut_d(latch.magic_n = RW_LOCK_MAGIC_N);
 	mutex_free(&pq_mutex);
+	mem_heap_free(heap);
 	os_event_destroy(event);
 }
 
@@ -1359,6 +1361,12 @@ trx_purge_fetch_next_rec(
 }
 
 /** Run a purge batch.
+
+The undo log records are distributed to the purge nodes by a hash of the
+table id and the first primary key column, so that all records of a row
+are purged by the same purge thread in this batch, in undo log order.
+Records of different rows of a table may still be purged in parallel.
+
 @param n_purge_threads	number of purge threads
 @return number of undo log pages handled in the batch */
 static
@@ -1369,6 +1377,7 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 	ulint		i = 0;
 	ulint		n_pages_handled = 0;
 	ulint		n_thrs = UT_LIST_GET_LEN(purge_sys.query->thrs);
+	std::vector<purge_node_t*, ut_allocator<purge_node_t*> >	nodes;
 
 	ut_a(n_purge_threads > 0);
 
@@ -1389,16 +1398,21 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 		ut_a(node->done);
 
 		node->done = FALSE;
+
+		nodes.push_back(node);
 	}
 
 	/* There should never be fewer nodes than threads, the inverse
 	however is allowed because we only use purge threads as needed. */
 	ut_a(i == n_purge_threads);
 
+	/* All purge nodes completed the previous batch, so none of them
+	refers to the undo log records that were copied for it. */
+	mem_heap_empty(purge_sys.heap);
+
 	/* Fetch and parse the UNDO records. The UNDO records are added
 	to a per purge node vector. */
-	thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
-	ut_a(n_thrs > 0 && thr != NULL);
+	ut_a(n_thrs > 0);
 
 	ut_ad(purge_sys.head <= purge_sys.tail);
 
@@ -1408,16 +1422,7 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 
 	for (;;) {
 		purge_node_t*		node;
-		trx_purge_rec_t*	purge_rec;
-
-		ut_a(!thr->is_active);
-
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
-		purge_rec = static_cast<trx_purge_rec_t*>(
-			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
+		trx_purge_rec_t		purge_rec;
 
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
@@ -1427,37 +1432,38 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 		}
 
 		/* Fetch the next record, and advance the purge_sys.tail. */
-		purge_rec->undo_rec = trx_purge_fetch_next_rec(
-			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
-
-		if (purge_rec->undo_rec != NULL) {
-
-			if (node->undo_recs == NULL) {
-				node->undo_recs = ib_vector_create(
-					ib_heap_allocator_create(node->heap),
-					sizeof(trx_purge_rec_t),
-					batch_size);
-			} else {
-				ut_a(!ib_vector_is_empty(node->undo_recs));
-			}
+		purge_rec.undo_rec = trx_purge_fetch_next_rec(
+			&purge_rec.roll_ptr, &n_pages_handled,
+			purge_sys.heap);
 
-			ib_vector_push(node->undo_recs, purge_rec);
+		if (purge_rec.undo_rec == NULL) {
+			break;
+		}
 
-			if (n_pages_handled >= batch_size) {
+		if (purge_rec.undo_rec == &trx_purge_dummy_rec) {
+			/* The dummy record only closes an undo log. */
+			node = nodes[i++ % n_purge_threads];
+		} else {
+			node = nodes[trx_undo_rec_get_row_fold(
+					     purge_rec.undo_rec)
+				     % n_purge_threads];
+		}
 
-				break;
-			}
+		if (node->undo_recs == NULL) {
+			node->undo_recs = ib_vector_create(
+				ib_heap_allocator_create(node->heap),
+				sizeof(trx_purge_rec_t),
+				batch_size);
 		} else {
-			break;
+			ut_a(!ib_vector_is_empty(node->undo_recs));
 		}
 
-		thr = UT_LIST_GET_NEXT(thrs, thr);
+		ib_vector_push(node->undo_recs, &purge_rec);
 
-		if (!(++i % n_purge_threads)) {
-			thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
-		}
+		if (n_pages_handled >= batch_size) {
 
-		ut_a(thr != NULL);
+			break;
+		}
 	}
 
 	ut_ad(purge_sys.head <= purge_sys.tail);
@@ -619,6 +619,52 @@ trx_undo_rec_get_col_val(
 	return(const_cast<byte*>(ptr));
 }
 
+/** Compute a hash value of the table id and the first primary key column
+of an undo log record. All undo log records of a clustered index record
+have the same value.
+@param[in]	undo_rec	undo log record
+@return hash value */
+ulint
+trx_undo_rec_get_row_fold(const trx_undo_rec_t* undo_rec)
+{
+	const byte*	ptr = undo_rec + 2;
+	const ulint	type = mach_read_from_1(ptr)
+		& (TRX_UNDO_CMPL_INFO_MULT - 1);
+
+	ptr++;
+
+	/* Skip the undo number. */
+	mach_read_next_much_compressed(&ptr);
+
+	const ulint	fold = ut_fold_ull(mach_read_next_much_compressed(&ptr));
+
+	switch (type) {
+	case TRX_UNDO_UPD_EXIST_REC:
+	case TRX_UNDO_UPD_DEL_REC:
+	case TRX_UNDO_DEL_MARK_REC:
+		/* Skip the info bits, DB_TRX_ID and DB_ROLL_PTR. */
+		ptr++;
+		mach_u64_read_next_compressed(&ptr);
+		mach_u64_read_next_compressed(&ptr);
+		/* fall through */
+	case TRX_UNDO_INSERT_REC:
+		break;
+	default:
+		/* These records do not refer to a user record. */
+		return(fold);
+	}
+
+	const byte*	field;
+	ulint		len;
+	ulint		orig_len;
+
+	trx_undo_rec_get_col_val(ptr, &field, &len, &orig_len);
+
+	return(len == UNIV_SQL_NULL
+	       ? fold
+	       : ut_fold_ulint_pair(fold, ut_fold_binary(field, len)));
+}
+
 /*******************************************************************//**
 Builds a row reference from an undo log record.
 @return pointer to remaining part of undo record */
@@ -1842,17 +1888,18 @@ trx_undo_erase_page_end(page_t* undo_page)
 	return(first_free != TRX_UNDO_PAGE_HDR + TRX_UNDO_PAGE_HDR_SIZE);
 }
 
-/** Report a RENAME TABLE operation.
+/** Report a RENAME TABLE operation or the emptying of a table.
 @param[in,out]	trx	transaction
-@param[in]	table	table that is being renamed
+@param[in]	table	table that is being renamed or emptied
+@param[in]	type	TRX_UNDO_RENAME_TABLE or TRX_UNDO_EMPTY
 @param[in,out]	block	undo page
 @param[in,out]	mtr	mini-transaction
 @return	byte offset of the undo log record
 @retval	0	in case of failure */
 static
 ulint
-trx_undo_page_report_rename(trx_t* trx, const dict_table_t* table,
-			    buf_block_t* block, mtr_t* mtr)
+trx_undo_page_report_table(trx_t* trx, const dict_table_t* table,
+			   byte type, buf_block_t* block, mtr_t* mtr)
 {
 	byte*	ptr_first_free  = TRX_UNDO_PAGE_HDR + TRX_UNDO_PAGE_FREE
 		+ block->frame;
@@ -1860,7 +1907,9 @@ trx_undo_page_report_rename(trx_t* trx, const dict_table_t* table,
 	ut_ad(first_free >= TRX_UNDO_PAGE_HDR + TRX_UNDO_PAGE_HDR_SIZE);
 	ut_ad(first_free <= UNIV_PAGE_SIZE);
 	byte* start = block->frame + first_free;
-	size_t len = strlen(table->name.m_name);
+	/* The table name is only needed for rolling back RENAME TABLE. */
+	size_t len = type == TRX_UNDO_RENAME_TABLE
+		? strlen(table->name.m_name) : 0;
 	const size_t fixed = 2 + 1 + 11 + 11 + 2;
 	ut_ad(len <= NAME_LEN * 2 + 1);
 	/* The -10 is used in trx_undo_left() */
@@ -1875,7 +1924,7 @@ trx_undo_page_report_rename(trx_t* trx, const dict_table_t* table,
 	}
 
 	byte* ptr = start + 2;
-	*ptr++ = TRX_UNDO_RENAME_TABLE;
+	*ptr++ = type;
 	ptr += mach_u64_write_much_compressed(ptr, trx->undo_no);
 	ptr += mach_u64_write_much_compressed(ptr, table->id);
 	memcpy(ptr, table->name.m_name, len);
@@ -1890,13 +1939,16 @@ trx_undo_page_report_rename(trx_t* trx, const dict_table_t* table,
 	return first_free;
 }
 
-/** Report a RENAME TABLE operation.
+/** Report a RENAME TABLE operation or the emptying of a table.
 @param[in,out]	trx	transaction
-@param[in]	table	table that is being renamed
+@param[in]	table	table that is being renamed or emptied
+@param[in]	type	TRX_UNDO_RENAME_TABLE or TRX_UNDO_EMPTY
 @return	DB_SUCCESS or error code */
+static
 dberr_t
-trx_undo_report_rename(trx_t* trx, const dict_table_t* table)
+trx_undo_report_table(trx_t* trx, const dict_table_t* table, byte type)
 {
+	ut_ad(type == TRX_UNDO_RENAME_TABLE || type == TRX_UNDO_EMPTY);
 	ut_ad(!trx->read_only);
 	ut_ad(trx->id);
 	ut_ad(!table->is_temporary());
@@ -1913,8 +1965,8 @@ trx_undo_report_rename(trx_t* trx, const dict_table_t* table)
 			ut_ad(++loop_count < 2);
 			ut_ad(undo->last_page_no == block->page.id.page_no());
 
-			if (ulint offset = trx_undo_page_report_rename(
-				    trx, table, block, &mtr)) {
+			if (ulint offset = trx_undo_page_report_table(
+				    trx, table, type, block, &mtr)) {
 				undo->withdraw_clock = buf_withdraw_clock;
 				undo->empty = FALSE;
 				undo->top_page_no = undo->last_page_no;
@@ -1944,6 +1996,28 @@ trx_undo_report_rename(trx_t* trx, const dict_table_t* table)
 	return err;
 }
 
+/** Report a RENAME TABLE operation.
+@param[in,out]	trx	transaction
+@param[in]	table	table that is being renamed
+@return	DB_SUCCESS or error code */
+dberr_t
+trx_undo_report_rename(trx_t* trx, const dict_table_t* table)
+{
+	return trx_undo_report_table(trx, table, TRX_UNDO_RENAME_TABLE);
+}
+
+/** Report that rows are about to be inserted into an empty table
+without writing undo log records for them. On rollback, the table
+will be emptied.
+@param[in,out]	trx	transaction
+@param[in]	table	empty table
+@return	DB_SUCCESS or error code */
+dberr_t
+trx_undo_report_empty(trx_t* trx, const dict_table_t* table)
+{
+	return trx_undo_report_table(trx, table, TRX_UNDO_EMPTY);
+}
+
 /***********************************************************************//**
 Writes information to an undo log about an insert, update, or a delete marking
 of a clustered index record. This information is used in a rollback of the
@@ -1023,6 +1023,7 @@ trx_roll_pop_top_rec_of_trx(trx_t* trx, roll_ptr_t* roll_ptr, mem_heap_t* heap)
 		ut_ad(undo == update);
 		/* fall through */
 	case TRX_UNDO_RENAME_TABLE:
+	case TRX_UNDO_EMPTY:
 		ut_ad(undo == insert || undo == update);
 		/* fall through */
 	case TRX_UNDO_INSERT_REC:
@@ -139,6 +139,8 @@ trx_init(
 
 	trx->check_unique_secondary = true;
 
+	trx->bulk_insert = false;
+
 	trx->lock.n_rec_locks = 0;
 
 	trx->dict_operation = TRX_DICT_OP_NONE;
@@ -561,6 +563,7 @@ trx_resurrect_table_locks(
 	page_t*			undo_page;
 	trx_undo_rec_t*		undo_rec;
 	table_id_set		tables;
+	table_id_set		emptied_tables;
 
 	ut_ad(trx_state_eq(trx, TRX_STATE_ACTIVE) ||
 	      trx_state_eq(trx, TRX_STATE_PREPARED));
@@ -600,6 +603,12 @@ trx_resurrect_table_locks(
 			&updated_extern, &undo_no, &table_id);
 		tables.insert(table_id);
 
+		if (type == TRX_UNDO_EMPTY) {
+			/* The rollback will empty the table. Other
+			transactions must not modify it in the meantime. */
+			emptied_tables.insert(table_id);
+		}
+
 		undo_rec = trx_undo_get_prev_rec(
 			undo_rec, undo->hdr_page_no,
 			undo->hdr_offset, false, &mtr);
@@ -624,11 +633,16 @@ trx_resurrect_table_locks(
 					trx_mod_tables_t::value_type(table,
 								     0));
 			}
-			lock_table_ix_resurrect(table, trx);
+			const bool	emptied = emptied_tables.find(*i)
+				!= emptied_tables.end();
+
+			lock_table_resurrect(table, trx,
+					     emptied ? LOCK_X : LOCK_IX);
 
 			DBUG_LOG("ib_trx",
 				 "resurrect " << ib::hex(trx->id)
-				 << " IX lock on " << table->name);
+				 << (emptied ? " X" : " IX")
+				 << " lock on " << table->name);
 
 			dict_table_close(table, FALSE, FALSE);
 		}
@@ -1225,8 +1239,10 @@ trx_flush_log_if_needed_low(
 		flush = false;
 		/* fall through */
 	case 1:
-		/* Write the log and optionally flush it to disk */
-		log_write_up_to(lsn, flush);
+		/* Write the log and optionally flush it to disk,
+		or wait for log_writer_thread and log_flusher_thread
+		to do it if innodb_log_writer_threads=ON */
+		log_wait_up_to(lsn, flush);
 		return;
 	case 0:
 		/* Do nothing */
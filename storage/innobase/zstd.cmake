@@ -0,0 +1,34 @@
+# Copyright (C) 2018, MariaDB Corporation. All Rights Reserved.
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; version 2 of the License.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+SET(WITH_INNODB_ZSTD AUTO CACHE STRING
+  "Build with zstd. Possible values are 'ON', 'OFF', 'AUTO' and default is 'AUTO'")
+
+MACRO (MYSQL_CHECK_ZSTD)
+  IF (WITH_INNODB_ZSTD STREQUAL "ON" OR WITH_INNODB_ZSTD STREQUAL "AUTO")
+    CHECK_INCLUDE_FILES(zstd.h HAVE_ZSTD_H)
+    CHECK_INCLUDE_FILES(zdict.h HAVE_ZDICT_H)
+    CHECK_LIBRARY_EXISTS(zstd ZSTD_compress_usingCDict "" HAVE_ZSTD_SHARED_LIB)
+    CHECK_LIBRARY_EXISTS(zstd ZDICT_trainFromBuffer "" HAVE_ZDICT_TRAIN)
+
+    IF(HAVE_ZSTD_SHARED_LIB AND HAVE_ZDICT_TRAIN AND HAVE_ZSTD_H AND HAVE_ZDICT_H)
+      ADD_DEFINITIONS(-DHAVE_ZSTD=1)
+      LINK_LIBRARIES(zstd)
+    ELSE()
+      IF (WITH_INNODB_ZSTD STREQUAL "ON")
+	MESSAGE(FATAL_ERROR "Required zstd library is not found")
+      ENDIF()
+    ENDIF()
+  ENDIF()
+ENDMACRO()